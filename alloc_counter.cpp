@@ -0,0 +1,32 @@
+#include "alloc_counter.h"
+
+namespace alloc_counter {
+
+namespace {
+
+// Constant-initialised and trivially destructible, so the hook can
+// touch them from any thread at any point of its life
+thread_local Counts thread_counts;
+
+std::atomic<bool> hook_installed{false};
+
+}  // namespace
+
+bool installed() noexcept {
+    return hook_installed.load(std::memory_order_relaxed);
+}
+
+Counts thread() noexcept {
+    return thread_counts;
+}
+
+void note(size_t bytes) noexcept {
+    thread_counts.allocations++;
+    thread_counts.bytes += bytes;
+}
+
+void markInstalled() noexcept {
+    hook_installed.store(true, std::memory_order_relaxed);
+}
+
+}  // namespace alloc_counter
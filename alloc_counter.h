@@ -0,0 +1,92 @@
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+// ============================================
+// HEAP ALLOCATION ACCOUNTING
+// ============================================
+
+// Per-thread counts of global operator new calls. Counting is opt-in:
+// the counts only move in executables that link alloc_hook.cpp, which
+// replaces the global allocation functions (all forms of new and
+// delete) with malloc-based ones that call note(). Elsewhere every
+// count stays 0 and installed() is false.
+//
+// Counts are plain thread_locals, so reading them costs no atomics and
+// a thread only ever sees its own allocations. Work a call hands to
+// another thread (the buffer cache flusher, the async I/O pool) is not
+// attributed to the call.
+namespace alloc_counter {
+
+struct Counts {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;          // As requested, not as rounded by malloc
+};
+
+// True once the hook is linked into the executable
+bool installed() noexcept;
+
+// Totals of the calling thread since it started
+Counts thread() noexcept;
+
+// Called by the hook
+void note(size_t bytes) noexcept;
+void markInstalled() noexcept;
+
+}  // namespace alloc_counter
+
+// Allocation totals of one call site, summed over threads
+class AllocationCounter {
+private:
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> bytes{0};
+
+public:
+    AllocationCounter() = default;
+    AllocationCounter(const AllocationCounter&) = delete;
+    AllocationCounter& operator=(const AllocationCounter&) = delete;
+
+    void add(const alloc_counter::Counts& counts) noexcept {
+        if (counts.allocations != 0) {
+            allocations.fetch_add(counts.allocations, std::memory_order_relaxed);
+            bytes.fetch_add(counts.bytes, std::memory_order_relaxed);
+        }
+    }
+
+    alloc_counter::Counts snapshot() const noexcept {
+        alloc_counter::Counts counts;
+        counts.allocations = allocations.load(std::memory_order_relaxed);
+        counts.bytes = bytes.load(std::memory_order_relaxed);
+        return counts;
+    }
+
+    void reset() noexcept {
+        allocations.store(0, std::memory_order_relaxed);
+        bytes.store(0, std::memory_order_relaxed);
+    }
+};
+
+// Adds the allocations the current thread makes during a scope
+class ScopedAllocations {
+private:
+    AllocationCounter& counter;
+    alloc_counter::Counts start;
+
+public:
+    explicit ScopedAllocations(AllocationCounter& c) noexcept
+        : counter(c), start(alloc_counter::thread()) {}
+    ~ScopedAllocations() {
+        alloc_counter::Counts now = alloc_counter::thread();
+        now.allocations -= start.allocations;
+        now.bytes -= start.bytes;
+        counter.add(now);
+    }
+
+    ScopedAllocations(const ScopedAllocations&) = delete;
+    ScopedAllocations& operator=(const ScopedAllocations&) = delete;
+};
+
+#endif // ALLOC_COUNTER_H
@@ -0,0 +1,792 @@
+#include "fat_file_system.h"
+#include "perf_counters.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <sstream>
+#include <map>
+
+using namespace std;
+
+// ============================================
+// FAT FILE SYSTEM BENCHMARK: STANDARD WORKLOADS
+// ============================================
+//
+// Reproducible workloads against a RAM-backed volume. Every workload
+// runs on a freshly formatted volume, draws its choices from a seeded
+// generator, and scales its operation counts with the cluster count, so
+// a (volume, cluster size, seed) triple always issues the same calls.
+//
+//   small_files   create then delete many one-cluster files
+//   churn         random create/delete of 1-8 cluster files (fragments
+//                 the free space)
+//   deep_tree     nested directories with files at every level, then
+//                 lookups of the deepest paths
+//   sequential    one large file written and read back in 64 KB requests
+//   mixed_lookup  lookup-heavy trace over a populated volume (exists,
+//                 isDirectory, open/read/close, FS info, listing)
+//
+// Each operation is timed on its own; "seconds" is the time spent inside
+// timed operations, latencies are nearest-rank percentiles. Results are
+// printed as one JSON document. Each workload also lists, per public
+// FATFileSystem call (internal nested calls included), the heap
+// allocations and bytes per call; fat_bench links the allocation hook,
+// so these are exact for the calling thread.
+//
+// Usage: fat_bench [--volume-kb N] [--cluster-size N] [--workload NAME|all]
+//                  [--seed N] [--output PATH] [--trace PATH] [--perf]
+//                  [--counts] [--baseline PATH] [--write-baseline PATH] [--tolerance PCT]
+//
+// --trace writes a Chrome trace of every operation and its phases
+// (needs a build configured with -DFAT_FS_ENABLE_TRACE=ON).
+//
+// --perf reads hardware counters (cycles, instructions, L1D/LLC/dTLB
+// misses, branch misses) around the timed operations only and reports
+// them per operation. Where perf_event_open is unavailable the report
+// says why and the run carries on without them; events whose counter
+// group never got onto the PMU are listed under perf_not_scheduled.
+//
+// --counts adds machine-independent work per operation (FAT entries,
+// directory nodes, device blocks read/written, allocations) and turns
+// off background write-back so those counts are exactly reproducible.
+// --write-baseline PATH saves them; --baseline PATH compares the run
+// against a saved baseline and exits with status 2 if any operation now
+// does more work per call than the baseline allows (--tolerance PCT of
+// headroom, default 0) or an operation marked allocation-free allocated.
+// The FatPerfGate test runs this against perf_baseline.txt.
+
+namespace {
+
+struct Options {
+    size_t volume_kb = 8 * 1024;
+    size_t cluster_size = 1024;
+    string workload = "all";
+    uint32_t seed = 42;
+    string output;
+    string trace;
+    bool perf = false;
+    PerfCounters* counters = nullptr;     // Set when --perf found usable counters
+    bool counts = false;
+    string baseline;
+    string write_baseline;
+    double tolerance_pct = 0.0;
+};
+
+struct WorkloadResult {
+    string name;
+    vector<uint64_t> latencies_ns;
+    size_t failures = 0;
+    size_t bytes = 0;
+    vector<FATFileSystem::OperationStats> operations;
+    PerfReading perf;
+};
+
+// Times single file system calls into a WorkloadResult (counting them
+// with the hardware counters, if any), and keeps the volume's
+// per-operation statistics when the workload ends
+class Recorder {
+private:
+    WorkloadResult& result;
+    FATFileSystem& fs;
+    PerfCounters* counters;
+
+public:
+    Recorder(WorkloadResult& r, FATFileSystem& volume, const Options& options)
+        : result(r), fs(volume), counters(options.counters) {
+        if (options.counts) {
+            // Write back only on syncs and evictions, never on a timer
+            WriteBackPolicy policy;
+            policy.background_flush = false;
+            fs.setWriteBackPolicy(policy);
+        }
+        if (counters) {
+            counters->start();
+            counters->pause();
+        }
+    }
+    ~Recorder() {
+        result.operations = fs.getStats();
+        if (counters) {
+            result.perf = counters->read();
+        }
+    }
+
+    // op returns false (or 0 bytes) on failure
+    template <typename Op>
+    void time(Op&& op) {
+        if (counters) {
+            counters->resume();
+        }
+        auto start = chrono::steady_clock::now();
+        bool ok = op();
+        auto elapsed = chrono::steady_clock::now() - start;
+        if (counters) {
+            counters->pause();
+        }
+        result.latencies_ns.push_back(
+            static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(elapsed).count()));
+        if (!ok) {
+            result.failures++;
+        }
+    }
+};
+
+size_t clusterCount(const Options& options) {
+    return options.volume_kb * 1024 / options.cluster_size;
+}
+
+// ---------- Workloads ----------
+
+void runSmallFiles(const Options& options, WorkloadResult& result) {
+    FATFileSystem fs(options.volume_kb, options.cluster_size, "BENCH");
+    Recorder recorder(result, fs, options);
+    mt19937 rng(options.seed);
+
+    size_t count = min<size_t>(2000, clusterCount(options) / 2);
+    size_t file_size = options.cluster_size / 2;
+
+    vector<string> names;
+    for (size_t i = 0; i < count; i++) {
+        names.push_back("small" + to_string(i) + ".dat");
+    }
+    for (const string& name : names) {
+        recorder.time([&] { return fs.createFile(name, file_size); });
+    }
+
+    shuffle(names.begin(), names.end(), rng);
+    for (const string& name : names) {
+        recorder.time([&] { return fs.deleteFile(name); });
+    }
+}
+
+void runChurn(const Options& options, WorkloadResult& result) {
+    FATFileSystem fs(options.volume_kb, options.cluster_size, "BENCH");
+    Recorder recorder(result, fs, options);
+    mt19937 rng(options.seed);
+
+    // Keep the volume roughly half full of 1-8 cluster files
+    size_t clusters = clusterCount(options);
+    size_t target_live = max<size_t>(8, min<size_t>(1000, clusters / 9));
+    size_t steps = min<size_t>(20000, clusters * 4);
+    uniform_int_distribution<size_t> file_size(1, 8 * options.cluster_size);
+
+    vector<string> live;
+    size_t next_id = 0;
+    for (size_t step = 0; step < steps; step++) {
+        bool create = live.size() < target_live / 2 ||
+                      (live.size() < target_live && (rng() & 1));
+        if (create) {
+            string name = "churn" + to_string(next_id++) + ".dat";
+            size_t size = file_size(rng);
+            bool created = false;
+            recorder.time([&] { return created = fs.createFile(name, size); });
+            if (created) {
+                live.push_back(name);
+            }
+        } else {
+            size_t victim = rng() % live.size();
+            swap(live[victim], live.back());
+            string name = live.back();
+            live.pop_back();
+            recorder.time([&] { return fs.deleteFile(name); });
+        }
+    }
+}
+
+void runDeepTree(const Options& options, WorkloadResult& result) {
+    FATFileSystem fs(options.volume_kb, options.cluster_size, "BENCH");
+    Recorder recorder(result, fs, options);
+    mt19937 rng(options.seed);
+
+    const size_t files_per_level = 8;
+    size_t depth = min<size_t>(64, clusterCount(options) / (2 * (files_per_level + 1)));
+
+    // Names stay unique per level so basename lookups cannot alias
+    vector<string> files;
+    string path;
+    for (size_t level = 0; level < depth; level++) {
+        path += "/d" + to_string(level);
+        recorder.time([&] { return fs.createDirectory(path); });
+        for (size_t k = 0; k < files_per_level; k++) {
+            string file = path + "/f" + to_string(level) + "_" + to_string(k) + ".dat";
+            recorder.time([&] { return fs.createFile(file, 64); });
+            files.push_back(file);
+        }
+    }
+
+    // Lookups skew towards the deepest levels
+    size_t lookups = files.size() * 8;
+    for (size_t i = 0; i < lookups && !files.empty(); i++) {
+        size_t a = rng() % files.size();
+        size_t b = rng() % files.size();
+        const string& file = files[max(a, b)];
+        recorder.time([&] { return fs.fileExists(file); });
+    }
+}
+
+void runSequential(const Options& options, WorkloadResult& result) {
+    FATFileSystem fs(options.volume_kb, options.cluster_size, "BENCH");
+    Recorder recorder(result, fs, options);
+
+    const size_t request = 64 * 1024;
+    size_t total = options.volume_kb * 1024 / 2 / request * request;
+    vector<char> buffer(request);
+    for (size_t i = 0; i < buffer.size(); i++) {
+        buffer[i] = static_cast<char>(i * 31 + 7);
+    }
+
+    int handle = fs.openFile("large.dat", "w");
+    if (handle < 0) {
+        result.failures++;
+        return;
+    }
+    for (size_t done = 0; done < total; done += request) {
+        size_t written = 0;
+        recorder.time([&] { return (written = fs.writeFile(handle, buffer.data(), request)) == request; });
+        result.bytes += written;
+    }
+    recorder.time([&] { return fs.syncFile(handle); });
+
+    fs.seekFile(handle, 0);
+    for (size_t done = 0; done < total; done += request) {
+        size_t read = 0;
+        recorder.time([&] { return (read = fs.readFile(handle, buffer.data(), request)) == request; });
+        result.bytes += read;
+    }
+    fs.closeFile(handle);
+}
+
+void runMixedLookup(const Options& options, WorkloadResult& result) {
+    FATFileSystem fs(options.volume_kb, options.cluster_size, "BENCH");
+    Recorder recorder(result, fs, options);
+    mt19937 rng(options.seed);
+
+    size_t count = min<size_t>(500, clusterCount(options) / 4);
+    vector<string> names;
+    for (size_t i = 0; i < count; i++) {
+        names.push_back("lookup" + to_string(i) + ".dat");
+        fs.createFile(names.back(), options.cluster_size);
+    }
+    fs.createDirectory("/data");
+
+    const size_t operations = 20000;
+    char buffer[256];
+    for (size_t i = 0; i < operations && !names.empty(); i++) {
+        const string& name = names[rng() % names.size()];
+        unsigned roll = rng() % 100;
+
+        if (roll < 60) {
+            recorder.time([&] { return fs.fileExists(name); });
+        } else if (roll < 75) {
+            string missing = "missing" + to_string(i) + ".dat";
+            recorder.time([&] { return !fs.fileExists(missing); });
+        } else if (roll < 85) {
+            recorder.time([&] { return fs.isDirectory("/data"); });
+        } else if (roll < 95) {
+            recorder.time([&] {
+                int handle = fs.openFile(name, "r");
+                if (handle < 0) {
+                    return false;
+                }
+                size_t n = fs.readFile(handle, buffer, sizeof(buffer));
+                fs.closeFile(handle);
+                return n == sizeof(buffer);
+            });
+        } else if (roll < 99) {
+            recorder.time([&] { return fs.getFileSystemInfo().total_files == count; });
+        } else {
+            recorder.time([&] { return fs.listDirectory("/").size() > count; });
+        }
+    }
+}
+
+struct Workload {
+    const char* name;
+    void (*run)(const Options&, WorkloadResult&);
+};
+
+const Workload kWorkloads[] = {
+    {"small_files", runSmallFiles},
+    {"churn", runChurn},
+    {"deep_tree", runDeepTree},
+    {"sequential", runSequential},
+    {"mixed_lookup", runMixedLookup},
+};
+
+// ---------- Reporting ----------
+
+// Nearest-rank percentile of a sorted sample
+uint64_t percentile(const vector<uint64_t>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t rank = static_cast<size_t>(p * sorted.size() + 0.999999);
+    rank = max<size_t>(1, min(rank, sorted.size()));
+    return sorted[rank - 1];
+}
+
+// Per-call heap use of every operation the workload reached
+void writeAllocations(ostream& out, const vector<FATFileSystem::OperationStats>& operations) {
+    if (!alloc_counter::installed() || !FAT_FS_STATS) {
+        return;
+    }
+    out << ",\n      \"allocations\": {";
+    bool first = true;
+    for (const FATFileSystem::OperationStats& op : operations) {
+        uint64_t calls = op.latency.count;
+        if (calls == 0) {
+            continue;
+        }
+        out << (first ? "\n" : ",\n");
+        first = false;
+        out << setprecision(2);
+        out << "        \"" << op.name << "\": {\"calls\": " << calls
+            << ", \"allocs_per_call\": " << static_cast<double>(op.allocations.allocations) / calls
+            << ", \"bytes_per_call\": " << static_cast<double>(op.allocations.bytes) / calls << "}";
+    }
+    out << "\n      }";
+}
+
+// ---------- Work counts and baselines ----------
+
+// Machine-independent per-operation totals, in baseline column order
+struct WorkMetric {
+    const char* name;
+    uint64_t (*total)(const FATFileSystem::OperationStats&);
+};
+
+const WorkMetric kWorkMetrics[] = {
+    {"fat_entries", [](const FATFileSystem::OperationStats& op) { return op.work.fat_entries; }},
+    {"list_nodes", [](const FATFileSystem::OperationStats& op) { return op.work.list_nodes; }},
+    {"device_reads", [](const FATFileSystem::OperationStats& op) { return op.work.device_reads; }},
+    {"device_writes", [](const FATFileSystem::OperationStats& op) { return op.work.device_writes; }},
+    {"allocations", [](const FATFileSystem::OperationStats& op) { return op.allocations.allocations; }},
+};
+
+void writeWork(ostream& out, const vector<FATFileSystem::OperationStats>& operations) {
+    out << ",\n      \"work\": {";
+    bool first = true;
+    for (const FATFileSystem::OperationStats& op : operations) {
+        if (op.latency.count == 0) {
+            continue;
+        }
+        out << (first ? "\n" : ",\n");
+        first = false;
+        out << "        \"" << op.name << "\": {\"calls\": " << op.latency.count;
+        for (const WorkMetric& metric : kWorkMetrics) {
+            out << ", \"" << metric.name << "\": " << metric.total(op);
+        }
+        out << "}";
+    }
+    out << "\n      }";
+}
+
+// One operation of one workload: call count and a total per column
+struct BaselineRow {
+    string workload;
+    string operation;
+    uint64_t calls = 0;
+    vector<uint64_t> totals;
+};
+
+struct Baseline {
+    size_t volume_kb = 0;
+    size_t cluster_size = 0;
+    uint32_t seed = 0;
+    vector<const WorkMetric*> columns;
+    vector<BaselineRow> rows;
+};
+
+// Text format, one line per record ('#' starts a comment):
+//   volume <volume_kb> <cluster_size> <seed>
+//   columns <metric>...
+//   <workload> <operation> <calls> <total per column>...
+bool writeBaseline(const string& path, const Options& options,
+                   const vector<WorkloadResult>& results) {
+    ofstream out(path);
+    if (!out) {
+        return false;
+    }
+    out << "# Work per operation of fat_bench's workloads, checked by the FatPerfGate test.\n"
+        << "# Regenerate after an intended change with:\n"
+        << "#   fat_bench --volume-kb " << options.volume_kb << " --cluster-size "
+        << options.cluster_size << " --seed " << options.seed << " --write-baseline <this file>\n";
+    out << "volume " << options.volume_kb << " " << options.cluster_size << " " << options.seed << "\n";
+    out << "columns";
+    for (const WorkMetric& metric : kWorkMetrics) {
+        out << " " << metric.name;
+    }
+    out << "\n";
+    for (const WorkloadResult& result : results) {
+        for (const FATFileSystem::OperationStats& op : result.operations) {
+            if (op.latency.count == 0) {
+                continue;
+            }
+            out << result.name << " " << op.name << " " << op.latency.count;
+            for (const WorkMetric& metric : kWorkMetrics) {
+                out << " " << metric.total(op);
+            }
+            out << "\n";
+        }
+    }
+    return static_cast<bool>(out);
+}
+
+bool loadBaseline(const string& path, Baseline& baseline) {
+    ifstream in(path);
+    if (!in) {
+        return false;
+    }
+    string line;
+    while (getline(in, line)) {
+        istringstream fields(line);
+        string first;
+        if (!(fields >> first) || first[0] == '#') {
+            continue;
+        }
+        if (first == "volume") {
+            if (!(fields >> baseline.volume_kb >> baseline.cluster_size >> baseline.seed)) {
+                return false;
+            }
+        } else if (first == "columns") {
+            string name;
+            while (fields >> name) {
+                auto metric = find_if(begin(kWorkMetrics), end(kWorkMetrics),
+                                      [&name](const WorkMetric& m) { return name == m.name; });
+                if (metric == end(kWorkMetrics)) {
+                    return false;
+                }
+                baseline.columns.push_back(metric);
+            }
+        } else {
+            BaselineRow row;
+            row.workload = first;
+            if (!(fields >> row.operation >> row.calls) || row.calls == 0) {
+                return false;
+            }
+            row.totals.resize(baseline.columns.size());
+            for (uint64_t& total : row.totals) {
+                if (!(fields >> total)) {
+                    return false;
+                }
+            }
+            baseline.rows.push_back(row);
+        }
+    }
+    return baseline.volume_kb != 0 && !baseline.columns.empty();
+}
+
+// Compares per-call work with the baseline rows of the workloads that
+// ran, and checks that allocation-free operations did not allocate;
+// returns the number of regressions (each is reported on stderr)
+size_t checkBaseline(const Baseline& baseline, const Options& options,
+                     const vector<WorkloadResult>& results) {
+    size_t checks = 0;
+    size_t regressions = 0;
+    for (const BaselineRow& row : baseline.rows) {
+        auto result = find_if(results.begin(), results.end(),
+                              [&row](const WorkloadResult& r) { return r.name == row.workload; });
+        if (result == results.end()) {
+            continue;                    // Workload not selected in this run
+        }
+        auto op = find_if(result->operations.begin(), result->operations.end(),
+                          [&row](const FATFileSystem::OperationStats& o) { return row.operation == o.name; });
+        uint64_t calls = op == result->operations.end() ? 0 : op->latency.count;
+        if (calls == 0) {
+            cerr << "perf gate: " << row.workload << "/" << row.operation
+                 << " is no longer reached" << endl;
+            regressions++;
+            continue;
+        }
+
+        for (size_t c = 0; c < baseline.columns.size(); c++) {
+            const WorkMetric& metric = *baseline.columns[c];
+            double expected = static_cast<double>(row.totals[c]) / row.calls;
+            double measured = static_cast<double>(metric.total(*op)) / calls;
+            double allowed = expected * (1.0 + options.tolerance_pct / 100.0);
+            checks++;
+            if (measured > allowed + 1e-9) {
+                cerr << fixed << setprecision(2) << "perf gate: REGRESSION " << row.workload << "/"
+                     << row.operation << " " << metric.name << ": " << measured
+                     << " per call, baseline " << expected << " (allowed " << allowed << ")" << endl;
+                regressions++;
+            } else if (measured < expected - 1e-9) {
+                cerr << fixed << setprecision(2) << "perf gate: improved " << row.workload << "/"
+                     << row.operation << " " << metric.name << ": " << measured
+                     << " per call, baseline " << expected << " (consider updating the baseline)"
+                     << endl;
+            }
+        }
+    }
+
+    // Operations documented as allocation-free must stay at zero whatever
+    // the baseline recorded (fsOperationAllocationFree)
+    for (const WorkloadResult& result : results) {
+        for (const FATFileSystem::OperationStats& op : result.operations) {
+            if (!fsOperationAllocationFree(op.operation) || op.latency.count == 0) {
+                continue;
+            }
+            checks++;
+            if (op.allocations.allocations != 0) {
+                cerr << "perf gate: REGRESSION " << result.name << "/" << op.name << " is marked "
+                     << "allocation-free but allocated " << op.allocations.allocations << " times in "
+                     << op.latency.count << " calls" << endl;
+                regressions++;
+            }
+        }
+    }
+    cerr << "perf gate: " << checks << " checks, " << regressions << " regressions" << endl;
+    return regressions;
+}
+
+// Hardware events per timed operation, and the events whose counter
+// group the PMU never scheduled
+void writePerf(ostream& out, const PerfReading& perf, size_t operations) {
+    if (operations == 0) {
+        return;
+    }
+    if (perf.any()) {
+        out << ",\n      \"perf_per_op\": {";
+        bool first = true;
+        out << setprecision(1);
+        for (size_t i = 0; i < kPerfEventCount; i++) {
+            PerfEvent event = static_cast<PerfEvent>(i);
+            if (!perf.has(event)) {
+                continue;
+            }
+            out << (first ? "" : ", ") << "\"" << perfEventName(event) << "\": "
+                << static_cast<double>(perf.value(event)) / operations;
+            first = false;
+        }
+        out << "}";
+    }
+
+    string never_ran;
+    for (size_t i = 0; i < kPerfEventCount; i++) {
+        PerfEvent event = static_cast<PerfEvent>(i);
+        if (perf.neverRan(event)) {
+            never_ran += (never_ran.empty() ? "\"" : ", \"") + string(perfEventName(event)) + "\"";
+        }
+    }
+    if (!never_ran.empty()) {
+        out << ",\n      \"perf_not_scheduled\": [" << never_ran << "]";
+    }
+}
+
+void writeJson(ostream& out, const Options& options, vector<WorkloadResult>& results,
+               const PerfCounters* counters) {
+    out << "{\n";
+    out << "  \"benchmark\": \"fat_bench\",\n";
+    out << "  \"volume_kb\": " << options.volume_kb << ",\n";
+    out << "  \"cluster_size\": " << options.cluster_size << ",\n";
+    out << "  \"seed\": " << options.seed << ",\n";
+    if (options.perf && !options.counters && counters) {
+        out << "  \"perf_unavailable\": \"" << counters->unavailableReason() << "\",\n";
+    }
+    out << "  \"workloads\": [";
+
+    for (size_t i = 0; i < results.size(); i++) {
+        WorkloadResult& r = results[i];
+        vector<uint64_t>& samples = r.latencies_ns;
+        sort(samples.begin(), samples.end());
+
+        uint64_t total_ns = 0;
+        for (uint64_t ns : samples) {
+            total_ns += ns;
+        }
+        double seconds = total_ns / 1e9;
+        double ops_per_sec = seconds > 0 ? samples.size() / seconds : 0.0;
+
+        out << (i ? "," : "") << "\n    {\n";
+        out << "      \"name\": \"" << r.name << "\",\n";
+        out << "      \"operations\": " << samples.size() << ",\n";
+        out << "      \"failures\": " << r.failures << ",\n";
+        out << fixed << setprecision(6);
+        out << "      \"seconds\": " << seconds << ",\n";
+        out << setprecision(1);
+        out << "      \"ops_per_sec\": " << ops_per_sec << ",\n";
+        if (r.bytes > 0) {
+            out << "      \"bytes\": " << r.bytes << ",\n";
+            out << "      \"mb_per_sec\": " << (seconds > 0 ? r.bytes / seconds / (1024 * 1024) : 0.0)
+                << ",\n";
+        }
+        out << "      \"latency_ns\": {"
+            << "\"p50\": " << percentile(samples, 0.50) << ", "
+            << "\"p99\": " << percentile(samples, 0.99) << ", "
+            << "\"p99.9\": " << percentile(samples, 0.999) << ", "
+            << "\"max\": " << (samples.empty() ? 0 : samples.back()) << "}";
+        writePerf(out, r.perf, samples.size());
+        writeAllocations(out, r.operations);
+        if (options.counts) {
+            writeWork(out, r.operations);
+        }
+        out << "\n    }";
+    }
+    out << "\n  ]\n}\n";
+}
+
+void printUsage() {
+    cerr << "Usage: fat_bench [--volume-kb N] [--cluster-size N] [--workload NAME|all]\n"
+         << "                 [--seed N] [--output PATH] [--trace PATH] [--perf]\n"
+         << "                 [--counts] [--baseline PATH] [--write-baseline PATH] [--tolerance PCT]\n"
+         << "Workloads:";
+    for (const Workload& w : kWorkloads) {
+        cerr << " " << w.name;
+    }
+    cerr << endl;
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--perf") {
+            options.perf = true;
+            continue;
+        }
+        if (arg == "--counts") {
+            options.counts = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return false;
+        }
+        string value = argv[++i];
+        if (arg == "--volume-kb") {
+            options.volume_kb = strtoul(value.c_str(), nullptr, 10);
+        } else if (arg == "--cluster-size") {
+            options.cluster_size = strtoul(value.c_str(), nullptr, 10);
+        } else if (arg == "--workload") {
+            options.workload = value;
+        } else if (arg == "--seed") {
+            options.seed = static_cast<uint32_t>(strtoul(value.c_str(), nullptr, 10));
+        } else if (arg == "--output") {
+            options.output = value;
+        } else if (arg == "--trace") {
+            options.trace = value;
+        } else if (arg == "--baseline") {
+            options.baseline = value;
+            options.counts = true;
+        } else if (arg == "--write-baseline") {
+            options.write_baseline = value;
+            options.counts = true;
+        } else if (arg == "--tolerance") {
+            options.tolerance_pct = strtod(value.c_str(), nullptr);
+        } else {
+            return false;
+        }
+    }
+
+    // Power-of-two clusters, and room for a useful number of them
+    bool power_of_two = options.cluster_size >= 512 &&
+                        (options.cluster_size & (options.cluster_size - 1)) == 0;
+    return power_of_two && clusterCount(options) >= 64;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+    if (!FATFileSystem::validGeometry(options.volume_kb, options.cluster_size)) {
+        cerr << "Unsupported volume geometry: --volume-kb " << options.volume_kb
+             << " --cluster-size " << options.cluster_size << endl;
+        return 1;
+    }
+
+    vector<const Workload*> selected;
+    for (const Workload& w : kWorkloads) {
+        if (options.workload == "all" || options.workload == w.name) {
+            selected.push_back(&w);
+        }
+    }
+    if (selected.empty()) {
+        cerr << "Unknown workload: " << options.workload << endl;
+        printUsage();
+        return 1;
+    }
+
+    if (!options.trace.empty()) {
+        if (!FAT_FS_TRACE) {
+            cerr << "Warning: built without FAT_FS_ENABLE_TRACE; the trace will be empty" << endl;
+        }
+        fs_trace::start();
+    }
+
+    Baseline baseline;
+    if (options.counts && !FAT_FS_STATS) {
+        cerr << "--counts needs per-operation statistics (FAT_FS_ENABLE_STATS=ON)" << endl;
+        return 1;
+    }
+    if (!options.baseline.empty()) {
+        if (!loadBaseline(options.baseline, baseline)) {
+            cerr << "Cannot read baseline: " << options.baseline << endl;
+            return 1;
+        }
+        if (baseline.volume_kb != options.volume_kb || baseline.cluster_size != options.cluster_size ||
+            baseline.seed != options.seed) {
+            cerr << "Baseline was recorded with --volume-kb " << baseline.volume_kb
+                 << " --cluster-size " << baseline.cluster_size << " --seed " << baseline.seed << endl;
+            return 1;
+        }
+    }
+
+    unique_ptr<PerfCounters> counters;
+    if (options.perf) {
+        counters = make_unique<PerfCounters>();
+        if (counters->available()) {
+            options.counters = counters.get();
+        } else {
+            cerr << "Warning: no hardware counters: " << counters->unavailableReason() << endl;
+        }
+    }
+
+    vector<WorkloadResult> results;
+    for (const Workload* w : selected) {
+        results.emplace_back();
+        results.back().name = w->name;
+        fs_trace::Span span(w->name, "workload");
+        w->run(options, results.back());
+    }
+
+    if (!options.trace.empty()) {
+        fs_trace::stop();
+        if (!fs_trace::saveChromeTrace(options.trace)) {
+            cerr << "Cannot write trace file: " << options.trace << endl;
+            return 1;
+        }
+    }
+
+    if (options.output.empty()) {
+        writeJson(cout, options, results, counters.get());
+    } else {
+        ofstream file(options.output);
+        if (!file) {
+            cerr << "Cannot open output file: " << options.output << endl;
+            return 1;
+        }
+        writeJson(file, options, results, counters.get());
+    }
+
+    if (!options.write_baseline.empty()) {
+        if (!writeBaseline(options.write_baseline, options, results)) {
+            cerr << "Cannot write baseline: " << options.write_baseline << endl;
+            return 1;
+        }
+        cerr << "Baseline written to " << options.write_baseline << endl;
+    }
+    if (!options.baseline.empty() && checkBaseline(baseline, options, results) > 0) {
+        return 2;
+    }
+    return 0;
+}
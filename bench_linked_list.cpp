@@ -0,0 +1,587 @@
+#include "singly_linked_list.h"
+#include "mpsc_queue.h"
+#include "fat_file_system.h"
+#include "unrolled_linked_list.h"
+#include "intrusive_list.h"
+#include "static_singly_linked_list.h"
+#include "concurrent_linked_list.h"
+#include "perf_counters.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <memory_resource>
+#include <random>
+#include <algorithm>
+
+using namespace std;
+
+// ============================================
+// LINKED LIST BENCHMARKS
+// ============================================
+
+namespace {
+
+double secondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+void printHeader(const string& title) {
+    cout << "\n" << string(60, '=') << endl;
+    cout << title << endl;
+    cout << string(60, '=') << endl;
+}
+
+// ============== MPSC QUEUE VS MUTEX + LIST ==============
+
+// Message queue as used today: SinglyLinkedList behind a mutex
+double runMutexListQueue(int producers, int per_producer) {
+    SinglyLinkedList<int> list;
+    mutex list_mutex;
+    vector<thread> threads;
+
+    auto start = chrono::steady_clock::now();
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < per_producer; i++) {
+                lock_guard<mutex> lock(list_mutex);
+                list.insertAtEnd(i);
+            }
+        });
+    }
+
+    long long total = static_cast<long long>(producers) * per_producer;
+    long long received = 0;
+    while (received < total) {
+        unique_lock<mutex> lock(list_mutex);
+        if (list.isEmpty()) {
+            lock.unlock();
+            this_thread::yield();
+            continue;
+        }
+        volatile int value = list.getConstRef(0);
+        (void)value;
+        list.deleteFromBeginning();
+        received++;
+    }
+
+    for (thread& t : threads) t.join();
+    return total / secondsSince(start);
+}
+
+// Shared pool (lock-free enqueue) or one pool per producer handle (wait-free)
+double runMpscQueue(int producers, int per_producer, bool handles) {
+    MpscQueue<int> queue(4096, handles ? producers : 0);
+    vector<thread> threads;
+
+    auto start = chrono::steady_clock::now();
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&, p]() {
+            for (int i = 0; i < per_producer; i++) {
+                while (!(handles ? queue.getProducer(p).tryEnqueue(i) : queue.tryEnqueue(i))) {
+                    this_thread::yield();
+                }
+            }
+        });
+    }
+
+    long long total = static_cast<long long>(producers) * per_producer;
+    long long received = 0;
+    int value = 0;
+    while (received < total) {
+        if (queue.tryDequeue(value)) {
+            received++;
+        } else {
+            this_thread::yield();
+        }
+    }
+
+    for (thread& t : threads) t.join();
+    return total / secondsSince(start);
+}
+
+void benchMpscQueue() {
+    const int per_producer = 200000;
+
+    printHeader("MPSC QUEUE VS MUTEX-PROTECTED SinglyLinkedList");
+    cout << setw(10) << "Producers" << setw(18) << "mutex list Mops/s"
+         << setw(20) << "shared pool Mops/s" << setw(20) << "handles Mops/s" << endl;
+
+    for (int producers = 1; producers <= 8; producers *= 2) {
+        double locked = runMutexListQueue(producers, per_producer);
+        double lock_free = runMpscQueue(producers, per_producer, false);
+        double wait_free = runMpscQueue(producers, per_producer, true);
+        cout << setw(10) << producers
+             << setw(18) << fixed << setprecision(2) << locked / 1e6
+             << setw(20) << lock_free / 1e6
+             << setw(20) << wait_free / 1e6 << endl;
+    }
+}
+
+// ============== NODE ALLOCATOR CHURN ==============
+
+// Grow to `live` nodes, then repeatedly delete from the front and append
+// at the back, the steady-state pattern of a message or free-slot list
+template <typename List>
+double runChurn(List& list, int live, int operations) {
+    for (int i = 0; i < live; i++) list.insertAtEnd(i);
+
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < operations; i++) {
+        list.deleteFromBeginning();
+        list.insertAtEnd(i);
+        if ((i & 1023) == 0) {
+            // Periodic bursts so the allocator sees growth and shrinkage
+            for (int j = 0; j < 64; j++) list.insertAtBeginning(j);
+            for (int j = 0; j < 64; j++) list.deleteFromBeginning();
+        }
+    }
+    return operations / secondsSince(start);
+}
+
+// Same churn on the fixed-capacity list (no allocator at all)
+void benchStaticList() {
+    const int operations = 2000000;
+    const int live = 1024;
+
+    printHeader("FIXED-CAPACITY LIST CHURN (1024 live)");
+    cout << setw(24) << "List" << setw(14) << "Mops/s" << endl;
+
+    SinglyLinkedList<int, std::allocator<Node<int>>> heap_list;
+    PooledSinglyLinkedList<int> pooled_list;
+    auto static_list = make_unique<StaticSinglyLinkedList<int, live + 64>>();
+
+    cout << setw(24) << "new/delete" << setw(14) << fixed << setprecision(2)
+         << runChurn(heap_list, live, operations) / 1e6 << endl;
+    cout << setw(24) << "NodePoolAllocator" << setw(14) << runChurn(pooled_list, live, operations) / 1e6 << endl;
+    cout << setw(24) << "StaticSinglyLinkedList" << setw(14) << runChurn(*static_list, live, operations) / 1e6 << endl;
+}
+
+void benchNodeAllocators() {
+    const int operations = 2000000;
+
+    printHeader("NODE ALLOCATION: INSERT/DELETE CHURN");
+    cout << setw(10) << "Live" << setw(14) << "new Mops/s"
+         << setw(14) << "pool Mops/s" << setw(14) << "pmr Mops/s" << endl;
+
+    for (int live = 16; live <= 65536; live *= 16) {
+        SinglyLinkedList<int, std::allocator<Node<int>>> heap_list;
+        PooledSinglyLinkedList<int> pooled_list;
+        std::pmr::unsynchronized_pool_resource resource;
+        PmrSinglyLinkedList<int> pmr_list(&resource);
+
+        double heap = runChurn(heap_list, live, operations);
+        double pooled = runChurn(pooled_list, live, operations);
+        double pmr = runChurn(pmr_list, live, operations);
+        cout << setw(10) << live
+             << setw(14) << fixed << setprecision(2) << heap / 1e6
+             << setw(14) << pooled / 1e6
+             << setw(14) << pmr / 1e6 << endl;
+    }
+}
+
+// ============== FileControlBlock COPIES AVOIDED ==============
+
+// FileControlBlock that counts how often it is copied or moved
+struct CountedFCB : FileControlBlock {
+    static long long copies;
+    static long long moves;
+
+    CountedFCB(const std::string& name, int start, bool is_dir)
+        : FileControlBlock(name, start, is_dir) {}
+    CountedFCB(const CountedFCB& other) : FileControlBlock(other) { copies++; }
+    CountedFCB(CountedFCB&& other) noexcept : FileControlBlock(std::move(other)) { moves++; }
+};
+long long CountedFCB::copies = 0;
+long long CountedFCB::moves = 0;
+
+enum class InsertStyle { Copy, Move, Emplace };
+
+// Build a directory of `files` FCBs, each carrying `entries` child names
+double runFcbInsertion(InsertStyle style, int files, int entries) {
+    CountedFCB::copies = CountedFCB::moves = 0;
+    SinglyLinkedList<CountedFCB> directory;
+
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < files; i++) {
+        string name = "/dir/some_longer_file_name_" + to_string(i) + ".dat";
+        if (style == InsertStyle::Emplace) {
+            CountedFCB& fcb = directory.emplaceBack(name, i + 2, true);
+            for (int e = 0; e < entries; e++) fcb.directory_entries.emplaceBack("entry");
+            continue;
+        }
+
+        CountedFCB fcb(name, i + 2, true);
+        for (int e = 0; e < entries; e++) fcb.directory_entries.emplaceBack("entry");
+        if (style == InsertStyle::Copy) {
+            directory.insertAtEnd(fcb);
+        } else {
+            directory.insertAtEnd(std::move(fcb));
+        }
+    }
+    return files / secondsSince(start);
+}
+
+void benchFcbCopies() {
+    const int files = 200000;
+
+    printHeader("FileControlBlock INSERTION: COPIES AVOIDED");
+    cout << setw(9) << "Entries" << setw(10) << "Style" << setw(12) << "Copies"
+         << setw(12) << "Moves" << setw(14) << "Kinserts/s" << endl;
+
+    const pair<InsertStyle, const char*> styles[] = {
+        {InsertStyle::Copy, "copy"}, {InsertStyle::Move, "move"}, {InsertStyle::Emplace, "emplace"}};
+    for (int entries : {0, 8}) {
+        for (const auto& style : styles) {
+            double rate = runFcbInsertion(style.first, files, entries);
+            cout << setw(9) << entries << setw(10) << style.second
+                 << setw(12) << CountedFCB::copies << setw(12) << CountedFCB::moves
+                 << setw(14) << fixed << setprecision(0) << rate / 1e3 << endl;
+        }
+    }
+}
+
+// ============== FAT ACCESS PATTERN: LIST VS UNROLLED VS VECTOR ==============
+
+// Follow short cluster chains from random starting clusters, one
+// getRef() per hop
+template <typename Table>
+long long walkFatChains(Table& table, int clusters, int lookups) {
+    mt19937 rng(42);
+    long long checksum = 0;
+    int done = 0;
+    while (done < lookups) {
+        int cluster = static_cast<int>(rng() % clusters);
+        for (int hop = 0; hop < 8 && done < lookups; hop++, done++) {
+            FATCluster& entry = table.getRef(cluster);
+            checksum += entry.cluster_number;
+            cluster = entry.next_cluster;
+        }
+    }
+    return checksum;
+}
+
+// getRef() access as the FAT code does it: follow cluster chains of
+// randomly placed files, plus a linear free-cluster scan
+template <typename Table>
+double runFatPattern(Table& table, int clusters, int lookups) {
+    auto start = chrono::steady_clock::now();
+    long long checksum = walkFatChains(table, clusters, lookups);
+    // findFreeCluster-style scan
+    for (const FATCluster& entry : table) {
+        checksum += entry.isFree() ? 1 : 0;
+    }
+    volatile long long sink = checksum;
+    (void)sink;
+    return lookups / secondsSince(start);
+}
+
+template <typename Table>
+void fillFat(Table& table, int clusters) {
+    for (int i = 0; i < clusters; i++) {
+        FATCluster cluster(i);
+        cluster.next_cluster = (i + 1) % clusters;
+        table.insertAtEnd(cluster);
+    }
+}
+
+// std::vector adapter with the list's getRef/insertAtEnd names
+struct VectorTable {
+    vector<FATCluster> entries;
+    void insertAtEnd(const FATCluster& cluster) { entries.push_back(cluster); }
+    FATCluster& getRef(int position) { return entries[position]; }
+    vector<FATCluster>::iterator begin() { return entries.begin(); }
+    vector<FATCluster>::iterator end() { return entries.end(); }
+};
+
+void benchFatAccess() {
+    const int lookups = 200000;
+
+    printHeader("FAT ACCESS PATTERN: getRef() CHAIN WALKS + FREE SCAN");
+    cout << setw(10) << "Clusters" << setw(14) << "list Mops/s"
+         << setw(16) << "unrolled Mops/s" << setw(14) << "vector Mops/s" << endl;
+
+    for (int clusters = 256; clusters <= 16384; clusters *= 4) {
+        SinglyLinkedList<FATCluster> list;
+        UnrolledLinkedList<FATCluster> unrolled;
+        VectorTable table;
+        fillFat(list, clusters);
+        fillFat(unrolled, clusters);
+        fillFat(table, clusters);
+
+        // The plain list is O(n) per lookup; scale its run down
+        int list_lookups = lookups * 256 / clusters;
+        double list_rate = runFatPattern(list, clusters, list_lookups);
+        double unrolled_rate = runFatPattern(unrolled, clusters, lookups);
+        double vector_rate = runFatPattern(table, clusters, lookups);
+        cout << setw(10) << clusters
+             << setw(14) << fixed << setprecision(3) << list_rate / 1e6
+             << setw(16) << unrolled_rate / 1e6
+             << setw(14) << vector_rate / 1e6 << endl;
+    }
+}
+
+// ============== FAT ACCESS PATTERN: HARDWARE EVENTS ==============
+
+// Counters around the chain walks alone, printed per getRef() hop
+template <typename Table>
+void countFatWalks(const char* name, Table& table, int clusters, int lookups,
+                   PerfCounters& counters) {
+    counters.start();
+    long long checksum = walkFatChains(table, clusters, lookups);
+    counters.pause();
+    volatile long long sink = checksum;
+    (void)sink;
+
+    PerfReading reading = counters.read();
+    cout << setw(10) << clusters << setw(10) << name << fixed << setprecision(2);
+    for (size_t i = 0; i < kPerfEventCount; i++) {
+        if (reading.has(static_cast<PerfEvent>(i))) {
+            cout << setw(15) << static_cast<double>(reading.values[i]) / lookups;
+        } else if (reading.neverRan(static_cast<PerfEvent>(i))) {
+            cout << setw(15) << "not scheduled";
+        } else {
+            cout << setw(15) << "-";
+        }
+    }
+    cout << endl;
+}
+
+// What the pointer chasing in SinglyLinkedList::getRef costs in cycles
+// and cache/TLB misses, next to the unrolled list and a vector
+void benchFatAccessCounters(PerfCounters& counters) {
+    printHeader("FAT ACCESS PATTERN: HARDWARE EVENTS PER getRef() HOP");
+    if (!counters.available()) {
+        cout << "Skipped: " << counters.unavailableReason() << endl;
+        return;
+    }
+    cout << setw(10) << "Clusters" << setw(10) << "Table";
+    for (size_t i = 0; i < kPerfEventCount; i++) {
+        cout << setw(15) << perfEventName(static_cast<PerfEvent>(i));
+    }
+    cout << endl;
+
+    const int lookups = 200000;
+    for (int clusters = 1024; clusters <= 16384; clusters *= 16) {
+        SinglyLinkedList<FATCluster> list;
+        UnrolledLinkedList<FATCluster> unrolled;
+        VectorTable table;
+        fillFat(list, clusters);
+        fillFat(unrolled, clusters);
+        fillFat(table, clusters);
+
+        int list_lookups = lookups * 256 / clusters;
+        countFatWalks("list", list, clusters, list_lookups, counters);
+        countFatWalks("unrolled", unrolled, clusters, lookups, counters);
+        countFatWalks("vector", table, clusters, lookups, counters);
+    }
+}
+
+// ============== ASCENDING INDEX LOOPS ==============
+
+// for (i = 0; i < size; i++) getConstRef(i), the findFreeCluster shape
+void benchIndexLoop() {
+    printHeader("ASCENDING getConstRef(i) LOOP (cursor-cached)");
+    cout << setw(10) << "Size" << setw(16) << "ns/element" << endl;
+
+    for (int n = 1000; n <= 100000; n *= 10) {
+        SinglyLinkedList<int> list;
+        for (int i = 0; i < n; i++) list.insertAtEnd(i);
+
+        long long sum = 0;
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < n; i++) {
+            sum += list.getConstRef(i);
+        }
+        double elapsed = secondsSince(start);
+        volatile long long sink = sum;
+        (void)sink;
+        cout << setw(10) << n << setw(16) << fixed << setprecision(2) << elapsed * 1e9 / n << endl;
+    }
+}
+
+// ============== INTRUSIVE VS NODE-WRAPPING LIST ==============
+
+// Cache-entry sized record kept on a free list and a dirty list
+struct BlockRecord : IntrusiveListNode<BlockRecord> {
+    size_t block;
+    uint64_t generation;
+    char payload[48];
+    IntrusiveLink<BlockRecord> dirty_link;
+
+    explicit BlockRecord(size_t b = 0) : block(b), generation(0), payload() {}
+};
+
+void benchIntrusiveList() {
+    const int records = 100000;
+    const int rounds = 20;
+    vector<BlockRecord> storage;
+    for (int i = 0; i < records; i++) storage.emplace_back(i);
+
+    printHeader("FREE + DIRTY LIST MEMBERSHIP: INTRUSIVE VS Node<T> COPIES");
+    cout << setw(22) << "List" << setw(14) << "Mops/s" << endl;
+
+    // Node-wrapping lists: every membership is a node allocation + copy
+    auto start = chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+        SinglyLinkedList<BlockRecord> free_list;
+        SinglyLinkedList<BlockRecord> dirty;
+        for (BlockRecord& record : storage) {
+            free_list.insertAtEnd(record);
+            if (record.block % 4 == 0) dirty.insertAtEnd(record);
+        }
+        while (!dirty.isEmpty()) dirty.deleteFromBeginning();
+        while (!free_list.isEmpty()) free_list.deleteFromBeginning();
+    }
+    double wrapped = static_cast<double>(records) * rounds / secondsSince(start);
+
+    start = chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+        IntrusiveSinglyLinkedList<BlockRecord> free_list;
+        IntrusiveSinglyLinkedList<BlockRecord, MemberLink<BlockRecord, &BlockRecord::dirty_link>> dirty;
+        for (BlockRecord& record : storage) {
+            free_list.insertAtEnd(record);
+            if (record.block % 4 == 0) dirty.insertAtEnd(record);
+        }
+        while (dirty.deleteFromBeginning() != nullptr) {}
+        while (free_list.deleteFromBeginning() != nullptr) {}
+    }
+    double intrusive = static_cast<double>(records) * rounds / secondsSince(start);
+
+    cout << setw(22) << "SinglyLinkedList" << setw(14) << fixed << setprecision(2) << wrapped / 1e6 << endl;
+    cout << setw(22) << "Intrusive" << setw(14) << intrusive / 1e6 << endl;
+}
+
+// ============== SORTING A LIST OF NAMES ==============
+
+// In-place merge sort vs the copy-to-vector round trip callers use today
+void benchSort() {
+    printHeader("SORT FILE NAMES: IN-PLACE MERGE SORT VS VECTOR ROUND TRIP");
+    cout << setw(10) << "Names" << setw(14) << "list ms" << setw(14) << "vector ms" << endl;
+
+    for (int n = 1000; n <= 100000; n *= 10) {
+        mt19937 rng(3);
+        SinglyLinkedList<string> names;
+        for (int i = 0; i < n; i++) names.insertAtEnd("file_" + to_string(rng() % 1000000) + ".dat");
+        SinglyLinkedList<string> copy(names);
+
+        auto start = chrono::steady_clock::now();
+        names.sort();
+        double in_place = secondsSince(start);
+
+        start = chrono::steady_clock::now();
+        vector<string> scratch(copy.begin(), copy.end());
+        sort(scratch.begin(), scratch.end());
+        copy.clear();
+        for (string& name : scratch) copy.insertAtEnd(std::move(name));
+        double round_trip = secondsSince(start);
+
+        cout << setw(10) << n << setw(14) << fixed << setprecision(2) << in_place * 1e3
+             << setw(14) << round_trip * 1e3 << endl;
+    }
+}
+
+// ============== CONCURRENT LIST SCALING ==============
+
+// Shared key set: reads search a random key, writes remove and re-append one
+double runGlobalMutexList(int threads, int read_percent, int keys, int total_ops) {
+    SinglyLinkedList<int> list;
+    mutex list_mutex;
+    for (int k = 0; k < keys; k++) list.insertAtEnd(k);
+
+    vector<thread> workers;
+    auto start = chrono::steady_clock::now();
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            mt19937 rng(t + 1);
+            for (int i = 0; i < total_ops / threads; i++) {
+                int key = static_cast<int>(rng() % keys);
+                lock_guard<mutex> lock(list_mutex);
+                if (static_cast<int>(rng() % 100) < read_percent) {
+                    volatile bool found = list.search(key);
+                    (void)found;
+                } else {
+                    int position = 0;
+                    for (auto it = list.begin(); it != list.end() && *it != key; ++it) position++;
+                    if (position < list.getSize()) {
+                        list.deleteFromPosition(position);
+                        list.insertAtEnd(key);
+                    }
+                }
+            }
+        });
+    }
+    for (thread& worker : workers) worker.join();
+    return total_ops / secondsSince(start);
+}
+
+double runConcurrentList(int threads, int read_percent, int keys, int total_ops) {
+    ConcurrentSinglyLinkedList<int> list;
+    for (int k = 0; k < keys; k++) list.insertAtEnd(k);
+
+    vector<thread> workers;
+    auto start = chrono::steady_clock::now();
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            mt19937 rng(t + 1);
+            for (int i = 0; i < total_ops / threads; i++) {
+                int key = static_cast<int>(rng() % keys);
+                if (static_cast<int>(rng() % 100) < read_percent) {
+                    volatile bool found = list.search(key);
+                    (void)found;
+                } else if (list.remove(key)) {
+                    list.insertAtEnd(key);
+                }
+            }
+        });
+    }
+    for (thread& worker : workers) worker.join();
+    return total_ops / secondsSince(start);
+}
+
+void benchConcurrentList() {
+    const int keys = 256;
+    const int total_ops = 200000;
+
+    printHeader("CONCURRENT LIST SCALING (" + to_string(keys) + " keys, " +
+                to_string(thread::hardware_concurrency()) + " hardware threads)");
+    cout << setw(8) << "Threads" << setw(8) << "Reads" << setw(18) << "global mutex Kops"
+         << setw(18) << "concurrent Kops" << endl;
+
+    for (int read_percent : {90, 50}) {
+        for (int threads = 1; threads <= 32; threads *= 2) {
+            double locked = runGlobalMutexList(threads, read_percent, keys, total_ops);
+            double concurrent = runConcurrentList(threads, read_percent, keys, total_ops);
+            cout << setw(8) << threads << setw(7) << read_percent << "%"
+                 << setw(18) << fixed << setprecision(0) << locked / 1e3
+                 << setw(18) << concurrent / 1e3 << endl;
+        }
+    }
+}
+
+}  // namespace
+
+// Usage: linkedlist_bench [--perf]
+//   --perf adds hardware counter readings (perf_event_open) for the FAT
+//   access pattern
+int main(int argc, char* argv[]) {
+    bool perf = argc > 1 && string(argv[1]) == "--perf";
+
+    benchMpscQueue();
+    benchNodeAllocators();
+    benchStaticList();
+    benchFcbCopies();
+    benchFatAccess();
+    if (perf) {
+        PerfCounters counters;
+        benchFatAccessCounters(counters);
+    }
+    benchIndexLoop();
+    benchIntrusiveList();
+    benchSort();
+    benchConcurrentList();
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include "block_device.h"
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+
+// ============== BLOCK DEVICE ==============
+
+bool BlockDevice::readBlocks(const vector<BlockRead>& batch) {
+    for (const BlockRead& read : batch) {
+        if (!readBlock(read.block, read.data)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BlockDevice::writeBlocks(const vector<BlockWrite>& batch) {
+    for (const BlockWrite& write : batch) {
+        if (!writeBlock(write.block, write.data)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ============== MEMORY BLOCK DEVICE ==============
+
+MemoryBlockDevice::MemoryBlockDevice(size_t block_size_bytes, size_t blocks)
+    : block_size(block_size_bytes),
+      block_count(blocks),
+      storage(block_size_bytes * blocks, 0) {}
+
+bool MemoryBlockDevice::readBlock(size_t block, void* buffer) {
+    if (block >= block_count) {
+        return false;
+    }
+    memcpy(buffer, storage.data() + block * block_size, block_size);
+    return true;
+}
+
+bool MemoryBlockDevice::writeBlock(size_t block, const void* data) {
+    if (block >= block_count) {
+        return false;
+    }
+    memcpy(storage.data() + block * block_size, data, block_size);
+    return true;
+}
+
+// ============== FILE BLOCK DEVICE ==============
+
+FileBlockDevice::FileBlockDevice(const string& path, size_t block_size_bytes, size_t blocks)
+    : fd(-1), block_size(block_size_bytes), block_count(blocks) {
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd >= 0 && ::ftruncate(fd, static_cast<off_t>(block_size * block_count)) != 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+FileBlockDevice::~FileBlockDevice() {
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+bool FileBlockDevice::readBlock(size_t block, void* buffer) {
+    if (fd < 0 || block >= block_count) {
+        return false;
+    }
+    ssize_t n = ::pread(fd, buffer, block_size, static_cast<off_t>(block * block_size));
+    return n == static_cast<ssize_t>(block_size);
+}
+
+bool FileBlockDevice::writeBlock(size_t block, const void* data) {
+    if (fd < 0 || block >= block_count) {
+        return false;
+    }
+    ssize_t n = ::pwrite(fd, data, block_size, static_cast<off_t>(block * block_size));
+    return n == static_cast<ssize_t>(block_size);
+}
+
+bool FileBlockDevice::flush() {
+    return fd >= 0 && ::fdatasync(fd) == 0;
+}
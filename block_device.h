@@ -0,0 +1,109 @@
+#ifndef BLOCK_DEVICE_H
+#define BLOCK_DEVICE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ============================================
+// BLOCK DEVICE INTERFACE
+// ============================================
+
+// One entry of a batched write. Batches are handed to the device
+// sorted by block number so access stays sequential.
+struct BlockWrite {
+    size_t block;
+    const uint8_t* data;
+
+    BlockWrite(size_t b, const uint8_t* d) : block(b), data(d) {}
+};
+
+// One entry of a batched read
+struct BlockRead {
+    size_t block;
+    uint8_t* data;
+
+    BlockRead(size_t b, uint8_t* d) : block(b), data(d) {}
+};
+
+// Access pattern hints for devices that can use them (memory-mapped images)
+enum class AccessHint {
+    Sequential,   // Streaming read of the given blocks
+    WillNeed      // Blocks about to be read (cluster chain prefetch)
+};
+
+// Fixed-size block storage underneath the file system.
+// One block holds exactly one cluster.
+class BlockDevice {
+public:
+    virtual ~BlockDevice() = default;
+
+    virtual size_t getBlockSize() const = 0;
+    virtual size_t getBlockCount() const = 0;
+
+    virtual bool readBlock(size_t block, void* buffer) = 0;
+    virtual bool writeBlock(size_t block, const void* data) = 0;
+
+    // Batched transfers (default: one readBlock/writeBlock per entry)
+    virtual bool readBlocks(const std::vector<BlockRead>& batch);
+    virtual bool writeBlocks(const std::vector<BlockWrite>& batch);
+
+    // Make previously written blocks durable
+    virtual bool flush() { return true; }
+
+    // In-place access for memory-mapped devices; nullptr means "use the cache"
+    virtual uint8_t* mappedBlock(size_t) { return nullptr; }
+    virtual void adviseAccess(const std::vector<size_t>&, AccessHint) {}
+};
+
+// ============================================
+// RAM-BACKED DEVICE
+// ============================================
+
+class MemoryBlockDevice : public BlockDevice {
+private:
+    size_t block_size;
+    size_t block_count;
+    std::vector<uint8_t> storage;
+
+public:
+    MemoryBlockDevice(size_t block_size_bytes, size_t blocks);
+
+    size_t getBlockSize() const override { return block_size; }
+    size_t getBlockCount() const override { return block_count; }
+
+    bool readBlock(size_t block, void* buffer) override;
+    bool writeBlock(size_t block, const void* data) override;
+};
+
+// ============================================
+// IMAGE-FILE DEVICE (POSIX)
+// ============================================
+
+// Volume image in a regular host file, one pread/pwrite per block
+class FileBlockDevice : public BlockDevice {
+private:
+    int fd;
+    size_t block_size;
+    size_t block_count;
+
+public:
+    // Opens (creating and sizing if needed) the image at `path`
+    FileBlockDevice(const std::string& path, size_t block_size_bytes, size_t blocks);
+    ~FileBlockDevice() override;
+
+    FileBlockDevice(const FileBlockDevice&) = delete;
+    FileBlockDevice& operator=(const FileBlockDevice&) = delete;
+
+    bool isOpen() const { return fd >= 0; }
+
+    size_t getBlockSize() const override { return block_size; }
+    size_t getBlockCount() const override { return block_count; }
+
+    bool readBlock(size_t block, void* buffer) override;
+    bool writeBlock(size_t block, const void* data) override;
+    bool flush() override;
+};
+
+#endif // BLOCK_DEVICE_H
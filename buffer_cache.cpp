@@ -0,0 +1,354 @@
+#include "buffer_cache.h"
+#include "fs_trace.h"
+#include "work_counter.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+// ============================================
+// IMPLEMENTATION
+// ============================================
+
+BufferCache::BufferCache(shared_ptr<BlockDevice> block_device,
+                         const WriteBackPolicy& write_back_policy)
+    : device(block_device),
+      policy(write_back_policy),
+      block_size(block_device->getBlockSize()),
+      dirty_count(0),
+      use_clock(0),
+      write_clock(0),
+      flush_clock(0),
+      stopping(false) {
+    if (policy.cache_blocks == 0) {
+        policy.cache_blocks = 1;
+    }
+    if (policy.background_flush) {
+        flusher = thread(&BufferCache::flusherLoop, this);
+    }
+}
+
+BufferCache::~BufferCache() {
+    {
+        lock_guard<mutex> lock(cache_mutex);
+        stopping = true;
+    }
+    flusher_cv.notify_all();
+    if (flusher.joinable()) {
+        flusher.join();
+    }
+    writeBack(nullptr);
+    device->flush();
+}
+
+// ============== HELPER METHODS ==============
+
+BufferCache::CachedBlock* BufferCache::acquire(size_t block, bool fill,
+                                               unique_lock<mutex>& lock) {
+    auto it = blocks.find(block);
+    if (it != blocks.end()) {
+        it->second.last_used = ++use_clock;
+        return &it->second;
+    }
+
+    FS_TRACE_SPAN("cacheMiss", "cache");
+    for (;;) {
+        uint64_t epoch = flush_clock;
+        vector<uint8_t> data(block_size, 0);
+        if (fill) {
+            // Cache fill happens without the lock so writers are not stalled
+            lock.unlock();
+            bool ok;
+            {
+                FS_TRACE_SPAN("deviceRead", "device");
+                ok = device->readBlock(block, data.data());
+                work_counter::addDeviceReads(1);
+            }
+            lock.lock();
+            if (!ok) {
+                return nullptr;
+            }
+        }
+
+        if (!makeRoom(lock)) {
+            return nullptr;
+        }
+
+        // Another thread may have loaded the block while the lock was released
+        it = blocks.find(block);
+        if (it == blocks.end()) {
+            // ...or written it, flushed it and had it evicted, leaving the
+            // device newer than what was read
+            if (fill && flush_clock != epoch) {
+                continue;
+            }
+            it = blocks.emplace(block, CachedBlock()).first;
+            it->second.data = std::move(data);
+        }
+        it->second.last_used = ++use_clock;
+        return &it->second;
+    }
+}
+
+bool BufferCache::makeRoom(unique_lock<mutex>& lock) {
+    while (blocks.size() >= policy.cache_blocks) {
+        // Evict the least recently used clean block
+        auto victim = blocks.end();
+        for (auto it = blocks.begin(); it != blocks.end(); ++it) {
+            if (!it->second.dirty &&
+                (victim == blocks.end() || it->second.last_used < victim->second.last_used)) {
+                victim = it;
+            }
+        }
+
+        if (victim != blocks.end()) {
+            blocks.erase(victim);
+            continue;
+        }
+
+        // Everything is dirty: the caller has to wait for a write-back
+        lock.unlock();
+        bool ok = writeBack(nullptr);
+        lock.lock();
+        if (!ok) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BufferCache::dirtyRatioCrossed() const {
+    return dirty_count > 0 &&
+           dirty_count >= policy.dirty_ratio * policy.cache_blocks;
+}
+
+bool BufferCache::thresholdCrossed() const {
+    if (dirty_count == 0) {
+        return false;
+    }
+    if (dirtyRatioCrossed()) {
+        return true;
+    }
+
+    auto max_age = chrono::milliseconds(policy.max_dirty_age_ms);
+    auto now = chrono::steady_clock::now();
+    for (const auto& pair : blocks) {
+        if (pair.second.dirty && now - pair.second.dirty_since >= max_age) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool BufferCache::writeBack(const vector<size_t>* selection) {
+    lock_guard<mutex> pass(writeback_mutex);
+
+    struct PendingWrite {
+        size_t block;
+        uint64_t generation;
+        vector<uint8_t> data;
+    };
+    vector<PendingWrite> pending;
+
+    // Snapshot dirty blocks in block order
+    {
+        lock_guard<mutex> lock(cache_mutex);
+        for (const auto& pair : blocks) {
+            if (!pair.second.dirty) continue;
+            if (selection && !binary_search(selection->begin(), selection->end(), pair.first)) {
+                continue;
+            }
+            pending.push_back({pair.first, pair.second.generation, pair.second.data});
+        }
+    }
+
+    if (pending.empty()) {
+        return true;
+    }
+
+    vector<BlockWrite> batch;
+    batch.reserve(pending.size());
+    for (const PendingWrite& write : pending) {
+        batch.emplace_back(write.block, write.data.data());
+    }
+
+    bool ok;
+    {
+        FS_TRACE_SPAN("deviceWrite", "device");
+        ok = device->writeBlocks(batch);
+        work_counter::addDeviceWrites(batch.size());
+    }
+    if (!ok) {
+        return false;
+    }
+
+    // Only blocks not rewritten during the I/O become clean. Stamps never
+    // repeat, so a block discarded and written again meanwhile stays dirty.
+    lock_guard<mutex> lock(cache_mutex);
+    flush_clock++;
+    for (const PendingWrite& write : pending) {
+        auto it = blocks.find(write.block);
+        if (it != blocks.end() && it->second.dirty &&
+            it->second.generation == write.generation) {
+            it->second.dirty = false;
+            dirty_count--;
+        }
+    }
+    return true;
+}
+
+void BufferCache::flusherLoop() {
+    unique_lock<mutex> lock(cache_mutex);
+    while (!stopping) {
+        flusher_cv.wait_for(lock, chrono::milliseconds(policy.flush_interval_ms));
+        if (stopping) break;
+        if (!thresholdCrossed()) continue;
+
+        lock.unlock();
+        writeBack(nullptr);
+        lock.lock();
+    }
+}
+
+// ============== BLOCK ACCESS ==============
+
+bool BufferCache::read(size_t block, size_t offset, void* buffer, size_t bytes) {
+    if (offset + bytes > block_size) {
+        return false;
+    }
+
+    // Memory-mapped devices are accessed in place
+    if (const uint8_t* mapped = device->mappedBlock(block)) {
+        memcpy(buffer, mapped + offset, bytes);
+        return true;
+    }
+
+    unique_lock<mutex> lock(cache_mutex);
+    CachedBlock* entry = acquire(block, true, lock);
+    if (!entry) {
+        return false;
+    }
+    memcpy(buffer, entry->data.data() + offset, bytes);
+    return true;
+}
+
+bool BufferCache::write(size_t block, size_t offset, const void* data, size_t bytes) {
+    if (offset + bytes > block_size) {
+        return false;
+    }
+
+    if (uint8_t* mapped = device->mappedBlock(block)) {
+        memcpy(mapped + offset, data, bytes);
+        return true;
+    }
+
+    // A whole-block overwrite does not need the old contents
+    bool partial = offset != 0 || bytes != block_size;
+
+    unique_lock<mutex> lock(cache_mutex);
+    CachedBlock* entry = acquire(block, partial, lock);
+    if (!entry) {
+        return false;
+    }
+
+    memcpy(entry->data.data() + offset, data, bytes);
+    entry->generation = ++write_clock;
+    if (!entry->dirty) {
+        entry->dirty = true;
+        entry->dirty_since = chrono::steady_clock::now();
+        dirty_count++;
+    }
+
+    if (policy.background_flush && dirtyRatioCrossed()) {
+        flusher_cv.notify_one();
+    }
+    return true;
+}
+
+void BufferCache::prefetch(const vector<size_t>& wanted) {
+    // Nothing to copy for a mapped device; let the kernel read ahead instead
+    if (!wanted.empty() && device->mappedBlock(wanted[0])) {
+        device->adviseAccess(wanted, AccessHint::WillNeed);
+        return;
+    }
+
+    vector<size_t> missing;
+    uint64_t epoch;
+    {
+        lock_guard<mutex> lock(cache_mutex);
+        epoch = flush_clock;
+        // Leave room for the caller's working set
+        size_t limit = max<size_t>(1, policy.cache_blocks / 2);
+        for (size_t block : wanted) {
+            if (missing.size() >= limit) break;
+            if (blocks.find(block) == blocks.end()) {
+                missing.push_back(block);
+            }
+        }
+    }
+    if (missing.empty()) {
+        return;
+    }
+
+    FS_TRACE_SPAN("cacheMiss", "cache");
+    vector<vector<uint8_t>> data(missing.size(), vector<uint8_t>(block_size));
+    vector<BlockRead> batch;
+    batch.reserve(missing.size());
+    for (size_t i = 0; i < missing.size(); i++) {
+        batch.emplace_back(missing[i], data[i].data());
+    }
+    bool ok;
+    {
+        FS_TRACE_SPAN("deviceRead", "device");
+        ok = device->readBlocks(batch);
+        work_counter::addDeviceReads(batch.size());
+    }
+    if (!ok) {
+        return;
+    }
+
+    // A write-back meanwhile may have made some of the batch stale; a
+    // prefetch is only a hint, so the whole fill is dropped
+    unique_lock<mutex> lock(cache_mutex);
+    for (size_t i = 0; i < missing.size(); i++) {
+        if (blocks.find(missing[i]) != blocks.end()) continue;
+        if (!makeRoom(lock) || flush_clock != epoch) return;
+        if (blocks.find(missing[i]) != blocks.end()) continue;
+
+        CachedBlock& entry = blocks[missing[i]];
+        entry.data = std::move(data[i]);
+        entry.last_used = ++use_clock;
+    }
+}
+
+void BufferCache::discard(size_t block) {
+    lock_guard<mutex> lock(cache_mutex);
+    auto it = blocks.find(block);
+    if (it == blocks.end()) {
+        return;
+    }
+    if (it->second.dirty) {
+        dirty_count--;
+    }
+    blocks.erase(it);
+}
+
+// ============== SYNCHRONOUS WRITE-BACK ==============
+
+bool BufferCache::flushBlocks(const vector<size_t>& selection) {
+    return writeBack(&selection);
+}
+
+bool BufferCache::flushAll() {
+    return writeBack(nullptr);
+}
+
+size_t BufferCache::getDirtyCount() const {
+    lock_guard<mutex> lock(cache_mutex);
+    return dirty_count;
+}
+
+size_t BufferCache::getCachedCount() const {
+    lock_guard<mutex> lock(cache_mutex);
+    return blocks.size();
+}
@@ -0,0 +1,104 @@
+#ifndef BUFFER_CACHE_H
+#define BUFFER_CACHE_H
+
+#include "block_device.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ============================================
+// WRITE-BACK POLICY
+// ============================================
+
+struct WriteBackPolicy {
+    size_t cache_blocks;          // Capacity of the buffer cache in blocks
+    double dirty_ratio;           // Flush once this fraction of the cache is dirty
+    unsigned max_dirty_age_ms;    // Flush once the oldest dirty block is this old
+    unsigned flush_interval_ms;   // How often the flusher re-checks the thresholds
+    bool background_flush;        // false: only explicit syncs write back
+
+    WriteBackPolicy() : cache_blocks(256),
+                        dirty_ratio(0.5),
+                        max_dirty_age_ms(1000),
+                        flush_interval_ms(100),
+                        background_flush(true) {}
+};
+
+// ============================================
+// BUFFER CACHE WITH BACKGROUND FLUSHER
+// ============================================
+
+// Block cache sitting between FATFileSystem and its BlockDevice.
+// Writes land in memory and are marked dirty; a flusher thread writes
+// them back (sorted by block number) when the dirty-ratio or age
+// threshold is crossed. Device I/O is never done under the cache lock.
+// Blocks of a memory-mapped device bypass the cache entirely.
+class BufferCache {
+private:
+    struct CachedBlock {
+        std::vector<uint8_t> data;
+        bool dirty;
+        uint64_t generation;   // write_clock stamp of the last write; detects writes racing a flush
+        uint64_t last_used;
+        std::chrono::steady_clock::time_point dirty_since;
+
+        CachedBlock() : dirty(false), generation(0), last_used(0) {}
+    };
+
+    std::shared_ptr<BlockDevice> device;
+    WriteBackPolicy policy;
+    size_t block_size;
+
+    std::map<size_t, CachedBlock> blocks;   // Ordered, so write-back is sequential
+    size_t dirty_count;
+    uint64_t use_clock;
+    uint64_t write_clock;                   // Cache-wide, so stamps survive discard()
+    uint64_t flush_clock;                   // Bumped by every write-back that reaches the device
+
+    mutable std::mutex cache_mutex;
+    std::mutex writeback_mutex;             // Serialises write-back passes
+    std::condition_variable flusher_cv;
+    std::thread flusher;
+    bool stopping;
+
+    // Helpers (called with cache_mutex held through `lock`)
+    CachedBlock* acquire(size_t block, bool fill, std::unique_lock<std::mutex>& lock);
+    bool makeRoom(std::unique_lock<std::mutex>& lock);
+    bool dirtyRatioCrossed() const;
+    bool thresholdCrossed() const;
+
+    bool writeBack(const std::vector<size_t>* selection);
+    void flusherLoop();
+
+public:
+    BufferCache(std::shared_ptr<BlockDevice> block_device,
+                const WriteBackPolicy& write_back_policy = WriteBackPolicy());
+    ~BufferCache();
+
+    BufferCache(const BufferCache&) = delete;
+    BufferCache& operator=(const BufferCache&) = delete;
+
+    // Byte-range access within a single block
+    bool read(size_t block, size_t offset, void* buffer, size_t bytes);
+    bool write(size_t block, size_t offset, const void* data, size_t bytes);
+
+    // Fill missing blocks with one batched device read
+    void prefetch(const std::vector<size_t>& wanted);
+
+    // Drop a block without writing it back (e.g. its cluster was freed)
+    void discard(size_t block);
+
+    // Synchronous write-back; `selection` must be sorted
+    bool flushBlocks(const std::vector<size_t>& selection);
+    bool flushAll();
+
+    size_t getDirtyCount() const;
+    size_t getCachedCount() const;
+};
+
+#endif // BUFFER_CACHE_H
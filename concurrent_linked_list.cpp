@@ -0,0 +1,241 @@
+#ifndef CONCURRENT_LINKED_LIST_CPP
+#define CONCURRENT_LINKED_LIST_CPP
+
+#include "concurrent_linked_list.h"
+#include <stdexcept>
+
+// ============== THREAD SLOTS ==============
+
+namespace concurrent_list_detail {
+
+inline std::atomic<bool>* slotClaims() {
+    static std::atomic<bool> claims[kMaxThreads] = {};
+    return claims;
+}
+
+// Claims the first free slot for the lifetime of the owning thread
+struct ThreadSlotClaim {
+    size_t index;
+
+    ThreadSlotClaim() : index(kMaxThreads) {
+        std::atomic<bool>* claims = slotClaims();
+        for (size_t i = 0; i < kMaxThreads; i++) {
+            bool expected = false;
+            if (claims[i].compare_exchange_strong(expected, true)) {
+                index = i;
+                return;
+            }
+        }
+        throw std::runtime_error("Too many threads using concurrent lists");
+    }
+
+    ~ThreadSlotClaim() {
+        slotClaims()[index].store(false);
+    }
+};
+
+inline size_t threadSlot() {
+    thread_local ThreadSlotClaim claim;
+    return claim.index;
+}
+
+}  // namespace concurrent_list_detail
+
+// ============== EPOCH PROTECTION ==============
+
+// Announce the current epoch (nested sections keep the outer one)
+template <typename T>
+ConcurrentSinglyLinkedList<T>::ReadGuard::ReadGuard(ConcurrentSinglyLinkedList& list)
+    : slot(list.reader_slots[concurrent_list_detail::threadSlot()].epoch),
+      previous(slot.load(std::memory_order_relaxed)) {
+    if (previous == kIdle) {
+        slot.store(list.global_epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+        // Pairs with the fence in reclaim(): either the reclaimer sees this
+        // announcement or this reader sees every unlink before it
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+}
+
+template <typename T>
+ConcurrentSinglyLinkedList<T>::ReadGuard::~ReadGuard() {
+    if (previous == kIdle) {
+        slot.store(kIdle, std::memory_order_release);
+    }
+}
+
+// Queue an unlinked node for freeing
+template <typename T>
+void ConcurrentSinglyLinkedList<T>::retire(CNode* node) {
+    std::lock_guard<std::mutex> lock(retire_mutex);
+    retired.push_back({node, global_epoch.load(std::memory_order_seq_cst)});
+    if (retired.size() >= kReclaimBatch) {
+        reclaim();
+    }
+}
+
+// Advance the epoch and free nodes retired before the oldest active reader
+// (caller holds retire_mutex)
+template <typename T>
+void ConcurrentSinglyLinkedList<T>::reclaim() {
+    uint64_t oldest = global_epoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (const ReaderSlot& reader : reader_slots) {
+        uint64_t epoch = reader.epoch.load(std::memory_order_seq_cst);
+        if (epoch < oldest) {
+            oldest = epoch;
+        }
+    }
+
+    size_t kept = 0;
+    for (const Retired& entry : retired) {
+        if (entry.epoch < oldest) {
+            delete entry.node;
+        } else {
+            retired[kept++] = entry;
+        }
+    }
+    retired.resize(kept);
+}
+
+// Unlink curr (caller holds pred's and curr's locks); curr->next is left
+// intact for readers still standing on curr
+template <typename T>
+void ConcurrentSinglyLinkedList<T>::unlinkAfter(CNode* pred, CNode* curr) {
+    pred->next.store(curr->next.load(std::memory_order_relaxed), std::memory_order_seq_cst);
+    size.fetch_sub(1, std::memory_order_relaxed);
+}
+
+// ============== LIST ==============
+
+// Constructor
+template <typename T>
+ConcurrentSinglyLinkedList<T>::ConcurrentSinglyLinkedList()
+    : size(0), global_epoch(0), reader_slots(concurrent_list_detail::kMaxThreads) {}
+
+// Destructor
+template <typename T>
+ConcurrentSinglyLinkedList<T>::~ConcurrentSinglyLinkedList() {
+    CNode* current = head.next.load(std::memory_order_relaxed);
+    while (current != nullptr) {
+        CNode* next = current->next.load(std::memory_order_relaxed);
+        delete current;
+        current = next;
+    }
+    for (const Retired& entry : retired) {
+        delete entry.node;
+    }
+}
+
+// Check if list is empty
+template <typename T>
+bool ConcurrentSinglyLinkedList<T>::isEmpty() const {
+    return head.next.load(std::memory_order_acquire) == nullptr;
+}
+
+// Get size of list (a snapshot)
+template <typename T>
+int ConcurrentSinglyLinkedList<T>::getSize() const {
+    return size.load(std::memory_order_relaxed);
+}
+
+// Insert at beginning
+template <typename T>
+void ConcurrentSinglyLinkedList<T>::insertAtBeginning(const T& value) {
+    CNode* node = new CNode(value);
+    std::lock_guard<std::mutex> lock(head.lock);
+    node->next.store(head.next.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    head.next.store(node, std::memory_order_release);
+    size.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Insert at end (walks hand-over-hand to the last node)
+template <typename T>
+void ConcurrentSinglyLinkedList<T>::insertAtEnd(const T& value) {
+    CNode* node = new CNode(value);
+    CNode* pred = &head;
+    pred->lock.lock();
+    CNode* curr = pred->next.load(std::memory_order_acquire);
+    while (curr != nullptr) {
+        curr->lock.lock();
+        pred->lock.unlock();
+        pred = curr;
+        curr = curr->next.load(std::memory_order_acquire);
+    }
+    pred->next.store(node, std::memory_order_release);
+    size.fetch_add(1, std::memory_order_relaxed);
+    pred->lock.unlock();
+}
+
+// Delete from beginning
+template <typename T>
+bool ConcurrentSinglyLinkedList<T>::deleteFromBeginning() {
+    head.lock.lock();
+    CNode* curr = head.next.load(std::memory_order_acquire);
+    if (curr == nullptr) {
+        head.lock.unlock();
+        return false;
+    }
+    curr->lock.lock();
+    unlinkAfter(&head, curr);
+    curr->lock.unlock();
+    head.lock.unlock();
+    retire(curr);
+    return true;
+}
+
+// Remove the first element equal to value
+template <typename T>
+bool ConcurrentSinglyLinkedList<T>::remove(const T& value) {
+    CNode* pred = &head;
+    pred->lock.lock();
+    CNode* curr = pred->next.load(std::memory_order_acquire);
+    while (curr != nullptr) {
+        curr->lock.lock();
+        if (curr->data == value) {
+            unlinkAfter(pred, curr);
+            curr->lock.unlock();
+            pred->lock.unlock();
+            retire(curr);
+            return true;
+        }
+        pred->lock.unlock();
+        pred = curr;
+        curr = curr->next.load(std::memory_order_acquire);
+    }
+    pred->lock.unlock();
+    return false;
+}
+
+// Search for a value without taking any lock
+template <typename T>
+bool ConcurrentSinglyLinkedList<T>::search(const T& value) {
+    ReadGuard guard(*this);
+    for (CNode* curr = head.next.load(std::memory_order_acquire); curr != nullptr;
+         curr = curr->next.load(std::memory_order_acquire)) {
+        if (curr->data == value) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Visit every element reachable at the time of the call (lock-free)
+template <typename T>
+template <typename Func>
+void ConcurrentSinglyLinkedList<T>::forEach(Func func) {
+    ReadGuard guard(*this);
+    for (CNode* curr = head.next.load(std::memory_order_acquire); curr != nullptr;
+         curr = curr->next.load(std::memory_order_acquire)) {
+        func(static_cast<const T&>(curr->data));
+    }
+}
+
+// Reclaim what can be reclaimed now
+template <typename T>
+size_t ConcurrentSinglyLinkedList<T>::collectGarbage() {
+    std::lock_guard<std::mutex> lock(retire_mutex);
+    reclaim();
+    return retired.size();
+}
+
+#endif // CONCURRENT_LINKED_LIST_CPP
@@ -0,0 +1,114 @@
+#ifndef CONCURRENT_LINKED_LIST_H
+#define CONCURRENT_LINKED_LIST_H
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace concurrent_list_detail {
+
+// Threads that may touch concurrent lists at the same time
+constexpr size_t kMaxThreads = 256;
+
+// Process-wide reader slot of the calling thread (claimed on first use,
+// released when the thread exits)
+inline size_t threadSlot();
+
+}  // namespace concurrent_list_detail
+
+// ConcurrentSinglyLinkedList class template
+//
+// Thread-safe SinglyLinkedList variant for lists shared between tasks:
+// - writers (insertAtEnd, remove, deleteFromBeginning, ...) use per-node
+//   locks with lock coupling (hand-over-hand), so writers touching
+//   different parts of the list proceed in parallel
+// - readers (search, forEach) take no locks at all: they follow atomic
+//   next pointers inside an epoch-protected section, and unlinked nodes
+//   are only freed once every reader that might still see them has left
+//
+// Unlinking never rewrites the removed node's own next pointer, so a
+// reader standing on it simply continues into the live list.
+// Positional access is not offered: positions are meaningless while
+// other threads insert and delete. T must be default constructible (for
+// the head sentinel). Each list carries kMaxThreads reader slots (16 KB).
+template <typename T>
+class ConcurrentSinglyLinkedList {
+private:
+    struct CNode {
+        T data;
+        std::atomic<CNode*> next;
+        std::mutex lock;
+
+        CNode() : data(), next(nullptr) {}
+        explicit CNode(const T& value) : data(value), next(nullptr) {}
+    };
+
+    struct Retired {
+        CNode* node;
+        uint64_t epoch;
+    };
+
+    static constexpr uint64_t kIdle = UINT64_MAX;
+    static constexpr size_t kReclaimBatch = 64;
+
+    // Per-thread reader announcements, indexed by a process-wide slot
+    struct alignas(64) ReaderSlot {
+        std::atomic<uint64_t> epoch{kIdle};
+    };
+
+    CNode head;                          // Sentinel, never removed
+    std::atomic<int> size;
+    std::atomic<uint64_t> global_epoch;
+    std::vector<ReaderSlot> reader_slots;
+    std::mutex retire_mutex;
+    std::vector<Retired> retired;
+
+    // RAII epoch section for lock-free readers
+    class ReadGuard {
+    private:
+        std::atomic<uint64_t>& slot;
+        uint64_t previous;
+
+    public:
+        explicit ReadGuard(ConcurrentSinglyLinkedList& list);
+        ~ReadGuard();
+    };
+
+    void retire(CNode* node);
+    void reclaim();
+    void unlinkAfter(CNode* pred, CNode* curr);
+
+public:
+    // Constructor
+    ConcurrentSinglyLinkedList();
+
+    ConcurrentSinglyLinkedList(const ConcurrentSinglyLinkedList&) = delete;
+    ConcurrentSinglyLinkedList& operator=(const ConcurrentSinglyLinkedList&) = delete;
+
+    // Destructor (no other thread may use the list any more)
+    ~ConcurrentSinglyLinkedList();
+
+    bool isEmpty() const;
+    int getSize() const;
+
+    // Writers (lock coupling)
+    void insertAtBeginning(const T& value);
+    void insertAtEnd(const T& value);
+    bool deleteFromBeginning();
+    bool remove(const T& value);
+
+    // Readers (lock-free, never block)
+    bool search(const T& value);
+    template <typename Func>
+    void forEach(Func func);
+
+    // Free retired nodes no reader can still reach; returns how many remain
+    size_t collectGarbage();
+};
+
+// Include the implementation
+#include "concurrent_linked_list.cpp"
+
+#endif // CONCURRENT_LINKED_LIST_H
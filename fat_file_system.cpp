@@ -5,82 +5,396 @@
 #include <algorithm>
 #include <iomanip>
 #include <cstring>
+#include <cstdint>
+#include <cassert>
+#include <string_view>
 
 using namespace std;
 
+// Records an event unless its level is compiled out (arguments are then
+// not evaluated)
+#define FS_LOG(level, event, ...)                                                   \
+    do {                                                                            \
+        if constexpr (fs_log::enabled(fs_log::Level::level)) {                      \
+            log_ring.record(fs_log::Level::level, fs_log::Event::event, __VA_ARGS__); \
+        }                                                                           \
+    } while (0)
+
+// Times the enclosing public operation into its latency histogram,
+// counts its heap allocations and work and, in tracing builds, records a
+// trace span named after the operation
+#if FAT_FS_STATS
+#define FS_OPERATION_STATS(op)                                                                   \
+    ScopedLatency operation_latency(op_latency[static_cast<size_t>(FsOperation::op)]);           \
+    ScopedAllocations operation_allocations(op_allocations[static_cast<size_t>(FsOperation::op)]); \
+    ScopedWork operation_work(op_work[static_cast<size_t>(FsOperation::op)])
+#else
+#define FS_OPERATION_STATS(op) ((void)0)
+#endif
+
+// Appends the call to the workload recording, if one is running; calls
+// nested inside another public call are skipped
+#define FS_RECORD(op, ...)                                    \
+    WorkloadRecorder::Scope record_scope(recorder.get());     \
+    if (record_scope.outermost()) {                           \
+        recorder->record(FsOperation::op, __VA_ARGS__);       \
+    }
+
+#define FS_TIME_OPERATION(op) \
+    FS_OPERATION_STATS(op);    \
+    FS_TRACE_SPAN(fsOperationName(FsOperation::op), "fs")
+
+const char* fsOperationName(FsOperation operation) {
+    static const char* const names[] = {
+        "createFile", "deleteFile", "copyFile", "createDirectory", "deleteDirectory",
+        "listDirectory", "openFile", "closeFile", "readFile", "writeFile", "seekFile",
+        "syncFile", "syncAll", "findFile", "fileExists", "isDirectory", "getFileSystemInfo",
+    };
+    static_assert(sizeof(names) / sizeof(names[0]) == kFsOperationCount,
+                  "every FsOperation needs a name");
+    return names[static_cast<size_t>(operation)];
+}
+
+bool fsOperationAllocationFree(FsOperation operation) {
+    switch (operation) {
+        case FsOperation::CloseFile:
+        case FsOperation::SeekFile:
+        case FsOperation::FindFile:
+        case FsOperation::FileExists:
+        case FsOperation::IsDirectory:
+        case FsOperation::GetFileSystemInfo:
+            return true;
+        default:
+            return false;
+    }
+}
+
 // ============================================
 // IMPLEMENTATION
 // ============================================
 
 FATFileSystem::FATFileSystem(size_t disk_size_kb, size_t cluster_size_bytes, 
-                           const std::string& label)
-    : total_clusters(disk_size_kb * 1024 / cluster_size_bytes),
+                           const std::string& label,
+                           std::shared_ptr<BlockDevice> block_device,
+                           bool mount_existing)
+    : total_clusters(validGeometry(disk_size_kb, cluster_size_bytes)
+                         ? disk_size_kb * 1024 / cluster_size_bytes
+                         : throw invalid_argument("Unsupported volume geometry")),
       cluster_size(cluster_size_bytes),
-      free_clusters(total_clusters),
+      free_clusters(0),
       volume_label(label),
+      file_count(0),
+      directory_count(0),
+      bad_cluster_count(0),
+      directory_dirty(false),
       current_directory(nullptr),
-      next_file_handle(1) {
+      next_file_handle(1),
+      device(block_device),
+      fat_blocks((total_clusters * sizeof(int32_t) + cluster_size_bytes - 1) / cluster_size_bytes),
+      async_workers(4) {
     
-    // Initialize FAT table
-    for (size_t i = 0; i < total_clusters; i++) {
-        fat_table.insertAtEnd(FATCluster(i));
+    // Attach backing storage (RAM unless the caller supplies a device)
+    size_t blocks_needed = fat_blocks + total_clusters;
+    if (!device) {
+        device = make_shared<MemoryBlockDevice>(cluster_size, blocks_needed);
+    } else if (device->getBlockSize() != cluster_size ||
+               device->getBlockCount() < blocks_needed) {
+        throw invalid_argument("Block device does not match volume geometry");
+    }
+    
+    if (mount_existing) {
+        mountVolume();
+    } else {
+        formatVolume();
     }
+    current_directory = &directory.getRef(0);
+    cache = make_shared<BufferCache>(device);
     
-    // Mark first 2 clusters as reserved (like real FAT)
-    if (total_clusters > 0) {
-        FATCluster& cluster0 = fat_table.getRef(0);
-        cluster0.is_bad = true;
-        cluster0.is_allocated = true;
+    FS_LOG(Info, Initialized, volume_label, "", total_clusters,
+           total_clusters * cluster_size / 1024, cluster_size);
+}
+
+FATFileSystem::~FATFileSystem() {
+    // Let queued asynchronous operations finish first
+    async_pool.reset();
+    
+    // Shutdown's own write-back is not part of the recorded workload
+    stopRecording();
+    
+    // Close all open files and write back everything still dirty
+    open_files.clear();
+    syncAll();
+    cache.reset();
+    FS_LOG(Info, Shutdown, "", "");
+}
+
+size_t FATFileSystem::requiredDeviceBlocks(size_t disk_size_kb, size_t cluster_size_bytes) {
+    if (!validGeometry(disk_size_kb, cluster_size_bytes)) {
+        return 0;
+    }
+    size_t clusters = disk_size_kb * 1024 / cluster_size_bytes;
+    size_t fat_bytes = clusters * sizeof(int32_t);
+    return (fat_bytes + cluster_size_bytes - 1) / cluster_size_bytes + clusters;
+}
+
+// ============== ON-DISK VOLUME ==============
+
+namespace {
+
+// Volume header, kept in the otherwise unused data block of reserved
+// cluster 0
+struct VolumeHeader {
+    char magic[8];
+    uint32_t cluster_size;
+    uint32_t total_clusters;
+    uint64_t directory_bytes;     // Length of the directory table in the root chain
+    char label[32];
+};
+
+const char kVolumeMagic[8] = {'R', 'T', 'O', 'S', 'F', 'A', 'T', '1'};
+
+VolumeHeader makeVolumeHeader(size_t cluster_size, size_t total_clusters,
+                              uint64_t directory_bytes, const string& label) {
+    VolumeHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, kVolumeMagic, sizeof(kVolumeMagic));
+    header.cluster_size = static_cast<uint32_t>(cluster_size);
+    header.total_clusters = static_cast<uint32_t>(total_clusters);
+    header.directory_bytes = directory_bytes;
+    memcpy(header.label, label.data(), min(label.size(), sizeof(header.label) - 1));
+    return header;
+}
+
+// Directory table record: name length (u16), name, start cluster (i32),
+// size (u64), create/modify/access times (i64 each), flags (u8)
+enum : uint8_t { kRecordDirectory = 1, kRecordHidden = 2, kRecordReadOnly = 4 };
+
+template <typename Value>
+void appendValue(vector<uint8_t>& out, Value value) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(value));
+}
+
+// Reads the value at `offset` and moves past it; false past the end
+template <typename Value>
+bool takeValue(const vector<uint8_t>& in, size_t& offset, Value& value) {
+    if (in.size() - offset < sizeof(value)) {
+        return false;
+    }
+    memcpy(&value, in.data() + offset, sizeof(value));
+    offset += sizeof(value);
+    return true;
+}
+
+}  // namespace
+
+bool FATFileSystem::validGeometry(size_t disk_size_kb, size_t cluster_size_bytes) {
+    if (cluster_size_bytes < sizeof(VolumeHeader) || cluster_size_bytes > UINT32_MAX ||
+        disk_size_kb > SIZE_MAX / 1024) {
+        return false;
+    }
+    // Clusters 0-1 are reserved and 2 holds the root directory; FAT entries
+    // are 32-bit signed
+    size_t clusters = disk_size_kb * 1024 / cluster_size_bytes;
+    return clusters >= 3 && clusters <= INT32_MAX;
+}
+
+void FATFileSystem::formatVolume() {
+    // Initialize FAT table; the on-disk copy is built alongside
+    vector<uint8_t> fat_region(fat_blocks * cluster_size, 0);
+    for (size_t i = 0; i < total_clusters; i++) {
+        FATCluster cluster(i);
         
-        if (total_clusters > 1) {
-            FATCluster& cluster1 = fat_table.getRef(1);
-            cluster1.is_bad = true;
-            cluster1.is_allocated = true;
+        if (i < 2) {
+            // Mark first 2 clusters as reserved (like real FAT)
+            cluster.is_bad = true;
+            cluster.is_allocated = true;
+            bad_cluster_count++;
+        } else if (i == 2) {
+            // Reserve cluster 2 for root directory
+            cluster.is_allocated = true;
+            cluster.next_cluster = -1;  // EOF for now
+        } else {
+            free_clusters++;
         }
+        
+        int32_t entry = cluster.is_bad ? -3 : cluster.next_cluster;
+        memcpy(fat_region.data() + i * sizeof(int32_t), &entry, sizeof(entry));
+        fat_table.insertAtEnd(cluster);
+    }
+    
+    // FAT region, then the header (an empty directory) right after it
+    vector<uint8_t> header_block(cluster_size, 0);
+    VolumeHeader header = makeVolumeHeader(cluster_size, total_clusters, 0, volume_label);
+    memcpy(header_block.data(), &header, sizeof(header));
+    
+    vector<BlockWrite> batch;
+    for (size_t b = 0; b < fat_blocks; b++) {
+        batch.emplace_back(b, fat_region.data() + b * cluster_size);
     }
+    batch.emplace_back(dataBlock(0), header_block.data());
+    device->writeBlocks(batch);
     
     // Create root directory
-    FileControlBlock root("/", 2, true);
-    directory.insertAtEnd(root);
-    current_directory = &directory.getRef(0);
+    directory.emplaceBack("/", 2, true);
+    directory_count = 1;
+}
+
+void FATFileSystem::mountVolume() {
+    vector<uint8_t> block(cluster_size);
+    if (!device->readBlock(dataBlock(0), block.data())) {
+        throw runtime_error("Cannot read the volume header");
+    }
+    VolumeHeader header;
+    memcpy(&header, block.data(), sizeof(header));
+    if (memcmp(header.magic, kVolumeMagic, sizeof(kVolumeMagic)) != 0 ||
+        header.cluster_size != cluster_size || header.total_clusters != total_clusters) {
+        throw invalid_argument("Device holds no volume of this geometry");
+    }
+    volume_label.assign(header.label, strnlen(header.label, sizeof(header.label)));
     
-    // Reserve cluster 2 for root directory
-    if (total_clusters > 2) {
-        FATCluster& root_cluster = fat_table.getRef(2);
-        root_cluster.is_allocated = true;
-        root_cluster.next_cluster = -1;  // EOF for now
-        free_clusters--;
+    // FAT from its on-disk copy
+    vector<uint8_t> fat_region(fat_blocks * cluster_size);
+    vector<BlockRead> reads;
+    for (size_t b = 0; b < fat_blocks; b++) {
+        reads.emplace_back(b, fat_region.data() + b * cluster_size);
+    }
+    if (!device->readBlocks(reads)) {
+        throw runtime_error("Cannot read the FAT");
+    }
+    for (size_t i = 0; i < total_clusters; i++) {
+        int32_t entry;
+        memcpy(&entry, fat_region.data() + i * sizeof(int32_t), sizeof(entry));
+        FATCluster cluster(i);
+        if (entry == -3) {
+            cluster.is_bad = true;
+            cluster.is_allocated = true;
+            bad_cluster_count++;
+        } else if (entry == -2) {
+            free_clusters++;
+        } else if (entry == -1 || (entry >= 0 && static_cast<size_t>(entry) < total_clusters)) {
+            cluster.is_allocated = true;
+            cluster.next_cluster = entry;
+        } else {
+            throw invalid_argument("Corrupt FAT entry");
+        }
+        fat_table.insertAtEnd(cluster);
+    }
+    
+    // Directory table from the root chain
+    if (!chainTerminates(2)) {
+        throw invalid_argument("Corrupt root directory chain");
+    }
+    vector<int> root_chain = getClusterChain(2);
+    if (header.directory_bytes > root_chain.size() * cluster_size) {
+        throw invalid_argument("Directory table overruns the root directory");
+    }
+    vector<uint8_t> table(root_chain.size() * cluster_size);
+    reads.clear();
+    for (size_t i = 0; i < root_chain.size(); i++) {
+        reads.emplace_back(dataBlock(root_chain[i]), table.data() + i * cluster_size);
+    }
+    if (!device->readBlocks(reads)) {
+        throw runtime_error("Cannot read the directory table");
     }
+    table.resize(header.directory_bytes);
     
-    cout << "FAT File System initialized" << endl;
-    cout << "Total clusters: " << total_clusters 
-         << " (" << (total_clusters * cluster_size / 1024) << " KB)" << endl;
-    cout << "Cluster size: " << cluster_size << " bytes" << endl;
-    cout << "Volume label: " << volume_label << endl;
+    directory.emplaceBack("/", 2, true);
+    directory_count = 1;
+    size_t offset = 0;
+    while (offset < table.size()) {
+        uint16_t name_length;
+        int32_t start;
+        uint64_t size;
+        int64_t times[3];
+        uint8_t flags;
+        if (!takeValue(table, offset, name_length) || table.size() - offset < name_length) {
+            throw invalid_argument("Truncated directory record");
+        }
+        string name(reinterpret_cast<const char*>(table.data() + offset), name_length);
+        offset += name_length;
+        if (!takeValue(table, offset, start) || !takeValue(table, offset, size) ||
+            !takeValue(table, offset, times) || !takeValue(table, offset, flags)) {
+            throw invalid_argument("Truncated directory record");
+        }
+        if (!chainTerminates(start)) {
+            throw invalid_argument("Corrupt cluster chain for " + name);
+        }
+        
+        FileControlBlock fcb(name, start, (flags & kRecordDirectory) != 0);
+        fcb.file_size = size;
+        fcb.create_time = static_cast<time_t>(times[0]);
+        fcb.modify_time = static_cast<time_t>(times[1]);
+        fcb.access_time = static_cast<time_t>(times[2]);
+        fcb.is_hidden = (flags & kRecordHidden) != 0;
+        fcb.is_readonly = (flags & kRecordReadOnly) != 0;
+        if (fcb.is_directory) {
+            directory_count++;
+        } else {
+            file_count++;
+        }
+        directory.insertAtEnd(std::move(fcb));
+    }
 }
 
-FATFileSystem::~FATFileSystem() {
-    // Close all open files
-    for (auto& pair : open_files) {
-        delete pair.second;
+// Rewrites the directory table into the root chain (growing it as needed)
+// and the header that records its length. The root chain never shrinks.
+bool FATFileSystem::storeDirectoryTable() {
+    vector<uint8_t> table;
+    for (auto it = next(directory.begin()); it != directory.end(); ++it) {
+        const FileControlBlock& fcb = *it;
+        uint16_t name_length = static_cast<uint16_t>(min<size_t>(fcb.filename.size(), UINT16_MAX));
+        appendValue(table, name_length);
+        table.insert(table.end(), fcb.filename.begin(), fcb.filename.begin() + name_length);
+        appendValue(table, static_cast<int32_t>(fcb.start_cluster));
+        appendValue(table, static_cast<uint64_t>(fcb.file_size));
+        appendValue(table, static_cast<int64_t>(fcb.create_time));
+        appendValue(table, static_cast<int64_t>(fcb.modify_time));
+        appendValue(table, static_cast<int64_t>(fcb.access_time));
+        appendValue(table, static_cast<uint8_t>((fcb.is_directory ? kRecordDirectory : 0) |
+                                                (fcb.is_hidden ? kRecordHidden : 0) |
+                                                (fcb.is_readonly ? kRecordReadOnly : 0)));
     }
-    open_files.clear();
-    cout << "FAT File System shutdown" << endl;
+    
+    FileControlBlock& root = *directory.begin();
+    size_t clusters = max<size_t>(1, (table.size() + cluster_size - 1) / cluster_size);
+    if (!extendClusterChain(&root, clusters)) {
+        return false;
+    }
+    vector<int> chain = getClusterChain(root.start_cluster);
+    for (size_t offset = 0; offset < table.size(); offset += cluster_size) {
+        size_t chunk = min(cluster_size, table.size() - offset);
+        if (!cache->write(dataBlock(chain[offset / cluster_size]), 0, table.data() + offset, chunk)) {
+            return false;
+        }
+    }
+    
+    VolumeHeader header = makeVolumeHeader(cluster_size, total_clusters, table.size(), volume_label);
+    if (!cache->write(dataBlock(0), 0, &header, sizeof(header))) {
+        return false;
+    }
+    directory_dirty = false;
+    return true;
 }
 
 // ============== HELPER METHODS ==============
 
 int FATFileSystem::findFreeCluster() const {
-    for (int i = 0; i < fat_table.getSize(); i++) {
-        const FATCluster& cluster = fat_table.getConstRef(i);
+    FS_TRACE_SPAN("findFreeCluster", "fat");
+    uint64_t visited = 0;
+    for (const FATCluster& cluster : fat_table) {
+        visited++;
         if (!cluster.is_allocated && !cluster.is_bad && cluster.isFree()) {
-            return i;
+            work_counter::addFatEntries(visited);
+            return cluster.cluster_number;
         }
     }
+    work_counter::addFatEntries(visited);
     return -1;  // No free clusters
 }
 
 vector<int> FATFileSystem::getClusterChain(int start_cluster) const {
+    FS_TRACE_SPAN("getClusterChain", "fat");
     vector<int> chain;
     int current = start_cluster;
     
@@ -92,6 +406,7 @@ vector<int> FATFileSystem::getClusterChain(int start_cluster) const {
         current = cluster.next_cluster;
     }
     
+    work_counter::addFatEntries(chain.size());
     return chain;
 }
 
@@ -102,74 +417,143 @@ void FATFileSystem::freeClusterChain(int start_cluster) {
         FATCluster& cluster = fat_table.getRef(cluster_num);
         cluster.is_allocated = false;
         cluster.next_cluster = -2;  // Mark as free
+        storeFATEntry(cluster);
         free_clusters++;
+        
+        // Data of a freed cluster never needs to reach the device
+        cache->discard(dataBlock(cluster_num));
     }
 }
 
+size_t FATFileSystem::dataBlock(int cluster_num) const {
+    return fat_blocks + cluster_num;
+}
+
+void FATFileSystem::storeFATEntry(const FATCluster& cluster) {
+    // On-disk FAT: one int32 per cluster (-3 bad, -2 free, -1 EOF, else next)
+    int32_t entry = cluster.is_bad ? -3 : cluster.next_cluster;
+    size_t offset = cluster.cluster_number * sizeof(int32_t);
+    work_counter::addFatEntries(1);
+    cache->write(offset / cluster_size, offset % cluster_size, &entry, sizeof(entry));
+}
+
+// True if the chain from start_cluster runs through allocated clusters to
+// an EOF within total_clusters hops (no loops, no free or bad links)
+bool FATFileSystem::chainTerminates(int start_cluster) const {
+    int current = start_cluster;
+    for (size_t hops = 0; hops < total_clusters; hops++) {
+        if (current < 0 || static_cast<size_t>(current) >= total_clusters) {
+            return false;
+        }
+        const FATCluster& cluster = fat_table.getConstRef(current);
+        if (!cluster.is_allocated || cluster.is_bad) {
+            return false;
+        }
+        if (cluster.isEOF()) {
+            return true;
+        }
+        current = cluster.next_cluster;
+    }
+    return false;
+}
+
+bool FATFileSystem::extendClusterChain(FileControlBlock* file, size_t clusters_needed) {
+    vector<int> chain = getClusterChain(file->start_cluster);
+    int tail = chain.back();
+    
+    for (size_t i = chain.size(); i < clusters_needed; i++) {
+        int next_cluster = findFreeCluster();
+        if (next_cluster == -1) {
+            return false;
+        }
+        
+        FATCluster& next = fat_table.getRef(next_cluster);
+        next.is_allocated = true;
+        next.next_cluster = -1;
+        storeFATEntry(next);
+        
+        FATCluster& last = fat_table.getRef(tail);
+        last.next_cluster = next_cluster;
+        storeFATEntry(last);
+        
+        free_clusters--;
+        tail = next_cluster;
+    }
+    return true;
+}
+
 FileControlBlock* FATFileSystem::findFile(const std::string& path) {
+    FS_TIME_OPERATION(FindFile);
     // Basic path-aware lookup: handle leading '/', directory separators, and basename matches.
     // This still uses a flat directory list but allows simple hierarchical-style paths.
 
     // Normalize input path: remove leading '/' and extract the target filename component.
-    std::string normalized_path = path;
-    if (!normalized_path.empty() && (normalized_path[0] == '/' || normalized_path[0] == '\\')) {
-        normalized_path.erase(0, 1);
-    }
-    std::string::size_type sep_pos = normalized_path.find_last_of("/\\");
-    std::string target_name = (sep_pos == std::string::npos)
-                              ? normalized_path
-                              : normalized_path.substr(sep_pos + 1);
+    // Views into the caller's and the FCBs' strings keep the lookup allocation-free.
+    auto strip_root = [](std::string_view name) {
+        if (!name.empty() && (name[0] == '/' || name[0] == '\\')) {
+            name.remove_prefix(1);
+        }
+        return name;
+    };
+    auto base_name = [](std::string_view name) {
+        std::string_view::size_type sep_pos = name.find_last_of("/\\");
+        return (sep_pos == std::string_view::npos) ? name : name.substr(sep_pos + 1);
+    };
 
-    for (int i = 0; i < directory.getSize(); i++) {
-        FileControlBlock& fcb = directory.getRef(i);
+    std::string_view normalized_path = strip_root(path);
+    std::string_view target_name = base_name(normalized_path);
 
+    uint64_t visited = 0;
+    auto it = directory.findIf([&](const FileControlBlock& fcb) {
+        visited++;
         // Normalize stored filename in the same way.
-        std::string fcb_path = fcb.filename;
-        if (!fcb_path.empty() && (fcb_path[0] == '/' || fcb_path[0] == '\\')) {
-            fcb_path.erase(0, 1);
-        }
+        std::string_view fcb_path = strip_root(fcb.filename);
 
         // Prefer exact normalized path match if available.
         if (!normalized_path.empty() && fcb_path == normalized_path) {
-            return &fcb;
+            return true;
         }
 
         // Fallback: compare only the basename (last path component).
-        std::string::size_type fcb_sep_pos = fcb_path.find_last_of("/\\");
-        std::string fcb_name = (fcb_sep_pos == std::string::npos)
-                               ? fcb_path
-                               : fcb_path.substr(fcb_sep_pos + 1);
-        if (!target_name.empty() && fcb_name == target_name) {
-            return &fcb;
-        }
-    }
-    return nullptr;
+        return !target_name.empty() && base_name(fcb_path) == target_name;
+    });
+    work_counter::addListNodes(visited);
+    return (it != directory.end()) ? &*it : nullptr;
 }
 
 // ============== FILE OPERATIONS ==============
 
-bool FATFileSystem::createFile(const std::string& path, size_t initial_size) {
+FsResult<void> FATFileSystem::tryCreateFile(const std::string& path, size_t initial_size) {
+    FS_TIME_OPERATION(CreateFile);
+    lock_guard<recursive_mutex> guard(fs_mutex);
+    FS_RECORD(CreateFile, path, "", initial_size, 0);
     if (fileExists(path)) {
-        cout << "Error: File already exists: " << path << endl;
-        return false;
+        FS_LOG(Warn, FileAlreadyExists, path, "");
+        return FsError::AlreadyExists;
     }
     
     // Calculate clusters needed
     size_t clusters_needed = (initial_size + cluster_size - 1) / cluster_size;
     
     if (clusters_needed > free_clusters) {
-        cout << "Error: Not enough space. Need " << clusters_needed 
-             << " clusters, have " << free_clusters << endl;
-        return false;
+        FS_LOG(Warn, NotEnoughSpace, path, "", clusters_needed, free_clusters);
+        return FsError::NoSpace;
     }
     
     // Allocate first cluster
     int first_cluster = findFreeCluster();
     if (first_cluster == -1) {
-        cout << "Error: No free clusters found" << endl;
-        return false;
+        FS_LOG(Warn, NoFreeCluster, "", "");
+        return FsError::NoSpace;
     }
     
+    // Claim the first cluster before searching for the next one
+    FATCluster& first = fat_table.getRef(first_cluster);
+    first.is_allocated = true;
+    first.next_cluster = -1;
+    storeFATEntry(first);
+    free_clusters--;
+    
     // Create file control block
     FileControlBlock new_file(path, first_cluster, false);
     new_file.file_size = initial_size;
@@ -183,112 +567,124 @@ bool FATFileSystem::createFile(const std::string& path, size_t initial_size) {
         if (next_cluster == -1) {
             // Out of space - free what we allocated
             freeClusterChain(first_cluster);
-            cout << "Error: Out of space during allocation" << endl;
-            return false;
+            FS_LOG(Warn, OutOfSpaceDuringAllocation, path, "");
+            return FsError::NoSpace;
         }
         
         // Link clusters
-        FATCluster& current = fat_table.getRef(current_cluster);
-        current.is_allocated = true;
-        current.next_cluster = next_cluster;
-        
         FATCluster& next = fat_table.getRef(next_cluster);
         next.is_allocated = true;
+        next.next_cluster = -1;
+        storeFATEntry(next);
         
+        FATCluster& current = fat_table.getRef(current_cluster);
+        current.next_cluster = next_cluster;
+        storeFATEntry(current);
+        
+        free_clusters--;
         current_cluster = next_cluster;
         clusters_allocated++;
     }
     
-    // Mark last cluster as EOF
-    if (current_cluster != -1) {
-        FATCluster& last = fat_table.getRef(current_cluster);
-        last.next_cluster = -1;
-    }
-    
-    // Update free clusters count
-    free_clusters -= clusters_allocated;
-    
     // Add to directory
-    directory.insertAtEnd(new_file);
+    directory.insertAtEnd(std::move(new_file));
+    file_count++;
+    directory_dirty = true;
     
-    cout << "Created file: " << path 
-         << " (size: " << initial_size << " bytes, "
-         << "clusters: " << clusters_allocated << ")" << endl;
+    FS_LOG(Info, FileCreated, path, "", initial_size, clusters_allocated);
     
-    return true;
+    return {};
 }
 
-bool FATFileSystem::deleteFile(const std::string& path) {
-    // Find the file and its position in the directory
-    int file_position = -1;
-    FileControlBlock* file = nullptr;
-    
-    for (int i = 0; i < directory.getSize(); i++) {
-        FileControlBlock& fcb = directory.getRef(i);
-        if (fcb.filename == path) {
-            file = &fcb;
-            file_position = i;
-            break;
-        }
+FsResult<void> FATFileSystem::tryDeleteFile(const std::string& path) {
+    FS_TIME_OPERATION(DeleteFile);
+    lock_guard<recursive_mutex> guard(fs_mutex);
+    FS_RECORD(DeleteFile, path, "", 0, 0);
+    // Find the file and the entry preceding it in one pass
+    auto previous = [&]() {
+        FS_TRACE_SPAN("resolvePath", "path");
+        uint64_t visited = 0;
+        auto found = directory.findBeforeIf([&path, &visited](const FileControlBlock& fcb) {
+            visited++;
+            return fcb.filename == path;
+        });
+        work_counter::addListNodes(visited);
+        return found;
+    }();
+    if (previous == directory.end()) {
+        FS_LOG(Warn, FileNotFound, path, "");
+        return FsError::NotFound;
     }
+    FileControlBlock* file = &*next(previous);
     
-    if (!file) {
-        cout << "Error: File not found: " << path << endl;
-        return false;
+    if (file->is_directory) {
+        FS_LOG(Warn, IsADirectory, path, "");
+        return FsError::IsDirectory;
     }
     
-    if (file->is_directory) {
-        cout << "Error: " << path << " is a directory. Use deleteDirectory()" << endl;
-        return false;
+    for (const auto& pair : open_files) {
+        if (pair.second.fcb == file) {
+            FS_LOG(Warn, FileIsOpen, path, "");
+            return FsError::Busy;
+        }
     }
     
     // Free all clusters used by the file
     freeClusterChain(file->start_cluster);
     
     // Remove from directory
-    directory.deleteFromPosition(file_position);
+    directory.erase_after(previous);
+    file_count--;
+    directory_dirty = true;
     
-    cout << "Deleted file: " << path << endl;
-    return true;
+    FS_LOG(Info, FileDeleted, path, "");
+    return {};
 }
 
-bool FATFileSystem::copyFile(const std::string& source, const std::string& dest) {
+FsResult<void> FATFileSystem::tryCopyFile(const std::string& source, const std::string& dest) {
+    FS_TIME_OPERATION(CopyFile);
+    lock_guard<recursive_mutex> guard(fs_mutex);
+    FS_RECORD(CopyFile, source, dest, 0, 0);
     if (!fileExists(source)) {
-        cout << "Error: Source file not found: " << source << endl;
-        return false;
+        FS_LOG(Warn, SourceNotFound, source, "");
+        return FsError::NotFound;
     }
     
     if (fileExists(dest)) {
-        cout << "Error: Destination file already exists: " << dest << endl;
-        return false;
+        FS_LOG(Warn, DestinationExists, dest, "");
+        return FsError::AlreadyExists;
     }
     
     FileControlBlock* source_fcb = findFile(source);
-    if (!source_fcb) return false;
+    if (!source_fcb) return FsError::NotFound;
     
     // Create new file with same size
-    if (!createFile(dest, source_fcb->file_size)) {
-        return false;
+    FsResult<void> created = tryCreateFile(dest, source_fcb->file_size);
+    if (!created) {
+        return created;
     }
     
     // In real implementation, would copy data from clusters
     // For simulation, we just copy metadata
     
-    cout << "Copied file: " << source << " -> " << dest << endl;
-    return true;
+    FS_LOG(Info, FileCopied, source, dest);
+    return {};
 }
 
-bool FATFileSystem::createDirectory(const std::string& path) {
+FsResult<void> FATFileSystem::tryCreateDirectory(const std::string& path) {
+    FS_TIME_OPERATION(CreateDirectory);
+    lock_guard<recursive_mutex> guard(fs_mutex);
+    FS_RECORD(CreateDirectory, path, "", 0, 0);
     if (fileExists(path)) {
-        cout << "Error: Path already exists: " << path << endl;
-        return false;
+        FS_LOG(Warn, PathAlreadyExists, path, "");
+        return FsError::AlreadyExists;
     }
     
     // Allocate a cluster for directory (simplified)
     int dir_cluster = findFreeCluster();
     if (dir_cluster == -1) {
-        cout << "Error: No space for directory" << endl;
-        return false;
+        FS_LOG(Warn, NoSpaceForDirectory, path, "");
+        return FsError::NoSpace;
     }
     
     // Create directory FCB
@@ -298,64 +694,73 @@ bool FATFileSystem::createDirectory(const std::string& path) {
     FATCluster& cluster = fat_table.getRef(dir_cluster);
     cluster.is_allocated = true;
     cluster.next_cluster = -1;
+    storeFATEntry(cluster);
     free_clusters--;
     
     // Add to parent directory
-    directory.insertAtEnd(new_dir);
+    directory.insertAtEnd(std::move(new_dir));
+    directory_count++;
+    directory_dirty = true;
     
-    cout << "Created directory: " << path << endl;
-    return true;
+    FS_LOG(Info, DirectoryCreated, path, "");
+    return {};
 }
 
-bool FATFileSystem::deleteDirectory(const std::string& path) {
-    // Find the directory and its position
-    int dir_position = -1;
-    FileControlBlock* dir = nullptr;
-    
-    for (int i = 0; i < directory.getSize(); i++) {
-        FileControlBlock& fcb = directory.getRef(i);
-        if (fcb.filename == path) {
-            dir = &fcb;
-            dir_position = i;
-            break;
-        }
-    }
-    
-    if (!dir) {
-        cout << "Error: Directory not found: " << path << endl;
-        return false;
+FsResult<void> FATFileSystem::tryDeleteDirectory(const std::string& path) {
+    FS_TIME_OPERATION(DeleteDirectory);
+    lock_guard<recursive_mutex> guard(fs_mutex);
+    FS_RECORD(DeleteDirectory, path, "", 0, 0);
+    // Find the directory and the entry preceding it in one pass
+    auto previous = [&]() {
+        FS_TRACE_SPAN("resolvePath", "path");
+        uint64_t visited = 0;
+        auto found = directory.findBeforeIf([&path, &visited](const FileControlBlock& fcb) {
+            visited++;
+            return fcb.filename == path;
+        });
+        work_counter::addListNodes(visited);
+        return found;
+    }();
+    if (previous == directory.end()) {
+        FS_LOG(Warn, DirectoryNotFound, path, "");
+        return FsError::NotFound;
     }
+    FileControlBlock* dir = &*next(previous);
     
     if (!dir->is_directory) {
-        cout << "Error: " << path << " is not a directory. Use deleteFile()" << endl;
-        return false;
+        FS_LOG(Warn, NotADirectory, path, "");
+        return FsError::NotDirectory;
     }
     
     // Check if directory is empty
     if (!dir->directory_entries.isEmpty()) {
-        cout << "Error: Directory is not empty: " << path << endl;
-        return false;
+        FS_LOG(Warn, DirectoryNotEmpty, path, "");
+        return FsError::DirectoryNotEmpty;
     }
     
     // Free the cluster used by the directory
     freeClusterChain(dir->start_cluster);
     
     // Remove from directory list
-    directory.deleteFromPosition(dir_position);
+    directory.erase_after(previous);
+    directory_count--;
+    directory_dirty = true;
     
-    cout << "Deleted directory: " << path << endl;
-    return true;
+    FS_LOG(Info, DirectoryDeleted, path, "");
+    return {};
 }
 
 vector<DirectoryEntry> FATFileSystem::listDirectory(const std::string& path) {
+    FS_TIME_OPERATION(ListDirectory);
+    lock_guard<recursive_mutex> guard(fs_mutex);
+    FS_RECORD(ListDirectory, path, "", 0, 0);
     vector<DirectoryEntry> entries;
     
     // Add special entries
     entries.push_back(DirectoryEntry(".", current_directory->start_cluster, 0, true));
     
     // List all files/directories
-    for (int i = 0; i < directory.getSize(); i++) {
-        const FileControlBlock& fcb = directory.getConstRef(i);
+    for (const FileControlBlock& fcb : directory) {
         entries.push_back(DirectoryEntry(
             fcb.filename, 
             fcb.start_cluster, 
@@ -363,53 +768,540 @@ vector<DirectoryEntry> FATFileSystem::listDirectory(const std::string& path) {
             fcb.is_directory
         ));
     }
+    work_counter::addListNodes(directory.getSize());
     
     return entries;
 }
 
+// ============== FILE I/O OPERATIONS ==============
+
+FsResult<int> FATFileSystem::tryOpenFile(const std::string& path, const std::string& mode) {
+    FS_TIME_OPERATION(OpenFile);
+    lock_guard<recursive_mutex> guard(fs_mutex);
+    FS_RECORD(OpenFile, path, mode, 0, next_file_handle);
+    bool writable = mode.find_first_of("wa+") != string::npos;
+    
+    FileControlBlock* file = findFile(path);
+    if (!file && writable) {
+        FsResult<void> created = tryCreateFile(path, 0);
+        if (!created) {
+            return created.error();
+        }
+        file = findFile(path);
+    }
+    
+    if (!file) {
+        FS_LOG(Warn, FileNotFound, path, "");
+        return FsError::NotFound;
+    }
+    
+    if (file->is_directory) {
+        FS_LOG(Warn, IsADirectory, path, "");
+        return FsError::IsDirectory;
+    }
+    
+    if (writable && file->is_readonly) {
+        FS_LOG(Warn, ReadOnly, path, "");
+        return FsError::ReadOnly;
+    }
+    
+    size_t position = (mode.find('a') != string::npos) ? file->file_size : 0;
+    int handle = next_file_handle++;
+    open_files.emplace(handle, OpenFile(file, position, writable));
+    file->updateAccessTime();
+    
+    // Read-only opens are treated as streaming reads of the whole chain
+    if (!writable) {
+        vector<size_t> span;
+        for (int cluster_num : getClusterChain(file->start_cluster)) {
+            span.push_back(dataBlock(cluster_num));
+        }
+        device->adviseAccess(span, AccessHint::Sequential);
+    }
+    return handle;
+}
+
+FsResult<void> FATFileSystem::tryCloseFile(int handle) {
+    FS_TIME_OPERATION(CloseFile);
+    unique_lock<recursive_mutex> lock(fs_mutex);
+    FS_RECORD(CloseFile, "", "", 0, handle);
+    
+    // Let reads and writes still using the handle's cluster chain finish
+    io_idle.wait(lock, [this, handle]() {
+        auto it = open_files.find(handle);
+        return it == open_files.end() || it->second.pending_io == 0;
+    });
+    if (open_files.erase(handle) == 0) {
+        return FsError::BadHandle;
+    }
+    return {};
+}
+
+FsResult<size_t> FATFileSystem::tryReadFile(int handle, void* buffer, size_t bytes) {
+    FS_TIME_OPERATION(ReadFile);
+    unique_lock<recursive_mutex> lock(fs_mutex);
+    FS_RECORD(ReadFile, "", "", bytes, handle);
+    auto it = open_files.find(handle);
+    if (it == open_files.end()) {
+        FS_LOG(Warn, InvalidHandle, "", "", handle);
+        return FsError::BadHandle;
+    }
+    
+    FileControlBlock* file = it->second.fcb;
+    size_t start = it->second.position;
+    if (start >= file->file_size) {
+        return size_t(0);
+    }
+    
+    size_t to_read = min(bytes, file->file_size - start);
+    vector<int> chain = getClusterChain(file->start_cluster);
+    shared_ptr<BufferCache> blocks = cache;
+    
+    // Cache fills may hit the device; let other requests run meanwhile.
+    // The pinned handle keeps the file and its chain alive.
+    it->second.pending_io++;
+    lock.unlock();
+    
+    // Fetch every cluster the request spans in one device batch
+    vector<size_t> span;
+    size_t last_index = min(chain.size(), (start + to_read + cluster_size - 1) / cluster_size);
+    for (size_t index = start / cluster_size; index < last_index; index++) {
+        span.push_back(dataBlock(chain[index]));
+    }
+    blocks->prefetch(span);
+    
+    uint8_t* out = static_cast<uint8_t*>(buffer);
+    size_t done = 0;
+    
+    while (done < to_read) {
+        size_t pos = start + done;
+        size_t index = pos / cluster_size;
+        size_t offset = pos % cluster_size;
+        size_t chunk = min(cluster_size - offset, to_read - done);
+        
+        if (index >= chain.size() ||
+            !blocks->read(dataBlock(chain[index]), offset, out + done, chunk)) {
+            break;
+        }
+        done += chunk;
+    }
+    
+    lock.lock();
+    it->second.position = start + done;
+    file->updateAccessTime();
+    if (--it->second.pending_io == 0) {
+        io_idle.notify_all();
+    }
+    if (done == 0 && to_read > 0) {
+        return FsError::IoError;     // The device failed before any byte arrived
+    }
+    return done;
+}
+
+FsResult<size_t> FATFileSystem::tryWriteFile(int handle, const void* data, size_t bytes) {
+    FS_TIME_OPERATION(WriteFile);
+    unique_lock<recursive_mutex> lock(fs_mutex);
+    FS_RECORD(WriteFile, "", "", bytes, handle);
+    auto it = open_files.find(handle);
+    if (it == open_files.end()) {
+        FS_LOG(Warn, InvalidHandle, "", "", handle);
+        return FsError::BadHandle;
+    }
+    
+    FileControlBlock* file = it->second.fcb;
+    if (!it->second.writable) {
+        FS_LOG(Warn, NotOpenForWriting, file->filename, "");
+        return FsError::NotWritable;
+    }
+    
+    // Grow the cluster chain to cover the write (short write when full)
+    size_t start = it->second.position;
+    size_t end = start + bytes;
+    size_t clusters_needed = max<size_t>(1, (end + cluster_size - 1) / cluster_size);
+    bool extended = extendClusterChain(file, clusters_needed);
+    
+    vector<int> chain = getClusterChain(file->start_cluster);
+    shared_ptr<BufferCache> blocks = cache;
+    
+    // Partial-cluster writes may need a cache fill from the device.
+    // The pinned handle keeps the chain from being freed and reused.
+    it->second.pending_io++;
+    lock.unlock();
+    const uint8_t* in = static_cast<const uint8_t*>(data);
+    size_t done = 0;
+    
+    while (done < bytes) {
+        size_t pos = start + done;
+        size_t index = pos / cluster_size;
+        size_t offset = pos % cluster_size;
+        size_t chunk = min(cluster_size - offset, bytes - done);
+        
+        if (index >= chain.size() ||
+            !blocks->write(dataBlock(chain[index]), offset, in + done, chunk)) {
+            break;
+        }
+        done += chunk;
+    }
+    
+    // closeFile waits for pending_io, so the handle is still there
+    lock.lock();
+    it->second.position = start + done;
+    if (start + done > file->file_size) {
+        file->file_size = start + done;
+    }
+    file->updateModifyTime();
+    directory_dirty = true;
+    if (--it->second.pending_io == 0) {
+        io_idle.notify_all();
+    }
+    if (done == 0 && bytes > 0) {
+        return extended ? FsError::IoError : FsError::NoSpace;
+    }
+    return done;
+}
+
+FsResult<void> FATFileSystem::trySeekFile(int handle, size_t position) {
+    FS_TIME_OPERATION(SeekFile);
+    lock_guard<recursive_mutex> guard(fs_mutex);
+    FS_RECORD(SeekFile, "", "", position, handle);
+    auto it = open_files.find(handle);
+    if (it == open_files.end()) {
+        return FsError::BadHandle;
+    }
+    if (position > it->second.fcb->file_size) {
+        return FsError::InvalidArgument;
+    }
+    it->second.position = position;
+    return {};
+}
+
+// ============== WRITE-BACK CACHE ==============
+
+FsResult<void> FATFileSystem::trySyncFile(int handle) {
+    FS_TIME_OPERATION(SyncFile);
+    lock_guard<recursive_mutex> guard(fs_mutex);
+    FS_RECORD(SyncFile, "", "", 0, handle);
+    auto it = open_files.find(handle);
+    if (it == open_files.end()) {
+        return FsError::BadHandle;
+    }
+    
+    // The file's entry (its size, or the entry itself if new) lives in the
+    // directory table, which is stored whole like syncAll() does
+    if (directory_dirty && !storeDirectoryTable()) {
+        return FsError::NoSpace;     // The root directory could not grow
+    }
+    
+    // The file's data clusters, the FAT region, the header and the
+    // directory table, in block order
+    vector<size_t> blocks;
+    for (size_t b = 0; b < fat_blocks; b++) {
+        blocks.push_back(b);
+    }
+    blocks.push_back(dataBlock(0));
+    for (int cluster_num : getClusterChain(directory.begin()->start_cluster)) {
+        blocks.push_back(dataBlock(cluster_num));
+    }
+    for (int cluster_num : getClusterChain(it->second.fcb->start_cluster)) {
+        blocks.push_back(dataBlock(cluster_num));
+    }
+    sort(blocks.begin(), blocks.end());
+    
+    if (!cache->flushBlocks(blocks) || !device->flush()) {
+        return FsError::IoError;
+    }
+    return {};
+}
+
+FsResult<void> FATFileSystem::trySyncAll() {
+    FS_TIME_OPERATION(SyncAll);
+    lock_guard<recursive_mutex> guard(fs_mutex);
+    FS_RECORD(SyncAll, "", "", 0, 0);
+    if (directory_dirty && !storeDirectoryTable()) {
+        return FsError::NoSpace;     // The root directory could not grow
+    }
+    if (!cache->flushAll() || !device->flush()) {
+        return FsError::IoError;
+    }
+    return {};
+}
+
+void FATFileSystem::setWriteBackPolicy(const WriteBackPolicy& policy) {
+    lock_guard<recursive_mutex> guard(fs_mutex);
+    // Tearing down the old cache writes back everything it holds
+    cache.reset();
+    cache = make_shared<BufferCache>(device, policy);
+}
+
+size_t FATFileSystem::getDirtyClusterCount() const {
+    lock_guard<recursive_mutex> guard(fs_mutex);
+    return cache->getDirtyCount();
+}
+
+// ============== ASYNCHRONOUS I/O ==============
+
+IoThreadPool& FATFileSystem::asyncPool() {
+    lock_guard<recursive_mutex> guard(fs_mutex);
+    if (!async_pool) {
+        async_pool = make_unique<IoThreadPool>(async_workers);
+    }
+    return *async_pool;
+}
+
+void FATFileSystem::setAsyncWorkers(size_t workers) {
+    unique_ptr<IoThreadPool> retired;
+    {
+        lock_guard<recursive_mutex> guard(fs_mutex);
+        async_workers = workers;
+        retired = std::move(async_pool);
+    }
+    // Drains outstanding work without holding fs_mutex
+    retired.reset();
+}
+
+void FATFileSystem::readAsync(int handle, void* buffer, size_t bytes,
+                              function<void(size_t)> on_complete) {
+    asyncPool().submit([this, handle, buffer, bytes, on_complete]() {
+        on_complete(readFile(handle, buffer, bytes));
+    });
+}
+
+void FATFileSystem::writeAsync(int handle, const void* data, size_t bytes,
+                               function<void(size_t)> on_complete) {
+    asyncPool().submit([this, handle, data, bytes, on_complete]() {
+        on_complete(writeFile(handle, data, bytes));
+    });
+}
+
+void FATFileSystem::createFileAsync(const std::string& path, size_t initial_size,
+                                    function<void(bool)> on_complete) {
+    asyncPool().submit([this, path, initial_size, on_complete]() {
+        on_complete(createFile(path, initial_size));
+    });
+}
+
+future<size_t> FATFileSystem::readAsync(int handle, void* buffer, size_t bytes) {
+    auto result = make_shared<promise<size_t>>();
+    readAsync(handle, buffer, bytes, [result](size_t n) { result->set_value(n); });
+    return result->get_future();
+}
+
+future<size_t> FATFileSystem::writeAsync(int handle, const void* data, size_t bytes) {
+    auto result = make_shared<promise<size_t>>();
+    writeAsync(handle, data, bytes, [result](size_t n) { result->set_value(n); });
+    return result->get_future();
+}
+
+future<bool> FATFileSystem::createFileAsync(const std::string& path, size_t initial_size) {
+    auto result = make_shared<promise<bool>>();
+    createFileAsync(path, initial_size, [result](bool ok) { result->set_value(ok); });
+    return result->get_future();
+}
+
+#if defined(__cpp_impl_coroutine)
+FATFileSystem::Awaitable<size_t> FATFileSystem::readAwaitable(int handle, void* buffer, size_t bytes) {
+    return Awaitable<size_t>([this, handle, buffer, bytes](function<void(size_t)> done) {
+        readAsync(handle, buffer, bytes, std::move(done));
+    });
+}
+
+FATFileSystem::Awaitable<size_t> FATFileSystem::writeAwaitable(int handle, const void* data, size_t bytes) {
+    return Awaitable<size_t>([this, handle, data, bytes](function<void(size_t)> done) {
+        writeAsync(handle, data, bytes, std::move(done));
+    });
+}
+
+FATFileSystem::Awaitable<bool> FATFileSystem::createFileAwaitable(const std::string& path,
+                                                                   size_t initial_size) {
+    return Awaitable<bool>([this, path, initial_size](function<void(bool)> done) {
+        createFileAsync(path, initial_size, std::move(done));
+    });
+}
+#endif
+
 // ============== FILE SYSTEM INFO ==============
 
 FATFileSystem::FSInfo FATFileSystem::getFileSystemInfo() const {
+    FS_TIME_OPERATION(GetFileSystemInfo);
+    lock_guard<recursive_mutex> guard(fs_mutex);
+    FS_RECORD(GetFileSystemInfo, "", "", 0, 0);
     FSInfo info;
     
     info.total_space = total_clusters * cluster_size;
     info.free_space = free_clusters * cluster_size;
     info.used_space = info.total_space - info.free_space;
+    info.total_files = file_count;
+    info.total_directories = directory_count;
+    info.bad_clusters = bad_cluster_count;
     
-    // Count files and directories
-    info.total_files = 0;
-    info.total_directories = 0;
+#ifndef NDEBUG
+    FSInfo scanned = scanFileSystemInfo();
+    assert(scanned.free_space == info.free_space);
+    assert(scanned.total_files == info.total_files);
+    assert(scanned.total_directories == info.total_directories);
+    assert(scanned.bad_clusters == info.bad_clusters);
+#endif
     
-    for (int i = 0; i < directory.getSize(); i++) {
-        const FileControlBlock& fcb = directory.getConstRef(i);
-        if (fcb.is_directory) {
-            info.total_directories++;
-        } else {
-            info.total_files++;
-        }
-    }
+    return info;
+}
+
+FATFileSystem::FSInfo FATFileSystem::scanFileSystemInfo() const {
+    lock_guard<recursive_mutex> guard(fs_mutex);
+    FSInfo info;
     
-    // Count bad clusters
+    info.total_space = total_clusters * cluster_size;
+    
+    // Count files and directories
+    info.total_directories = directory.countIf([](const FileControlBlock& fcb) {
+        return fcb.is_directory;
+    });
+    info.total_files = directory.getSize() - info.total_directories;
+    
+    // Count free and bad clusters
+    size_t free_count = 0;
     info.bad_clusters = 0;
-    for (int i = 0; i < fat_table.getSize(); i++) {
-        if (fat_table.getConstRef(i).is_bad) {
+    for (const FATCluster& cluster : fat_table) {
+        if (cluster.is_bad) {
             info.bad_clusters++;
+        } else if (!cluster.is_allocated) {
+            free_count++;
         }
     }
+    info.free_space = free_count * cluster_size;
+    info.used_space = info.total_space - info.free_space;
     
     return info;
 }
 
 // ============== UTILITY METHODS ==============
 
+// ============== BOOL / SIZE WRAPPERS ==============
+
+bool FATFileSystem::createFile(const std::string& path, size_t initial_size) {
+    return tryCreateFile(path, initial_size).ok();
+}
+
+bool FATFileSystem::deleteFile(const std::string& path) {
+    return tryDeleteFile(path).ok();
+}
+
+bool FATFileSystem::copyFile(const std::string& source, const std::string& dest) {
+    return tryCopyFile(source, dest).ok();
+}
+
+bool FATFileSystem::createDirectory(const std::string& path) {
+    return tryCreateDirectory(path).ok();
+}
+
+bool FATFileSystem::deleteDirectory(const std::string& path) {
+    return tryDeleteDirectory(path).ok();
+}
+
+int FATFileSystem::openFile(const std::string& path, const std::string& mode) {
+    return tryOpenFile(path, mode).valueOr(-1);
+}
+
+bool FATFileSystem::closeFile(int handle) {
+    return tryCloseFile(handle).ok();
+}
+
+size_t FATFileSystem::readFile(int handle, void* buffer, size_t bytes) {
+    return tryReadFile(handle, buffer, bytes).valueOr(0);
+}
+
+size_t FATFileSystem::writeFile(int handle, const void* data, size_t bytes) {
+    return tryWriteFile(handle, data, bytes).valueOr(0);
+}
+
+bool FATFileSystem::seekFile(int handle, size_t position) {
+    return trySeekFile(handle, position).ok();
+}
+
+bool FATFileSystem::syncFile(int handle) {
+    return trySyncFile(handle).ok();
+}
+
+bool FATFileSystem::syncAll() {
+    return trySyncAll().ok();
+}
+
+// ============== LATENCY STATISTICS ==============
+
+vector<FATFileSystem::OperationStats> FATFileSystem::getStats() const {
+    vector<OperationStats> stats;
+    for (size_t i = 0; i < kFsOperationCount; i++) {
+        OperationStats entry;
+        entry.operation = static_cast<FsOperation>(i);
+        entry.name = fsOperationName(entry.operation);
+#if FAT_FS_STATS
+        entry.latency = op_latency[i].snapshot();
+        entry.allocations = op_allocations[i].snapshot();
+        entry.work = op_work[i].snapshot();
+#endif
+        stats.push_back(entry);
+    }
+    return stats;
+}
+
+void FATFileSystem::resetStats() {
+#if FAT_FS_STATS
+    for (LatencyHistogram& histogram : op_latency) {
+        histogram.reset();
+    }
+    for (AllocationCounter& counter : op_allocations) {
+        counter.reset();
+    }
+    for (WorkCounter& counter : op_work) {
+        counter.reset();
+    }
+#endif
+}
+
+// ============== WORKLOAD RECORDING ==============
+
+bool FATFileSystem::startRecording(const std::string& path) {
+    lock_guard<recursive_mutex> guard(fs_mutex);
+    auto created = make_unique<WorkloadRecorder>(path, total_clusters * cluster_size / 1024,
+                                                 cluster_size);
+    if (!created->isOpen()) {
+        return false;
+    }
+    recorder = std::move(created);
+    return true;
+}
+
+void FATFileSystem::stopRecording() {
+    lock_guard<recursive_mutex> guard(fs_mutex);
+    if (recorder) {
+        recorder->flush();
+        recorder.reset();
+    }
+}
+
+// ============== EVENT LOG ==============
+
+vector<fs_log::Record> FATFileSystem::readLog() {
+    return log_ring.read();
+}
+
+size_t FATFileSystem::drainLog(std::ostream& out) {
+    vector<fs_log::Record> records = log_ring.read();
+    for (const fs_log::Record& record : records) {
+        out << record.message() << '\n';
+    }
+    out.flush();
+    return records.size();
+}
+
 void FATFileSystem::displayFAT() const {
+    lock_guard<recursive_mutex> guard(fs_mutex);
     cout << "\n=== FAT Table (first 20 entries) ===" << endl;
     cout << "Cluster | Status    | Next" << endl;
     cout << "--------|-----------|------" << endl;
     
-    int limit = min(20, fat_table.getSize());
-    for (int i = 0; i < limit; i++) {
-        const FATCluster& cluster = fat_table.getConstRef(i);
+    int i = 0;
+    for (auto it = fat_table.begin(); it != fat_table.end() && i < 20; ++it, ++i) {
+        const FATCluster& cluster = *it;
         
         string status;
         if (cluster.is_bad) {
@@ -438,11 +1330,10 @@ void FATFileSystem::displayFAT() const {
 }
 
 void FATFileSystem::displayDirectoryTree() const {
+    lock_guard<recursive_mutex> guard(fs_mutex);
     cout << "\n=== Directory Tree ===" << endl;
     
-    for (int i = 0; i < directory.getSize(); i++) {
-        const FileControlBlock& fcb = directory.getConstRef(i);
-        
+    for (const FileControlBlock& fcb : directory) {
         string type = fcb.is_directory ? "<DIR>" : "FILE";
         string size = fcb.is_directory ? "" : to_string(fcb.file_size) + " bytes";
         
@@ -453,17 +1344,22 @@ void FATFileSystem::displayDirectoryTree() const {
 }
 
 bool FATFileSystem::fileExists(const std::string& path) const {
-    for (int i = 0; i < directory.getSize(); i++) {
-        if (directory.getConstRef(i).filename == path) {
-            return true;
-        }
-    }
-    return false;
+    FS_TIME_OPERATION(FileExists);
+    lock_guard<recursive_mutex> guard(fs_mutex);
+    FS_RECORD(FileExists, path, "", 0, 0);
+    uint64_t visited = 0;
+    bool found = directory.findIf([&path, &visited](const FileControlBlock& fcb) {
+        visited++;
+        return fcb.filename == path;
+    }) != directory.end();
+    work_counter::addListNodes(visited);
+    return found;
 }
 
 // ============== TESTING HELPERS ==============
 
 void FATFileSystem::createTestStructure() {
+    lock_guard<recursive_mutex> guard(fs_mutex);
     cout << "\n=== Creating Test File Structure ===" << endl;
     
     // Create some directories
@@ -482,6 +1378,7 @@ void FATFileSystem::createTestStructure() {
 }
 
 void FATFileSystem::runIntegrityCheck() const {
+    lock_guard<recursive_mutex> guard(fs_mutex);
     cout << "\n=== File System Integrity Check ===" << endl;
     
     FSInfo info = getFileSystemInfo();
@@ -493,37 +1390,38 @@ void FATFileSystem::runIntegrityCheck() const {
     cout << "Directories: " << info.total_directories << endl;
     cout << "Bad clusters: " << info.bad_clusters << endl;
     
-    // Check for orphaned clusters
-    int allocated_count = 0;
-    for (int i = 0; i < fat_table.getSize(); i++) {
-        if (fat_table.getConstRef(i).is_allocated && !fat_table.getConstRef(i).is_bad) {
-            allocated_count++;
-        }
-    }
+    // Recount everything and compare with the running counters
+    FSInfo scanned = scanFileSystemInfo();
+    size_t allocated_count = scanned.used_space / cluster_size - scanned.bad_clusters;
     
     cout << "Allocated clusters: " << allocated_count << endl;
     
-    if (allocated_count == (total_clusters - free_clusters - info.bad_clusters)) {
-        cout << "✓ Integrity check PASSED" << endl;
-    } else {
+    if (scanned.free_space != info.free_space || scanned.bad_clusters != info.bad_clusters) {
         cout << "✗ Integrity check FAILED: Cluster count mismatch!" << endl;
+    } else if (scanned.total_files != info.total_files ||
+               scanned.total_directories != info.total_directories) {
+        cout << "✗ Integrity check FAILED: Directory count mismatch!" << endl;
+    } else {
+        cout << "✓ Integrity check PASSED" << endl;
     }
 }
 
 // Check if a path is a directory
 bool FATFileSystem::isDirectory(const std::string& path) const {
+    FS_TIME_OPERATION(IsDirectory);
+    lock_guard<recursive_mutex> guard(fs_mutex);
+    FS_RECORD(IsDirectory, path, "", 0, 0);
     // Root directory
     if (path == "/" || path.empty()) {
         return true;
     }
     
     // Search in directory list
-    for (int i = 0; i < directory.getSize(); i++) {
-        const FileControlBlock& fcb = directory.getConstRef(i);
-        if (fcb.filename == path && fcb.is_directory) {
-            return true;
-        }
-    }
-    
-    return false;
+    uint64_t visited = 0;
+    bool found = directory.findIf([&path, &visited](const FileControlBlock& fcb) {
+        visited++;
+        return fcb.filename == path && fcb.is_directory;
+    }) != directory.end();
+    work_counter::addListNodes(visited);
+    return found;
 }
\ No newline at end of file
@@ -2,11 +2,32 @@
 #define FAT_FILE_SYSTEM_H
 
 #include "singly_linked_list.h"
+#include "unrolled_linked_list.h"
+#include "block_device.h"
+#include "buffer_cache.h"
+#include "io_thread_pool.h"
+#include "latency_histogram.h"
+#include "alloc_counter.h"
+#include "work_counter.h"
+#include "fs_log.h"
+#include "fs_error.h"
+#include "fs_trace.h"
+#include "workload_trace.h"
 #include <string>
 #include <vector>
 #include <memory>
 #include <ctime>
 #include <map>
+#include <array>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <functional>
+#include <ostream>
+
+#if defined(__cpp_impl_coroutine)
+#include <coroutine>
+#endif
 
 // ============================================
 // FAT-SPECIFIC STRUCTURES
@@ -66,6 +87,48 @@ struct DirectoryEntry {
         : name(n), start_cluster(cluster), size(sz), is_dir(dir) {}
 };
 
+// Open file handle state
+struct OpenFile {
+    FileControlBlock* fcb;
+    size_t position;
+    bool writable;
+    unsigned pending_io;    // readFile/writeFile calls using the chain without fs_mutex
+    
+    OpenFile(FileControlBlock* file, size_t pos, bool write)
+        : fcb(file), position(pos), writable(write), pending_io(0) {}
+};
+
+// Public operations with their own latency histogram
+enum class FsOperation : uint8_t {
+    CreateFile,
+    DeleteFile,
+    CopyFile,
+    CreateDirectory,
+    DeleteDirectory,
+    ListDirectory,
+    OpenFile,
+    CloseFile,
+    ReadFile,
+    WriteFile,
+    SeekFile,
+    SyncFile,
+    SyncAll,
+    FindFile,          // Path lookup shared by most operations
+    FileExists,
+    IsDirectory,
+    GetFileSystemInfo,
+    Count
+};
+
+constexpr size_t kFsOperationCount = static_cast<size_t>(FsOperation::Count);
+
+const char* fsOperationName(FsOperation operation);
+
+// Operations that must not touch the heap once the volume is mounted and
+// the file is open (checked by the test suite when the allocation hook
+// is linked in)
+bool fsOperationAllocationFree(FsOperation operation);
+
 // ============================================
 // FAT FILE SYSTEM CLASS
 // ============================================
@@ -73,8 +136,8 @@ struct DirectoryEntry {
 class FATFileSystem {
 private:
     // Core FAT structures using your SinglyLinkedList
-    SinglyLinkedList<FATCluster> fat_table;      // FAT chain
-    SinglyLinkedList<FileControlBlock> directory; // Root directory
+    UnrolledLinkedList<FATCluster> fat_table;    // FAT chain (indexed by cluster)
+    PooledSinglyLinkedList<FileControlBlock> directory; // Root directory (guarded by fs_mutex)
     
     // File system parameters
     size_t total_clusters;
@@ -82,13 +145,53 @@ private:
     size_t free_clusters;
     std::string volume_label;
     
+    // Running totals behind getFileSystemInfo() (the root counts as a directory)
+    size_t file_count;
+    size_t directory_count;
+    size_t bad_cluster_count;
+    
+    // Set when an entry's name, size, cluster or attributes change, so
+    // syncAll() only rewrites the directory table and header when needed.
+    // Access times alone do not dirty it; they ride along with the next rewrite.
+    bool directory_dirty;
+    
     // Current working directory
     FileControlBlock* current_directory;
     
     // File handles for open files
-    std::map<int, FileControlBlock*> open_files;
+    std::map<int, OpenFile> open_files;
     int next_file_handle;
     
+    // Backing storage: blocks [0, fat_blocks) hold the on-disk FAT,
+    // cluster N lives in block fat_blocks + N
+    std::shared_ptr<BlockDevice> device;
+    std::shared_ptr<BufferCache> cache;
+    size_t fat_blocks;
+    
+    // Every public operation holds fs_mutex; readFile/writeFile drop it
+    // around buffer cache I/O so concurrent requests overlap on the device.
+    // Meanwhile they pin their handle (OpenFile::pending_io): closeFile
+    // waits on io_idle, so the file cannot be deleted under the I/O.
+    mutable std::recursive_mutex fs_mutex;
+    std::condition_variable_any io_idle;
+    
+    // Workers for the asynchronous API (created on first use)
+    std::unique_ptr<IoThreadPool> async_pool;
+    size_t async_workers;
+    
+    // Workload recording (null unless startRecording() succeeded)
+    std::unique_ptr<WorkloadRecorder> recorder;
+    
+    // Event log (nothing is printed; readers drain it)
+    fs_log::LogRing log_ring;
+    
+#if FAT_FS_STATS
+    // Per-operation latency, heap use and work, recorded without taking fs_mutex
+    mutable std::array<LatencyHistogram, kFsOperationCount> op_latency;
+    mutable std::array<AllocationCounter, kFsOperationCount> op_allocations;
+    mutable std::array<WorkCounter, kFsOperationCount> op_work;
+#endif
+    
     // Helper methods
     int findFreeCluster() const;
     std::vector<int> getClusterChain(int start_cluster) const;
@@ -97,6 +200,19 @@ private:
     std::string getParentDirectory(const std::string& path) const;
     std::string getFilename(const std::string& path) const;
     
+    // Block device helpers
+    size_t dataBlock(int cluster_num) const;
+    void storeFATEntry(const FATCluster& cluster);
+    bool extendClusterChain(FileControlBlock* file, size_t clusters_needed);
+    bool chainTerminates(int start_cluster) const;
+    IoThreadPool& asyncPool();
+    
+    // On-disk volume: a header in the data block of reserved cluster 0 and
+    // the directory table in the root directory's cluster chain
+    void formatVolume();
+    void mountVolume();
+    bool storeDirectoryTable();
+    
     // Directory operations
     bool addToDirectory(FileControlBlock* parent, const FileControlBlock& entry);
     bool removeFromDirectory(FileControlBlock* parent, const std::string& filename);
@@ -104,10 +220,26 @@ private:
 public:
     // ============== CONSTRUCTOR & DESTRUCTOR ==============
     
+    // Formats the device, unless `mount_existing` is set: then the volume a
+    // previous FATFileSystem left on it (directory written by syncAll() or
+    // the destructor) is mounted as is, label included. Mounting throws
+    // std::invalid_argument if the device holds no sound volume of this
+    // geometry, std::runtime_error if it cannot be read. A geometry that
+    // fails validGeometry() throws std::invalid_argument either way.
     FATFileSystem(size_t disk_size_kb = 1024, size_t cluster_size_bytes = 1024,
-                  const std::string& label = "RTOS_FS");
+                  const std::string& label = "RTOS_FS",
+                  std::shared_ptr<BlockDevice> block_device = nullptr,
+                  bool mount_existing = false);
     ~FATFileSystem();
     
+    // Blocks a caller-supplied device needs for this geometry (FAT region +
+    // clusters); 0 if the geometry is not valid
+    static size_t requiredDeviceBlocks(size_t disk_size_kb, size_t cluster_size_bytes);
+    
+    // Whether the constructor accepts this geometry: clusters large enough
+    // for the volume header, and room for the reserved and root clusters
+    static bool validGeometry(size_t disk_size_kb, size_t cluster_size_bytes);
+    
     // ============== FILE SYSTEM OPERATIONS ==============
     
     bool format();
@@ -129,12 +261,84 @@ public:
     size_t writeFile(int handle, const void* data, size_t bytes);
     bool seekFile(int handle, size_t position);
     
+    // Same operations reporting why they failed. The bool/int/size_t
+    // versions above are thin wrappers (false, -1 or 0 on any error).
+    FsResult<void> tryCreateFile(const std::string& path, size_t initial_size = 0);
+    FsResult<void> tryDeleteFile(const std::string& path);
+    FsResult<void> tryCopyFile(const std::string& source, const std::string& dest);
+    FsResult<int> tryOpenFile(const std::string& path, const std::string& mode = "r");
+    FsResult<void> tryCloseFile(int handle);
+    FsResult<size_t> tryReadFile(int handle, void* buffer, size_t bytes);   // 0 at end of file
+    FsResult<size_t> tryWriteFile(int handle, const void* data, size_t bytes);
+    FsResult<void> trySeekFile(int handle, size_t position);
+    
+    // ============== WRITE-BACK CACHE ==============
+    
+    // writeFile() returns once data is in the buffer cache; these give durability
+    bool syncFile(int handle);
+    bool syncAll();
+    FsResult<void> trySyncFile(int handle);
+    FsResult<void> trySyncAll();
+    void setWriteBackPolicy(const WriteBackPolicy& policy);
+    size_t getDirtyClusterCount() const;
+    
+    // ============== ASYNCHRONOUS I/O ==============
+    
+    // Operations run on a worker pool. Requests on different handles proceed
+    // concurrently; requests sharing a handle are not ordered. Callbacks run
+    // on a worker thread.
+    void setAsyncWorkers(size_t workers);
+    
+    std::future<size_t> readAsync(int handle, void* buffer, size_t bytes);
+    std::future<size_t> writeAsync(int handle, const void* data, size_t bytes);
+    std::future<bool> createFileAsync(const std::string& path, size_t initial_size = 0);
+    
+    void readAsync(int handle, void* buffer, size_t bytes,
+                   std::function<void(size_t)> on_complete);
+    void writeAsync(int handle, const void* data, size_t bytes,
+                    std::function<void(size_t)> on_complete);
+    void createFileAsync(const std::string& path, size_t initial_size,
+                         std::function<void(bool)> on_complete);
+    
+#if defined(__cpp_impl_coroutine)
+    // co_await-able wrapper around a callback-style async operation;
+    // the awaiting coroutine resumes on the worker that completed it
+    template <typename Result>
+    class Awaitable {
+    private:
+        std::function<void(std::function<void(Result)>)> start;
+        Result result{};
+        
+    public:
+        explicit Awaitable(std::function<void(std::function<void(Result)>)> starter)
+            : start(std::move(starter)) {}
+        
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> waiter) {
+            // The callback may resume (and finish) the coroutine, freeing
+            // this awaitable, before `start` returns; call a local copy
+            auto starter = std::move(start);
+            starter([this, waiter](Result r) {
+                result = r;
+                waiter.resume();
+            });
+        }
+        Result await_resume() { return result; }
+    };
+    
+    Awaitable<size_t> readAwaitable(int handle, void* buffer, size_t bytes);
+    Awaitable<size_t> writeAwaitable(int handle, const void* data, size_t bytes);
+    Awaitable<bool> createFileAwaitable(const std::string& path, size_t initial_size = 0);
+#endif
+    
     // ============== DIRECTORY OPERATIONS ==============
     
     bool createDirectory(const std::string& path);
     bool deleteDirectory(const std::string& path);
     bool changeDirectory(const std::string& path);
     std::vector<DirectoryEntry> listDirectory(const std::string& path = "");
+    FsResult<void> tryCreateDirectory(const std::string& path);
+    FsResult<void> tryDeleteDirectory(const std::string& path);
     
     // ============== METADATA OPERATIONS ==============
     
@@ -154,8 +358,52 @@ public:
         size_t bad_clusters;
     };
     
+    // O(1): read from counters kept by the allocator and the namespace
+    // operations. Debug builds (no NDEBUG) assert on every call that the
+    // counters agree with scanFileSystemInfo().
     FSInfo getFileSystemInfo() const;
     
+    // The same figures recounted from the directory and the whole FAT
+    FSInfo scanFileSystemInfo() const;
+    
+    // ============== LATENCY STATISTICS ==============
+    
+    // Histograms cover the whole call, including waits for fs_mutex.
+    // Allocations are those made by the calling thread during the call,
+    // and stay 0 unless the executable links the allocation hook (see
+    // alloc_counter.h). Work counts FAT entries, directory nodes and
+    // device blocks the calling thread touched (see work_counter.h).
+    // Nested calls count towards both operations.
+    // Built with FAT_FS_STATS=0 nothing is recorded and every count is 0.
+    struct OperationStats {
+        FsOperation operation;
+        const char* name;
+        LatencyHistogram::Snapshot latency;
+        alloc_counter::Counts allocations;
+        work_counter::Counts work;
+    };
+    
+    // One entry per FsOperation, indexed by the enum value
+    std::vector<OperationStats> getStats() const;
+    void resetStats();
+    
+    // ============== WORKLOAD RECORDING ==============
+    
+    // Append every public call (arguments and timing) to a binary trace
+    // that fat_replay can run against other configurations. Starting
+    // again replaces the current recording.
+    bool startRecording(const std::string& path);
+    void stopRecording();
+    
+    // ============== EVENT LOG ==============
+    
+    // Operations record events (creations, deletions, failures) in a
+    // fixed-size ring instead of printing. These return the events
+    // recorded since the previous read; old events are overwritten when
+    // the ring is full. FAT_FS_LOG_LEVEL selects the levels compiled in.
+    std::vector<fs_log::Record> readLog();
+    size_t drainLog(std::ostream& out);
+    
     // ============== UTILITY METHODS ==============
     
     void displayFAT() const;
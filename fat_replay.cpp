@@ -0,0 +1,186 @@
+#include "fat_file_system.h"
+#include "workload_trace.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <cstdlib>
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+
+using namespace std;
+
+// ============================================
+// WORKLOAD REPLAY
+// ============================================
+//
+// Replays a trace recorded with FATFileSystem::startRecording() (for
+// example `fat_interactive_test session.trace`) against a fresh
+// RAM-backed volume. The volume geometry defaults to the recorded one;
+// override it, or the buffer cache size, to compare configurations on
+// the same access pattern. Calls are issued back to back, or with the
+// recorded inter-arrival times (--timing original).
+//
+// The JSON report gives the replay's wall time and the volume's
+// per-operation latency histograms (these also count calls the file
+// system makes internally, e.g. fileExists inside createFile).
+//
+// Usage: fat_replay TRACE [--volume-kb N] [--cluster-size N] [--cache-blocks N]
+//                         [--timing asap|original] [--speed X] [--output PATH]
+//
+// Counts must be positive integers and --speed a positive number; a
+// geometry FATFileSystem cannot build is refused before replaying.
+
+namespace {
+
+struct Options {
+    string trace_path;
+    size_t volume_kb = 0;           // 0: as recorded
+    size_t cluster_size = 0;
+    size_t cache_blocks = 0;        // 0: default policy
+    ReplayOptions replay;
+    string output;
+};
+
+// A positive decimal count with nothing trailing
+bool parseCount(const string& value, size_t& count) {
+    if (value.empty() || !isdigit(static_cast<unsigned char>(value[0]))) {
+        return false;
+    }
+    char* end = nullptr;
+    errno = 0;
+    unsigned long long parsed = strtoull(value.c_str(), &end, 10);
+    if (*end != '\0' || errno == ERANGE || parsed == 0 || parsed > SIZE_MAX) {
+        return false;
+    }
+    count = static_cast<size_t>(parsed);
+    return true;
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    if (argc < 2) {
+        return false;
+    }
+    options.trace_path = argv[1];
+    for (int i = 2; i + 1 < argc; i += 2) {
+        string arg = argv[i];
+        string value = argv[i + 1];
+        if (arg == "--volume-kb") {
+            if (!parseCount(value, options.volume_kb)) {
+                return false;
+            }
+        } else if (arg == "--cluster-size") {
+            if (!parseCount(value, options.cluster_size)) {
+                return false;
+            }
+        } else if (arg == "--cache-blocks") {
+            if (!parseCount(value, options.cache_blocks)) {
+                return false;
+            }
+        } else if (arg == "--timing") {
+            if (value != "asap" && value != "original") {
+                return false;
+            }
+            options.replay.original_timing = (value == "original");
+        } else if (arg == "--speed") {
+            char* end = nullptr;
+            options.replay.speed = strtod(value.c_str(), &end);
+            if (end == value.c_str() || *end != '\0' || !(options.replay.speed > 0)) {
+                return false;
+            }
+        } else if (arg == "--output") {
+            options.output = value;
+        } else {
+            return false;
+        }
+    }
+    return argc % 2 == 0;
+}
+
+void writeJson(ostream& out, const Options& options, const ReplayResult& result,
+               const vector<FATFileSystem::OperationStats>& stats) {
+    out << "{\n";
+    out << "  \"trace\": \"" << options.trace_path << "\",\n";
+    out << "  \"volume_kb\": " << options.volume_kb << ",\n";
+    out << "  \"cluster_size\": " << options.cluster_size << ",\n";
+    out << "  \"timing\": \"" << (options.replay.original_timing ? "original" : "asap") << "\",\n";
+    out << "  \"calls\": " << result.calls << ",\n";
+    out << "  \"failures\": " << result.failures << ",\n";
+    out << fixed << setprecision(6);
+    out << "  \"seconds\": " << result.seconds << ",\n";
+    out << setprecision(1);
+    out << "  \"calls_per_sec\": " << (result.seconds > 0 ? result.calls / result.seconds : 0.0)
+        << ",\n";
+    out << "  \"operations\": [";
+
+    bool first = true;
+    for (const FATFileSystem::OperationStats& entry : stats) {
+        if (entry.latency.count == 0) {
+            continue;
+        }
+        out << (first ? "\n" : ",\n");
+        first = false;
+        out << "    {\"name\": \"" << entry.name << "\", "
+            << "\"count\": " << entry.latency.count << ", "
+            << "\"p50_ns\": " << entry.latency.percentileNs(0.50) << ", "
+            << "\"p99_ns\": " << entry.latency.percentileNs(0.99) << ", "
+            << "\"max_ns\": " << entry.latency.maxNs() << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        cerr << "Usage: fat_replay TRACE [--volume-kb N] [--cluster-size N] [--cache-blocks N]\n"
+             << "                        [--timing asap|original] [--speed X] [--output PATH]"
+             << endl;
+        return 1;
+    }
+
+    WorkloadTrace trace;
+    if (!trace.load(options.trace_path)) {
+        cerr << "Cannot read trace: " << options.trace_path << endl;
+        return 1;
+    }
+    if (options.volume_kb == 0) {
+        options.volume_kb = trace.volume_kb;
+    }
+    if (options.cluster_size == 0) {
+        options.cluster_size = trace.cluster_size;
+    }
+    if (!FATFileSystem::validGeometry(options.volume_kb, options.cluster_size)) {
+        cerr << "Unsupported volume geometry: --volume-kb " << options.volume_kb
+             << " --cluster-size " << options.cluster_size << endl;
+        return 1;
+    }
+
+    try {
+        FATFileSystem fs(options.volume_kb, options.cluster_size, "REPLAY");
+        if (options.cache_blocks > 0) {
+            WriteBackPolicy policy;
+            policy.cache_blocks = options.cache_blocks;
+            fs.setWriteBackPolicy(policy);
+        }
+
+        ReplayResult result = replayWorkload(fs, trace, options.replay);
+
+        if (options.output.empty()) {
+            writeJson(cout, options, result, fs.getStats());
+        } else {
+            ofstream file(options.output);
+            if (!file) {
+                cerr << "Cannot open output file: " << options.output << endl;
+                return 1;
+            }
+            writeJson(file, options, result, fs.getStats());
+        }
+    } catch (const exception& e) {
+        cerr << "Replay failed: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+#ifndef FS_ERROR_H
+#define FS_ERROR_H
+
+#include <cerrno>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+// Why a file system operation failed. Errors are plain values: nothing
+// is formatted or allocated on a failure path.
+enum class FsError : uint8_t {
+    None = 0,
+    NotFound,            // ENOENT
+    AlreadyExists,       // EEXIST
+    NoSpace,             // ENOSPC
+    IsDirectory,         // EISDIR
+    NotDirectory,        // ENOTDIR
+    DirectoryNotEmpty,   // ENOTEMPTY
+    Busy,                // EBUSY: the file is open
+    ReadOnly,            // EACCES
+    BadHandle,           // EBADF
+    NotWritable,         // EBADF: handle opened read-only
+    InvalidArgument,     // EINVAL
+    IoError              // EIO
+};
+
+inline const char* fsErrorName(FsError error) {
+    switch (error) {
+        case FsError::None: return "none";
+        case FsError::NotFound: return "not found";
+        case FsError::AlreadyExists: return "already exists";
+        case FsError::NoSpace: return "no space";
+        case FsError::IsDirectory: return "is a directory";
+        case FsError::NotDirectory: return "not a directory";
+        case FsError::DirectoryNotEmpty: return "directory not empty";
+        case FsError::Busy: return "file is open";
+        case FsError::ReadOnly: return "read-only";
+        case FsError::BadHandle: return "bad handle";
+        case FsError::NotWritable: return "not open for writing";
+        case FsError::InvalidArgument: return "invalid argument";
+        case FsError::IoError: return "I/O error";
+    }
+    return "unknown";
+}
+
+// Closest POSIX errno value (0 for None)
+inline int toErrno(FsError error) {
+    switch (error) {
+        case FsError::None: return 0;
+        case FsError::NotFound: return ENOENT;
+        case FsError::AlreadyExists: return EEXIST;
+        case FsError::NoSpace: return ENOSPC;
+        case FsError::IsDirectory: return EISDIR;
+        case FsError::NotDirectory: return ENOTDIR;
+        case FsError::DirectoryNotEmpty: return ENOTEMPTY;
+        case FsError::Busy: return EBUSY;
+        case FsError::ReadOnly: return EACCES;
+        case FsError::BadHandle: return EBADF;
+        case FsError::NotWritable: return EBADF;
+        case FsError::InvalidArgument: return EINVAL;
+        case FsError::IoError: return EIO;
+    }
+    return EIO;
+}
+
+// FsResult<T>: a T or an FsError (a minimal std::expected for C++17).
+// Constructed from a T on success and from an FsError on failure;
+// value() on a failed result throws std::logic_error.
+template <typename T>
+class FsResult {
+private:
+    FsError failure;
+    T result;
+
+public:
+    FsResult(const T& value) : failure(FsError::None), result(value) {}
+    FsResult(T&& value) : failure(FsError::None), result(std::move(value)) {}
+    FsResult(FsError error) : failure(error), result() {}
+
+    bool ok() const { return failure == FsError::None; }
+    explicit operator bool() const { return ok(); }
+    FsError error() const { return failure; }
+
+    T& value() {
+        if (!ok()) {
+            throw std::logic_error("FsResult holds an error");
+        }
+        return result;
+    }
+    const T& value() const {
+        if (!ok()) {
+            throw std::logic_error("FsResult holds an error");
+        }
+        return result;
+    }
+    T valueOr(T fallback) const { return ok() ? result : fallback; }
+};
+
+template <>
+class FsResult<void> {
+private:
+    FsError failure;
+
+public:
+    FsResult() : failure(FsError::None) {}
+    FsResult(FsError error) : failure(error) {}
+
+    bool ok() const { return failure == FsError::None; }
+    explicit operator bool() const { return ok(); }
+    FsError error() const { return failure; }
+};
+
+#endif // FS_ERROR_H
@@ -0,0 +1,189 @@
+#include "fs_log.h"
+#include "latency_histogram.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+namespace fs_log {
+
+const char* levelName(Level level) {
+    static const char* const names[] = {"trace", "debug", "info", "warn", "error", "off"};
+    return names[static_cast<size_t>(level)];
+}
+
+const char* eventFormat(Event event) {
+    static const char* const formats[] = {
+        "FAT File System initialized: {0} clusters ({1} KB), cluster size {2} bytes, volume {s}",
+        "FAT File System shutdown",
+        "Created file: {s} (size: {0} bytes, clusters: {1})",
+        "Deleted file: {s}",
+        "Copied file: {s} -> {t}",
+        "Created directory: {s}",
+        "Deleted directory: {s}",
+        "Error: File already exists: {s}",
+        "Error: Path already exists: {s}",
+        "Error: Not enough space for {s}. Need {0} clusters, have {1}",
+        "Error: No free clusters found",
+        "Error: Out of space during allocation: {s}",
+        "Error: No space for directory: {s}",
+        "Error: File not found: {s}",
+        "Error: Directory not found: {s}",
+        "Error: Source file not found: {s}",
+        "Error: Destination file already exists: {s}",
+        "Error: {s} is a directory",
+        "Error: {s} is not a directory",
+        "Error: Directory is not empty: {s}",
+        "Error: File is open: {s}",
+        "Error: File is read-only: {s}",
+        "Error: Invalid file handle: {0}",
+        "Error: File not opened for writing: {s}",
+    };
+    static_assert(sizeof(formats) / sizeof(formats[0]) == static_cast<size_t>(Event::Count),
+                  "every Event needs a format");
+    return formats[static_cast<size_t>(event)];
+}
+
+string Record::message() const {
+    const char* format = eventFormat(event);
+    string out;
+    for (const char* p = format; *p; p++) {
+        if (p[0] == '{' && p[1] && p[2] == '}') {
+            char key = p[1];
+            if (key == 's' || key == 't') {
+                out += text[key == 't'];
+                p += 2;
+                continue;
+            }
+            if (key >= '0' && key <= '2') {
+                out += to_string(args[key - '0']);
+                p += 2;
+                continue;
+            }
+        }
+        out += *p;
+    }
+    return out;
+}
+
+// ============================================
+// LOCK-FREE EVENT RING
+// ============================================
+
+LogRing::LogRing(size_t capacity) {
+    size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    slots.reset(new Slot[size]);
+    mask = size - 1;
+}
+
+// Hash of a record's payload words and index. A writer that lost its
+// slot mid-copy may still store into the newer record; the mix of both
+// copies then fails this check.
+uint64_t LogRing::payloadCheck(const uint64_t* payload, uint64_t index) noexcept {
+    uint64_t hash = (index + 1) * 0x9E3779B97F4A7C15ull;
+    for (size_t i = 0; i + 1 < kPayloadWords; i++) {
+        hash = (hash ^ payload[i]) * 0x100000001B3ull;
+        hash ^= hash >> 29;
+    }
+    return hash;
+}
+
+// Payload layout: timestamp, level/event/text lengths, three arguments,
+// both texts back to back, then the check word
+void LogRing::record(Level level, Event event, const string& a, const string& b,
+                     int64_t x, int64_t y, int64_t z) noexcept {
+    uint64_t payload[kPayloadWords] = {};
+    size_t len_b = min(b.size(), kTextBytes / 2);
+    size_t len_a = min(a.size(), kTextBytes - len_b);
+
+    payload[0] = latency_clock::now();
+    payload[1] = static_cast<uint64_t>(level) |
+                 static_cast<uint64_t>(event) << 8 |
+                 static_cast<uint64_t>(len_a) << 24 |
+                 static_cast<uint64_t>(len_b) << 32;
+    payload[2] = static_cast<uint64_t>(x);
+    payload[3] = static_cast<uint64_t>(y);
+    payload[4] = static_cast<uint64_t>(z);
+    char* text = reinterpret_cast<char*>(&payload[5]);
+    memcpy(text, a.data(), len_a);
+    memcpy(text + len_a, b.data(), len_b);
+
+    uint64_t index = write_index.fetch_add(1, memory_order_relaxed);
+    payload[kPayloadWords - 1] = payloadCheck(payload, index);
+    Slot& slot = slots[index & mask];
+
+    // Claim the slot. Sequences only grow and nobody waits: a writer that
+    // was preempted for a whole lap gives up rather than overwrite a newer
+    // record, and one that laps a writer still copying takes the slot
+    // over from under it (odd sequence or not).
+    uint64_t current = slot.sequence.load(memory_order_relaxed);
+    do {
+        if (current > 2 * index) {
+            return;                      // Superseded; readers count it as dropped
+        }
+    } while (!slot.sequence.compare_exchange_weak(current, 2 * index + 1, memory_order_relaxed));
+
+    atomic_thread_fence(memory_order_release);
+    for (size_t i = 0; i < kPayloadWords; i++) {
+        slot.words[i].store(payload[i], memory_order_relaxed);
+    }
+
+    // Publish unless the slot was taken over meanwhile; then this record
+    // is a counted drop, and the check word catches any of its stores
+    // that landed in the newer record
+    uint64_t claimed = 2 * index + 1;
+    slot.sequence.compare_exchange_strong(claimed, 2 * index + 2, memory_order_release,
+                                          memory_order_relaxed);
+}
+
+vector<Record> LogRing::read() {
+    lock_guard<mutex> guard(reader_mutex);
+    vector<Record> records;
+
+    uint64_t end = write_index.load(memory_order_acquire);
+    if (end - read_index > capacity()) {
+        dropped_count.fetch_add(end - capacity() - read_index, memory_order_relaxed);
+        read_index = end - capacity();
+    }
+
+    for (; read_index < end; read_index++) {
+        const Slot& slot = slots[read_index & mask];
+        uint64_t expected = 2 * read_index + 2;
+        uint64_t before = slot.sequence.load(memory_order_acquire);
+        if (before < expected) {
+            break;                       // Still being written; pick it up next time
+        }
+
+        uint64_t payload[kPayloadWords];
+        for (size_t i = 0; i < kPayloadWords; i++) {
+            payload[i] = slot.words[i].load(memory_order_relaxed);
+        }
+        atomic_thread_fence(memory_order_acquire);
+        if (before != expected || slot.sequence.load(memory_order_relaxed) != expected ||
+            payload[kPayloadWords - 1] != payloadCheck(payload, read_index)) {
+            dropped_count.fetch_add(1, memory_order_relaxed);   // Overwritten or torn
+            continue;
+        }
+
+        Record record;
+        record.sequence = read_index;
+        record.timestamp = payload[0];
+        record.level = static_cast<Level>(payload[1] & 0xFF);
+        record.event = static_cast<Event>((payload[1] >> 8) & 0xFFFF);
+        size_t len_a = min<size_t>((payload[1] >> 24) & 0xFF, kTextBytes);
+        size_t len_b = min<size_t>((payload[1] >> 32) & 0xFF, kTextBytes - len_a);
+        for (size_t i = 0; i < 3; i++) {
+            record.args[i] = static_cast<int64_t>(payload[2 + i]);
+        }
+        const char* text = reinterpret_cast<const char*>(&payload[5]);
+        record.text[0].assign(text, len_a);
+        record.text[1].assign(text + len_a, len_b);
+        records.push_back(move(record));
+    }
+    return records;
+}
+
+}  // namespace fs_log
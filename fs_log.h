@@ -0,0 +1,139 @@
+#ifndef FS_LOG_H
+#define FS_LOG_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Events below this level are compiled out (0 = trace ... 5 = off)
+#ifndef FAT_FS_LOG_LEVEL
+#define FAT_FS_LOG_LEVEL 2
+#endif
+
+namespace fs_log {
+
+enum class Level : uint8_t {
+    Trace = 0,
+    Debug = 1,
+    Info = 2,
+    Warn = 3,
+    Error = 4,
+    Off = 5
+};
+
+constexpr Level kCompiledLevel = static_cast<Level>(FAT_FS_LOG_LEVEL);
+
+constexpr bool enabled(Level level) {
+    return static_cast<uint8_t>(level) >= static_cast<uint8_t>(kCompiledLevel) &&
+           level != Level::Off;
+}
+
+const char* levelName(Level level);
+
+// File system events; each has a fixed message with {s}/{t} (path texts)
+// and {0}..{2} (integer arguments) placeholders
+enum class Event : uint16_t {
+    Initialized,
+    Shutdown,
+    FileCreated,
+    FileDeleted,
+    FileCopied,
+    DirectoryCreated,
+    DirectoryDeleted,
+    FileAlreadyExists,
+    PathAlreadyExists,
+    NotEnoughSpace,
+    NoFreeCluster,
+    OutOfSpaceDuringAllocation,
+    NoSpaceForDirectory,
+    FileNotFound,
+    DirectoryNotFound,
+    SourceNotFound,
+    DestinationExists,
+    IsADirectory,
+    NotADirectory,
+    DirectoryNotEmpty,
+    FileIsOpen,
+    ReadOnly,
+    InvalidHandle,
+    NotOpenForWriting,
+    Count
+};
+
+const char* eventFormat(Event event);
+
+// One decoded event
+struct Record {
+    uint64_t sequence;
+    uint64_t timestamp;          // latency_clock ticks
+    Level level;
+    Event event;
+    int64_t args[3];
+    std::string text[2];
+
+    // The event's message with its placeholders filled in
+    std::string message() const;
+};
+
+// ============================================
+// LOCK-FREE EVENT RING
+// ============================================
+
+// Fixed-size flight recorder of binary events. Writers never allocate
+// and never take a lock: a record is an event ID, three integers and up
+// to 80 bytes of (truncated) path text, stored into a slot claimed with
+// one fetch_add. The oldest events are overwritten when the ring is
+// full. No writer ever waits: one that laps a writer preempted mid-copy
+// takes the slot over, and the slow writer's record is dropped.
+//
+// Each slot carries a sequence word (seqlock) and each record a check
+// word: readers copy a slot and keep it only if the sequence was
+// complete and unchanged around the copy and the check word matches,
+// so a reader racing writers skips (and counts) overwritten events
+// instead of returning torn ones. Formatting happens only in the
+// reader. Readers serialise among themselves.
+class LogRing {
+public:
+    static constexpr size_t kTextBytes = 80;
+
+    explicit LogRing(size_t capacity = 256);   // Rounded up to a power of two
+
+    LogRing(const LogRing&) = delete;
+    LogRing& operator=(const LogRing&) = delete;
+
+    void record(Level level, Event event, const std::string& a, const std::string& b,
+                int64_t x = 0, int64_t y = 0, int64_t z = 0) noexcept;
+
+    // Events recorded since the previous read, oldest first
+    std::vector<Record> read();
+
+    size_t capacity() const { return mask + 1; }
+    uint64_t recorded() const { return write_index.load(std::memory_order_relaxed); }
+    uint64_t dropped() const { return dropped_count.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t kPayloadWords = 5 + kTextBytes / 8 + 1;
+
+    static uint64_t payloadCheck(const uint64_t* payload, uint64_t index) noexcept;
+
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> sequence{0};   // 2i+1 while record i is written, 2i+2 once done
+        std::atomic<uint64_t> words[kPayloadWords];
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    size_t mask;
+    std::atomic<uint64_t> write_index{0};
+
+    std::mutex reader_mutex;
+    uint64_t read_index = 0;
+    std::atomic<uint64_t> dropped_count{0};
+};
+
+}  // namespace fs_log
+
+#endif // FS_LOG_H
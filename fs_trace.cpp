@@ -0,0 +1,162 @@
+#include "fs_trace.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+namespace fs_trace {
+
+namespace {
+
+// Spans a single thread buffer holds before dropping new ones
+const size_t kThreadBufferSpans = 1 << 18;
+
+struct SpanRecord {
+    const char* name;
+    const char* category;
+    uint64_t begin;
+    uint64_t end;
+};
+
+struct ThreadBuffer {
+    mutex lock;
+    vector<SpanRecord> spans;
+    size_t dropped = 0;
+    unsigned thread_id = 0;
+};
+
+// Buffers outlive their threads so spans survive until exported
+struct Registry {
+    mutex lock;
+    vector<shared_ptr<ThreadBuffer>> buffers;
+    unsigned next_thread_id = 1;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+ThreadBuffer& threadBuffer() {
+    thread_local shared_ptr<ThreadBuffer> buffer = [] {
+        auto created = make_shared<ThreadBuffer>();
+        Registry& reg = registry();
+        lock_guard<mutex> guard(reg.lock);
+        created->thread_id = reg.next_thread_id++;
+        reg.buffers.push_back(created);
+        return created;
+    }();
+    return *buffer;
+}
+
+vector<shared_ptr<ThreadBuffer>> allBuffers() {
+    Registry& reg = registry();
+    lock_guard<mutex> guard(reg.lock);
+    return reg.buffers;
+}
+
+// JSON string body (names are literals, but escape anyway)
+void writeEscaped(ostream& out, const char* text) {
+    for (const char* p = text; *p; p++) {
+        if (*p == '"' || *p == '\\') {
+            out << '\\';
+        }
+        out << *p;
+    }
+}
+
+}  // namespace
+
+atomic<bool> recording{false};
+
+void start() {
+    recording.store(true, memory_order_relaxed);
+}
+
+void stop() {
+    recording.store(false, memory_order_relaxed);
+}
+
+void clear() {
+    for (const auto& buffer : allBuffers()) {
+        lock_guard<mutex> guard(buffer->lock);
+        buffer->spans.clear();
+        buffer->dropped = 0;
+    }
+}
+
+size_t spanCount() {
+    size_t count = 0;
+    for (const auto& buffer : allBuffers()) {
+        lock_guard<mutex> guard(buffer->lock);
+        count += buffer->spans.size();
+    }
+    return count;
+}
+
+size_t droppedCount() {
+    size_t count = 0;
+    for (const auto& buffer : allBuffers()) {
+        lock_guard<mutex> guard(buffer->lock);
+        count += buffer->dropped;
+    }
+    return count;
+}
+
+void record(const char* name, const char* category, uint64_t begin, uint64_t end) {
+    ThreadBuffer& buffer = threadBuffer();
+    lock_guard<mutex> guard(buffer.lock);
+    if (buffer.spans.size() >= kThreadBufferSpans) {
+        buffer.dropped++;
+        return;
+    }
+    buffer.spans.push_back(SpanRecord{name, category, begin, end});
+}
+
+size_t writeChromeTrace(ostream& out) {
+    vector<shared_ptr<ThreadBuffer>> buffers = allBuffers();
+
+    // Timestamps are microseconds from the earliest recorded span
+    uint64_t origin = UINT64_MAX;
+    for (const auto& buffer : buffers) {
+        lock_guard<mutex> guard(buffer->lock);
+        for (const SpanRecord& span : buffer->spans) {
+            origin = min(origin, span.begin);
+        }
+    }
+    double us_per_tick = latency_clock::nanosecondsPerTick() / 1000.0;
+
+    size_t written = 0;
+    out << "{\"traceEvents\":[";
+    out << fixed << setprecision(3);
+    for (const auto& buffer : buffers) {
+        lock_guard<mutex> guard(buffer->lock);
+        for (const SpanRecord& span : buffer->spans) {
+            out << (written ? ",\n" : "\n") << "{\"name\":\"";
+            writeEscaped(out, span.name);
+            out << "\",\"cat\":\"";
+            writeEscaped(out, span.category);
+            out << "\",\"ph\":\"X\",\"ts\":" << (span.begin - origin) * us_per_tick
+                << ",\"dur\":" << (span.end - span.begin) * us_per_tick
+                << ",\"pid\":1,\"tid\":" << buffer->thread_id << "}";
+            written++;
+        }
+    }
+    out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    return written;
+}
+
+bool saveChromeTrace(const string& path) {
+    ofstream file(path);
+    if (!file) {
+        return false;
+    }
+    writeChromeTrace(file);
+    return static_cast<bool>(file);
+}
+
+}  // namespace fs_trace
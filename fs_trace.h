@@ -0,0 +1,90 @@
+#ifndef FS_TRACE_H
+#define FS_TRACE_H
+
+#include "latency_histogram.h"
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+// File system code is instrumented only when the build sets FAT_FS_TRACE=1;
+// otherwise FS_TRACE_SPAN expands to nothing
+#ifndef FAT_FS_TRACE
+#define FAT_FS_TRACE 0
+#endif
+
+// ============================================
+// SPAN TRACING (CHROME TRACE / PERFETTO)
+// ============================================
+
+// Process-wide recorder of timed spans. Each thread appends completed
+// spans to its own buffer (a mutex only contended while exporting), so
+// recording threads never wait for each other. Spans are only recorded
+// between start() and stop(); outside that window a span costs one
+// relaxed atomic load. writeChromeTrace() emits the Chrome trace event
+// JSON format, which chrome://tracing and ui.perfetto.dev load directly.
+//
+// Span names and categories must be string literals (or otherwise
+// outlive the trace): only the pointers are stored.
+namespace fs_trace {
+
+extern std::atomic<bool> recording;
+
+inline bool active() {
+    return recording.load(std::memory_order_relaxed);
+}
+
+// Begin recording (existing spans are kept) / stop recording
+void start();
+void stop();
+
+// Drop every recorded span
+void clear();
+
+// Spans recorded so far, and spans lost to full thread buffers
+size_t spanCount();
+size_t droppedCount();
+
+// Export as {"traceEvents": [...]}; returns the number of spans written
+size_t writeChromeTrace(std::ostream& out);
+bool saveChromeTrace(const std::string& path);
+
+// Append one completed span to the calling thread's buffer
+void record(const char* name, const char* category, uint64_t begin, uint64_t end);
+
+// RAII span: covers the lifetime of the object
+class Span {
+private:
+    const char* name;
+    const char* category;
+    uint64_t begin;
+
+public:
+    Span(const char* span_name, const char* span_category)
+        : name(span_name), category(span_category),
+          begin(active() ? latency_clock::now() : 0) {}
+
+    ~Span() {
+        if (begin != 0 && active()) {
+            record(name, category, begin, latency_clock::now());
+        }
+    }
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+};
+
+}  // namespace fs_trace
+
+#define FS_TRACE_CONCAT_INNER(a, b) a##b
+#define FS_TRACE_CONCAT(a, b) FS_TRACE_CONCAT_INNER(a, b)
+
+#if FAT_FS_TRACE
+#define FS_TRACE_SPAN(name, category) \
+    fs_trace::Span FS_TRACE_CONCAT(trace_span_, __LINE__)(name, category)
+#else
+#define FS_TRACE_SPAN(name, category) ((void)0)
+#endif
+
+#endif // FS_TRACE_H
@@ -17,14 +17,25 @@ void printMenu() {
     cout << "Enter choice: ";
 }
 
-void interactiveTest() {
+void interactiveTest(const string& record_path) {
     cout << "Initializing FAT File System..." << endl;
     FATFileSystem fs(1024, 512, "TEST_FS");
     
+    // The session can be replayed later with fat_replay
+    if (!record_path.empty()) {
+        if (fs.startRecording(record_path)) {
+            cout << "Recording calls to " << record_path << endl;
+        } else {
+            cout << "Cannot record to " << record_path << endl;
+        }
+    }
+    
     int choice;
     string input;
     
     while (true) {
+        // Show what the file system reported since the last command
+        fs.drainLog(cout);
         printMenu();
         cin >> choice;
         cin.ignore(); // Clear newline
@@ -157,9 +168,10 @@ void interactiveTest() {
     }
 }
 
-int main() {
+// Usage: fat_interactive_test [record_path]
+int main(int argc, char* argv[]) {
     try {
-        interactiveTest();
+        interactiveTest(argc > 1 ? argv[1] : "");
         return 0;
     } catch (const exception& e) {
         cerr << "Error: " << e.what() << endl;
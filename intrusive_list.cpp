@@ -0,0 +1,272 @@
+#ifndef INTRUSIVE_LIST_CPP
+#define INTRUSIVE_LIST_CPP
+
+#include "intrusive_list.h"
+
+// Mark an object as linked (it must not already be)
+template <typename T, typename LinkTraits>
+void IntrusiveSinglyLinkedList<T, LinkTraits>::claim(T& object) {
+    IntrusiveLink<T>& hook = link(object);
+    if (hook.linked) {
+        throw std::logic_error("Object is already linked through this hook");
+    }
+    hook.linked = true;
+    hook.next = nullptr;
+}
+
+// Clear an unlinked object's hook and hand it back
+template <typename T, typename LinkTraits>
+T* IntrusiveSinglyLinkedList<T, LinkTraits>::release(T* object) {
+    IntrusiveLink<T>& hook = link(*object);
+    hook.linked = false;
+    hook.next = nullptr;
+    size--;
+    return object;
+}
+
+// Element at position (0 <= position < size)
+template <typename T, typename LinkTraits>
+T* IntrusiveSinglyLinkedList<T, LinkTraits>::objectAt(int position) const {
+    if (position == size - 1) {
+        return tail;
+    }
+    T* current = head;
+    for (int i = 0; i < position; i++) {
+        current = nextOf(current);
+    }
+    return current;
+}
+
+// Move constructor
+template <typename T, typename LinkTraits>
+IntrusiveSinglyLinkedList<T, LinkTraits>::IntrusiveSinglyLinkedList(IntrusiveSinglyLinkedList&& other) noexcept
+    : head(other.head), tail(other.tail), size(other.size) {
+    other.head = other.tail = nullptr;
+    other.size = 0;
+}
+
+// Move assignment (this list's elements are unlinked first)
+template <typename T, typename LinkTraits>
+IntrusiveSinglyLinkedList<T, LinkTraits>&
+IntrusiveSinglyLinkedList<T, LinkTraits>::operator=(IntrusiveSinglyLinkedList&& other) noexcept {
+    if (this != &other) {
+        clear();
+        head = other.head;
+        tail = other.tail;
+        size = other.size;
+        other.head = other.tail = nullptr;
+        other.size = 0;
+    }
+    return *this;
+}
+
+// Check if list is empty
+template <typename T, typename LinkTraits>
+bool IntrusiveSinglyLinkedList<T, LinkTraits>::isEmpty() const {
+    return head == nullptr;
+}
+
+// Get size of list
+template <typename T, typename LinkTraits>
+int IntrusiveSinglyLinkedList<T, LinkTraits>::getSize() const {
+    return size;
+}
+
+// Insert at beginning
+template <typename T, typename LinkTraits>
+void IntrusiveSinglyLinkedList<T, LinkTraits>::insertAtBeginning(T& object) {
+    claim(object);
+    link(object).next = head;
+    head = &object;
+    if (tail == nullptr) {
+        tail = &object;
+    }
+    size++;
+}
+
+// Insert at end
+template <typename T, typename LinkTraits>
+void IntrusiveSinglyLinkedList<T, LinkTraits>::insertAtEnd(T& object) {
+    claim(object);
+    if (tail == nullptr) {
+        head = &object;
+    } else {
+        link(*tail).next = &object;
+    }
+    tail = &object;
+    size++;
+}
+
+// Insert at specific position (0-based index)
+template <typename T, typename LinkTraits>
+void IntrusiveSinglyLinkedList<T, LinkTraits>::insertAtPosition(T& object, int position) {
+    if (position < 0 || position > size) {
+        throw std::out_of_range("Position out of range");
+    }
+    if (position == 0) {
+        insertAtBeginning(object);
+    } else {
+        insert_after(const_iterator(objectAt(position - 1)), object);
+    }
+}
+
+// Delete from beginning
+template <typename T, typename LinkTraits>
+T* IntrusiveSinglyLinkedList<T, LinkTraits>::deleteFromBeginning() {
+    if (isEmpty()) {
+        return nullptr;
+    }
+    T* object = head;
+    head = nextOf(object);
+    if (head == nullptr) {
+        tail = nullptr;
+    }
+    return release(object);
+}
+
+// Delete from end (O(n): the predecessor has to be found)
+template <typename T, typename LinkTraits>
+T* IntrusiveSinglyLinkedList<T, LinkTraits>::deleteFromEnd() {
+    if (isEmpty()) {
+        return nullptr;
+    }
+    if (head == tail) {
+        return deleteFromBeginning();
+    }
+    return deleteFromPosition(size - 1);
+}
+
+// Delete from specific position
+template <typename T, typename LinkTraits>
+T* IntrusiveSinglyLinkedList<T, LinkTraits>::deleteFromPosition(int position) {
+    if (position < 0 || position >= size) {
+        return nullptr;
+    }
+    if (position == 0) {
+        return deleteFromBeginning();
+    }
+    T* previous = objectAt(position - 1);
+    T* object = nextOf(previous);
+    erase_after(const_iterator(previous));
+    return object;
+}
+
+// Unlink a specific object (O(n)); false if it is not on this list
+template <typename T, typename LinkTraits>
+bool IntrusiveSinglyLinkedList<T, LinkTraits>::remove(T& object) {
+    if (!link(object).linked) {
+        return false;
+    }
+    T* previous = nullptr;
+    for (T* current = head; current != nullptr; current = nextOf(current)) {
+        if (current == &object) {
+            erase_after(previous ? const_iterator(previous) : before_begin());
+            return true;
+        }
+        previous = current;
+    }
+    return false;
+}
+
+// Check whether this very object is on the list
+template <typename T, typename LinkTraits>
+bool IntrusiveSinglyLinkedList<T, LinkTraits>::contains(const T& object) const {
+    for (const T* current = head; current != nullptr; current = nextOf(current)) {
+        if (current == &object) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Get reference at position
+template <typename T, typename LinkTraits>
+T& IntrusiveSinglyLinkedList<T, LinkTraits>::getRef(int position) {
+    if (position < 0 || position >= size) {
+        throw std::out_of_range("Position out of range");
+    }
+    return *objectAt(position);
+}
+
+// Get const reference at position
+template <typename T, typename LinkTraits>
+const T& IntrusiveSinglyLinkedList<T, LinkTraits>::getConstRef(int position) const {
+    if (position < 0 || position >= size) {
+        throw std::out_of_range("Position out of range");
+    }
+    return *objectAt(position);
+}
+
+// Reverse the list
+template <typename T, typename LinkTraits>
+void IntrusiveSinglyLinkedList<T, LinkTraits>::reverse() {
+    T* previous = nullptr;
+    T* current = head;
+    tail = head;
+    while (current != nullptr) {
+        T* next = nextOf(current);
+        link(*current).next = previous;
+        previous = current;
+        current = next;
+    }
+    head = previous;
+}
+
+// Unlink every element (none are destroyed)
+template <typename T, typename LinkTraits>
+void IntrusiveSinglyLinkedList<T, LinkTraits>::clear() {
+    while (deleteFromBeginning() != nullptr) {
+    }
+}
+
+// Link object after position (before_begin() inserts at the front)
+template <typename T, typename LinkTraits>
+typename IntrusiveSinglyLinkedList<T, LinkTraits>::iterator
+IntrusiveSinglyLinkedList<T, LinkTraits>::insert_after(const_iterator position, T& object) {
+    if (position == cend()) {
+        throw std::out_of_range("Cannot insert after end()");
+    }
+    if (position.before) {
+        insertAtBeginning(object);
+        return iterator(head);
+    }
+
+    claim(object);
+    T* previous = position.object;
+    link(object).next = nextOf(previous);
+    link(*previous).next = &object;
+    if (previous == tail) {
+        tail = &object;
+    }
+    size++;
+    return iterator(&object);
+}
+
+// Unlink the element following position; returns the iterator after it
+// (end() when nothing follows, including for position == end())
+template <typename T, typename LinkTraits>
+typename IntrusiveSinglyLinkedList<T, LinkTraits>::iterator
+IntrusiveSinglyLinkedList<T, LinkTraits>::erase_after(const_iterator position) {
+    if (position == cend()) {
+        return end();
+    }
+    T* previous = position.before ? nullptr : position.object;
+    T* victim = previous ? nextOf(previous) : head;
+    if (victim == nullptr) {
+        return end();
+    }
+
+    T* following = nextOf(victim);
+    if (previous) {
+        link(*previous).next = following;
+    } else {
+        head = following;
+    }
+    if (victim == tail) {
+        tail = previous;
+    }
+    release(victim);
+    return iterator(following);
+}
+
+#endif // INTRUSIVE_LIST_CPP
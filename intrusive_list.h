@@ -0,0 +1,183 @@
+#ifndef INTRUSIVE_LIST_H
+#define INTRUSIVE_LIST_H
+
+#include <stdexcept>
+#include <iterator>
+#include <cstddef>
+
+// Link field embedded in an element; one per list the element can be on
+template <typename T>
+struct IntrusiveLink {
+    T* next;
+    bool linked;
+
+    IntrusiveLink() : next(nullptr), linked(false) {}
+
+    // Copying an element must not copy its list membership
+    IntrusiveLink(const IntrusiveLink&) : next(nullptr), linked(false) {}
+    IntrusiveLink& operator=(const IntrusiveLink&) { return *this; }
+};
+
+// Base-class hook: derive from IntrusiveListNode<T, Tag>, once per Tag
+template <typename T, typename Tag = void>
+struct IntrusiveListNode {
+    IntrusiveLink<T> intrusive_link;
+};
+
+// Link access through an IntrusiveListNode<T, Tag> base
+template <typename Tag = void>
+struct BaseLink {
+    template <typename T>
+    static IntrusiveLink<T>& get(T& object) {
+        return static_cast<IntrusiveListNode<T, Tag>&>(object).intrusive_link;
+    }
+};
+
+// Link access through an IntrusiveLink<T> data member
+template <typename T, IntrusiveLink<T> T::*Member>
+struct MemberLink {
+    static IntrusiveLink<T>& get(T& object) {
+        return object.*Member;
+    }
+};
+
+// IntrusiveSinglyLinkedList class template
+//
+// Threads caller-owned objects through a link stored inside them, so
+// membership costs no allocation and no copy, and one object can sit on
+// several lists at once (one hook each):
+//
+//   struct Block : IntrusiveListNode<Block> { IntrusiveLink<Block> dirty_link; };
+//   IntrusiveSinglyLinkedList<Block> free_list;
+//   IntrusiveSinglyLinkedList<Block, MemberLink<Block, &Block::dirty_link>> dirty;
+//
+// The list never owns its elements: deleting unlinks and returns the
+// object, and clear()/the destructor only unlink. An element must outlive
+// its membership. Inserting an element already linked through the same
+// hook throws std::logic_error.
+template <typename T, typename LinkTraits = BaseLink<>>
+class IntrusiveSinglyLinkedList {
+private:
+    T* head;
+    T* tail;
+    int size;
+
+    static IntrusiveLink<T>& link(T& object) { return LinkTraits::get(object); }
+    static T* nextOf(const T* object) { return LinkTraits::get(const_cast<T&>(*object)).next; }
+
+    void claim(T& object);
+    T* release(T* object);
+    T* objectAt(int position) const;
+
+    template <bool IsConst>
+    class BasicIterator {
+    private:
+        T* object;
+        T* const* before;
+
+        friend class IntrusiveSinglyLinkedList;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::conditional<IsConst, const T*, T*>::type;
+        using reference = typename std::conditional<IsConst, const T&, T&>::type;
+
+        BasicIterator(T* o = nullptr, T* const* head_link = nullptr)
+            : object(o), before(head_link) {}
+
+        // iterator -> const_iterator
+        template <bool WasConst, typename = typename std::enable_if<IsConst && !WasConst>::type>
+        BasicIterator(const BasicIterator<WasConst>& other)
+            : object(other.object), before(other.before) {}
+
+        reference operator*() const { return *object; }
+        pointer operator->() const { return object; }
+
+        BasicIterator& operator++() {
+            if (before) {
+                object = *before;
+                before = nullptr;
+            } else {
+                object = nextOf(object);
+            }
+            return *this;
+        }
+
+        BasicIterator operator++(int) {
+            BasicIterator previous = *this;
+            ++(*this);
+            return previous;
+        }
+
+        friend bool operator==(const BasicIterator& a, const BasicIterator& b) {
+            return a.object == b.object && a.before == b.before;
+        }
+        friend bool operator!=(const BasicIterator& a, const BasicIterator& b) {
+            return !(a == b);
+        }
+
+        template <bool> friend class BasicIterator;
+    };
+
+public:
+    using iterator = BasicIterator<false>;
+    using const_iterator = BasicIterator<true>;
+
+    // Constructor
+    IntrusiveSinglyLinkedList() : head(nullptr), tail(nullptr), size(0) {}
+
+    // Membership cannot be duplicated; moving hands the chain over
+    IntrusiveSinglyLinkedList(const IntrusiveSinglyLinkedList&) = delete;
+    IntrusiveSinglyLinkedList& operator=(const IntrusiveSinglyLinkedList&) = delete;
+    IntrusiveSinglyLinkedList(IntrusiveSinglyLinkedList&& other) noexcept;
+    IntrusiveSinglyLinkedList& operator=(IntrusiveSinglyLinkedList&& other) noexcept;
+
+    // Destructor (unlinks, never frees)
+    ~IntrusiveSinglyLinkedList() {
+        clear();
+    }
+
+    static bool isLinked(T& object) { return link(object).linked; }
+
+    bool isEmpty() const;
+    int getSize() const;
+    void insertAtBeginning(T& object);
+    void insertAtEnd(T& object);
+    void insertAtPosition(T& object, int position);
+
+    // Unlink and return the element, or nullptr if there is none
+    T* deleteFromBeginning();
+    T* deleteFromEnd();
+    T* deleteFromPosition(int position);
+    bool remove(T& object);
+
+    bool contains(const T& object) const;
+    T& getRef(int position);
+    const T& getConstRef(int position) const;
+    T& front() { return *head; }
+    T& back() { return *tail; }
+    void reverse();
+    void clear();
+
+    // Iteration
+    iterator begin() { return iterator(head); }
+    iterator end() { return iterator(); }
+    const_iterator begin() const { return const_iterator(head); }
+    const_iterator end() const { return const_iterator(); }
+    const_iterator cbegin() const { return const_iterator(head); }
+    const_iterator cend() const { return const_iterator(); }
+    iterator before_begin() { return iterator(nullptr, &head); }
+    const_iterator before_begin() const { return const_iterator(nullptr, &head); }
+
+    // Iterator-based insertion/removal (O(1)). Inserting after end() throws
+    // std::out_of_range; erasing after it does nothing and returns end().
+    iterator insert_after(const_iterator position, T& object);
+    iterator erase_after(const_iterator position);
+};
+
+// Include the implementation
+#include "intrusive_list.cpp"
+
+#endif // INTRUSIVE_LIST_H
@@ -0,0 +1,51 @@
+#include "io_thread_pool.h"
+
+using namespace std;
+
+// ============================================
+// IMPLEMENTATION
+// ============================================
+
+IoThreadPool::IoThreadPool(size_t worker_count) : stopping(false) {
+    if (worker_count == 0) {
+        worker_count = 1;
+    }
+    for (size_t i = 0; i < worker_count; i++) {
+        workers.emplace_back(&IoThreadPool::workerLoop, this);
+    }
+}
+
+IoThreadPool::~IoThreadPool() {
+    {
+        lock_guard<mutex> lock(queue_mutex);
+        stopping = true;
+    }
+    queue_cv.notify_all();
+    for (thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void IoThreadPool::submit(function<void()> task) {
+    {
+        lock_guard<mutex> lock(queue_mutex);
+        tasks.push_back(std::move(task));
+    }
+    queue_cv.notify_one();
+}
+
+void IoThreadPool::workerLoop() {
+    while (true) {
+        function<void()> task;
+        {
+            unique_lock<mutex> lock(queue_mutex);
+            queue_cv.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;  // Stopping and drained
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef IO_THREAD_POOL_H
+#define IO_THREAD_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ============================================
+// I/O WORKER POOL
+// ============================================
+
+// Small fixed-size worker pool behind the asynchronous FATFileSystem API.
+// Each worker runs one blocking file operation at a time, so the number
+// of workers bounds how many operations are in flight.
+class IoThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex queue_mutex;
+    std::condition_variable queue_cv;
+    bool stopping;
+
+    void workerLoop();
+
+public:
+    explicit IoThreadPool(size_t worker_count);
+    ~IoThreadPool();   // Runs every queued task before joining
+
+    IoThreadPool(const IoThreadPool&) = delete;
+    IoThreadPool& operator=(const IoThreadPool&) = delete;
+
+    void submit(std::function<void()> task);
+    size_t getWorkerCount() const { return workers.size(); }
+};
+
+#endif // IO_THREAD_POOL_H
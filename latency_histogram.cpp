@@ -0,0 +1,87 @@
+#include "latency_histogram.h"
+#include <thread>
+
+using namespace std;
+
+// ============================================
+// LATENCY CLOCK
+// ============================================
+
+double latency_clock::nanosecondsPerTick() {
+#if defined(__x86_64__) || defined(__i386__)
+    // Measured once over ~2 ms; the TSC rate is constant on current CPUs
+    static const double ratio = [] {
+        auto wall_start = chrono::steady_clock::now();
+        uint64_t tick_start = now();
+        this_thread::sleep_for(chrono::milliseconds(2));
+        uint64_t ticks = now() - tick_start;
+        double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - wall_start).count();
+        return ticks ? ns / ticks : 1.0;
+    }();
+    return ratio;
+#else
+    return 1.0;
+#endif
+}
+
+// ============================================
+// LATENCY HISTOGRAM
+// ============================================
+
+uint64_t LatencyHistogram::bucketLimit(size_t index) noexcept {
+    if (index < 2 * kSubBuckets) {
+        return index + 1;
+    }
+    uint64_t shift = index / kSubBuckets - 1;
+    uint64_t top = index % kSubBuckets + kSubBuckets;
+    return (top + 1) << shift;
+}
+
+void LatencyHistogram::reset() noexcept {
+    for (auto& bucket : buckets) {
+        bucket.store(0, memory_order_relaxed);
+    }
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+    Snapshot snap;
+    snap.ns_per_tick = latency_clock::nanosecondsPerTick();
+    for (size_t i = 0; i < kBucketCount; i++) {
+        snap.buckets[i] = buckets[i].load(memory_order_relaxed);
+        snap.count += snap.buckets[i];
+    }
+    return snap;
+}
+
+double LatencyHistogram::Snapshot::meanNs() const {
+    if (count == 0) {
+        return 0.0;
+    }
+    double total = 0.0;
+    for (size_t i = 0; i < kBucketCount; i++) {
+        if (buckets[i] != 0) {
+            double low = i == 0 ? 0.0 : static_cast<double>(bucketLimit(i - 1));
+            double high = static_cast<double>(bucketLimit(i));
+            total += buckets[i] * (low + high - 1) / 2;
+        }
+    }
+    return total / count * ns_per_tick;
+}
+
+uint64_t LatencyHistogram::Snapshot::percentileNs(double p) const {
+    if (count == 0) {
+        return 0;
+    }
+    // Nearest rank, then the highest value that rank's bucket can hold
+    uint64_t rank = static_cast<uint64_t>(p * count + 0.999999);
+    rank = rank < 1 ? 1 : (rank > count ? count : rank);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; i++) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return static_cast<uint64_t>((bucketLimit(i) - 1) * ns_per_tick + 0.5);
+        }
+    }
+    return static_cast<uint64_t>((bucketLimit(kBucketCount - 1) - 1) * ns_per_tick + 0.5);
+}
@@ -0,0 +1,117 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Latency statistics are compiled in unless the build sets FAT_FS_STATS=0
+#ifndef FAT_FS_STATS
+#define FAT_FS_STATS 1
+#endif
+
+// ============================================
+// LATENCY CLOCK
+// ============================================
+
+// Cheapest monotonic tick source available: the TSC on x86 (a few ns per
+// read), steady_clock nanoseconds elsewhere. Ticks are only converted to
+// nanoseconds when statistics are read.
+namespace latency_clock {
+
+inline uint64_t now() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// Nanoseconds per tick (calibrated once against steady_clock)
+double nanosecondsPerTick();
+
+}  // namespace latency_clock
+
+// ============================================
+// LOG-BUCKETED LATENCY HISTOGRAM
+// ============================================
+
+// HDR-style histogram of tick counts: values below 16 get a bucket each,
+// every larger power of two is split into 8 linear sub-buckets, so any
+// recorded value is known to within 12.5%. Recording is one bucket index
+// computation and one relaxed atomic add (no running sum is kept; the
+// mean is estimated from bucket midpoints). It never allocates or locks,
+// and may run concurrently with other recorders and with snapshot().
+class LatencyHistogram {
+public:
+    static constexpr unsigned kSubBucketBits = 3;
+    static constexpr uint64_t kSubBuckets = uint64_t(1) << kSubBucketBits;
+    static constexpr unsigned kMaxMagnitude = 47;    // Larger values land in the last bucket
+    static constexpr size_t kBucketCount = (kMaxMagnitude - 1) * kSubBuckets;
+
+    // Consistent-enough copy of a histogram, in nanoseconds
+    struct Snapshot {
+        std::array<uint64_t, kBucketCount> buckets{};
+        uint64_t count = 0;
+        double ns_per_tick = 1.0;
+
+        double meanNs() const;
+
+        // Upper bound of the bucket holding the p-quantile (0 < p <= 1)
+        uint64_t percentileNs(double p) const;
+        uint64_t maxNs() const { return percentileNs(1.0); }
+    };
+
+    LatencyHistogram() = default;
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    static size_t bucketIndex(uint64_t ticks) noexcept {
+        if (ticks < 2 * kSubBuckets) {
+            return static_cast<size_t>(ticks);
+        }
+        unsigned magnitude = 63 - static_cast<unsigned>(__builtin_clzll(ticks));
+        if (magnitude > kMaxMagnitude) {
+            return kBucketCount - 1;
+        }
+        unsigned shift = magnitude - kSubBucketBits;
+        return static_cast<size_t>(shift * kSubBuckets + (ticks >> shift));
+    }
+
+    // First tick value past bucket `index`
+    static uint64_t bucketLimit(size_t index) noexcept;
+
+    void record(uint64_t ticks) noexcept {
+        buckets[bucketIndex(ticks)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void reset() noexcept;
+    Snapshot snapshot() const;
+
+private:
+    std::array<std::atomic<uint64_t>, kBucketCount> buckets{};
+};
+
+// Records the lifetime of a scope into a histogram
+class ScopedLatency {
+private:
+    LatencyHistogram& histogram;
+    uint64_t start;
+
+public:
+    explicit ScopedLatency(LatencyHistogram& h) noexcept
+        : histogram(h), start(latency_clock::now()) {}
+    ~ScopedLatency() { histogram.record(latency_clock::now() - start); }
+
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+};
+
+#endif // LATENCY_HISTOGRAM_H
@@ -0,0 +1,122 @@
+#include "mapped_block_device.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+// ============================================
+// IMPLEMENTATION
+// ============================================
+
+MappedBlockDevice::MappedBlockDevice(const string& path, size_t block_size_bytes, size_t blocks,
+                                     bool read_only_image)
+    : fd(-1), base(nullptr), block_size(block_size_bytes), block_count(blocks),
+      read_only(read_only_image) {
+    size_t length = block_size * block_count;
+
+    // Only a new image is sized; an existing one is never truncated or extended
+    fd = ::open(path.c_str(), read_only ? O_RDONLY : O_RDWR);
+    if (fd < 0 && errno == ENOENT && !read_only) {
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+        if (fd >= 0 && ::ftruncate(fd, static_cast<off_t>(length)) != 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+    struct stat info;
+    if (fd < 0 || ::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) != length) {
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+        return;
+    }
+
+    int protection = read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+    void* mapping = mmap(nullptr, length, protection, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        ::close(fd);
+        fd = -1;
+        return;
+    }
+    base = static_cast<uint8_t*>(mapping);
+}
+
+MappedBlockDevice::~MappedBlockDevice() {
+    if (base) {
+        munmap(base, block_size * block_count);
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+// ============== BLOCK ACCESS ==============
+
+bool MappedBlockDevice::readBlock(size_t block, void* buffer) {
+    if (!base || block >= block_count) {
+        return false;
+    }
+    memcpy(buffer, base + block * block_size, block_size);
+    return true;
+}
+
+bool MappedBlockDevice::writeBlock(size_t block, const void* data) {
+    if (!base || read_only || block >= block_count) {
+        return false;
+    }
+    memcpy(base + block * block_size, data, block_size);
+    return true;
+}
+
+bool MappedBlockDevice::flush() {
+    if (read_only) {
+        return base != nullptr;
+    }
+    return base && msync(base, block_size * block_count, MS_SYNC) == 0;
+}
+
+// Read-only mappings are not handed out: in-place writes would fault
+uint8_t* MappedBlockDevice::mappedBlock(size_t block) {
+    if (!base || read_only || block >= block_count) {
+        return nullptr;
+    }
+    return base + block * block_size;
+}
+
+// ============== ACCESS HINTS ==============
+
+void MappedBlockDevice::advise(size_t first, size_t count, int advice) {
+    // madvise() wants page-aligned ranges
+    static const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t begin = first * block_size / page * page;
+    size_t end = (first + count) * block_size;
+    madvise(base + begin, end - begin, advice);
+}
+
+void MappedBlockDevice::adviseAccess(const vector<size_t>& blocks, AccessHint hint) {
+    if (!base || blocks.empty()) {
+        return;
+    }
+
+    int advice = (hint == AccessHint::Sequential) ? MADV_SEQUENTIAL : MADV_WILLNEED;
+
+    // One madvise per contiguous run of blocks
+    size_t run_start = blocks[0];
+    size_t run_length = 1;
+    for (size_t i = 1; i <= blocks.size(); i++) {
+        if (i < blocks.size() && blocks[i] == run_start + run_length) {
+            run_length++;
+            continue;
+        }
+        if (run_start + run_length <= block_count) {
+            advise(run_start, run_length, advice);
+        }
+        if (i < blocks.size()) {
+            run_start = blocks[i];
+            run_length = 1;
+        }
+    }
+}
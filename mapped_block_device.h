@@ -0,0 +1,54 @@
+#ifndef MAPPED_BLOCK_DEVICE_H
+#define MAPPED_BLOCK_DEVICE_H
+
+#include "block_device.h"
+#include <string>
+
+// ============================================
+// MEMORY-MAPPED IMAGE-FILE DEVICE (POSIX)
+// ============================================
+
+// Volume image mapped into the address space. The buffer cache is
+// bypassed: FAT and data clusters are read and written in place and the
+// kernel page cache does the write-back. Access hints become madvise()
+// calls over contiguous runs of blocks.
+//
+// A read-only device maps the image PROT_READ and hands out no in-place
+// blocks, so the file system reads through the cache and every write or
+// flush of a dirty block fails.
+class MappedBlockDevice : public BlockDevice {
+private:
+    int fd;
+    uint8_t* base;
+    size_t block_size;
+    size_t block_count;
+    bool read_only;
+
+    void advise(size_t first, size_t count, int advice);
+
+public:
+    // Maps the image at `path`. A missing image is created at the
+    // geometry's size (unless read_only); an existing one keeps its size
+    // and is refused (isOpen() false) if that is not blocks * block_size.
+    MappedBlockDevice(const std::string& path, size_t block_size_bytes, size_t blocks,
+                      bool read_only = false);
+    ~MappedBlockDevice() override;
+
+    MappedBlockDevice(const MappedBlockDevice&) = delete;
+    MappedBlockDevice& operator=(const MappedBlockDevice&) = delete;
+
+    bool isOpen() const { return base != nullptr; }
+    bool isReadOnly() const { return read_only; }
+
+    size_t getBlockSize() const override { return block_size; }
+    size_t getBlockCount() const override { return block_count; }
+
+    bool readBlock(size_t block, void* buffer) override;
+    bool writeBlock(size_t block, const void* data) override;
+    bool flush() override;
+
+    uint8_t* mappedBlock(size_t block) override;
+    void adviseAccess(const std::vector<size_t>& blocks, AccessHint hint) override;
+};
+
+#endif // MAPPED_BLOCK_DEVICE_H
@@ -0,0 +1,218 @@
+#ifndef MPSC_QUEUE_CPP
+#define MPSC_QUEUE_CPP
+
+#include "mpsc_queue.h"
+#include <new>
+
+// Constructor
+template <typename T>
+MpscQueue<T>::MpscQueue(size_t pool_size, size_t producer_handles)
+    : head(&stub), tail(&stub), stub(T()),
+      pool(nullptr), pool_capacity(pool_size), producer_count(producer_handles),
+      producers(new Producer[producer_handles]), free_top(0) {
+    // Carve every pool out of one allocation; the shared slice comes first
+    // and is threaded onto the free stack
+    size_t total = pool_capacity * (1 + producer_count);
+    pool = static_cast<Node<T>*>(::operator new(sizeof(Node<T>) * total));
+    for (size_t i = 0; i < total; i++) {
+        new (&pool[i]) Node<T>(T());
+        pool[i].next = (i + 1 < pool_capacity) ? &pool[i + 1] : nullptr;
+    }
+    free_top.store(pool_capacity > 0 ? 1 : 0, std::memory_order_relaxed);
+
+    // Each producer's free ring starts out holding all of its nodes
+    for (size_t p = 0; p < producer_count; p++) {
+        Producer& producer = producers[p];
+        producer.queue = this;
+        producer.first = pool_capacity * (p + 1);
+        producer.free_ring.reset(new uint32_t[pool_capacity]);
+        for (size_t i = 0; i < pool_capacity; i++) {
+            producer.free_ring[i] = static_cast<uint32_t>(i);
+        }
+        producer.returned.store(pool_capacity, std::memory_order_relaxed);
+    }
+}
+
+// Destructor (intrusive nodes still queued belong to their owners)
+template <typename T>
+MpscQueue<T>::~MpscQueue() {
+    size_t total = pool_capacity * (1 + producer_count);
+    for (size_t i = 0; i < total; i++) {
+        pool[i].~Node<T>();
+    }
+    ::operator delete(pool);
+}
+
+// Pool nodes are recycled on dequeue; caller-owned nodes are not
+template <typename T>
+bool MpscQueue<T>::ownsNode(const Node<T>* node) const {
+    return node >= pool && node < pool + pool_capacity * (1 + producer_count);
+}
+
+// Pop a node off the free stack (lock-free; the tag defeats ABA)
+template <typename T>
+Node<T>* MpscQueue<T>::acquireNode() {
+    uint64_t top = free_top.load(std::memory_order_acquire);
+    while (true) {
+        uint32_t index = static_cast<uint32_t>(top);
+        if (index == 0) {
+            return nullptr;  // Pool exhausted
+        }
+
+        Node<T>* node = &pool[index - 1];
+        Node<T>* next = __atomic_load_n(&node->next, __ATOMIC_RELAXED);
+        uint64_t next_index = next ? static_cast<uint64_t>(next - pool) + 1 : 0;
+        uint64_t tag = (top >> 32) + 1;
+
+        if (free_top.compare_exchange_weak(top, (tag << 32) | next_index,
+                                           std::memory_order_acq_rel,
+                                           std::memory_order_acquire)) {
+            return node;
+        }
+    }
+}
+
+// Push a node back onto the free stack
+template <typename T>
+void MpscQueue<T>::releaseNode(Node<T>* node) {
+    uint64_t index = static_cast<uint64_t>(node - pool) + 1;
+    uint64_t top = free_top.load(std::memory_order_relaxed);
+    while (true) {
+        uint32_t top_index = static_cast<uint32_t>(top);
+        __atomic_store_n(&node->next, top_index ? &pool[top_index - 1] : nullptr,
+                         __ATOMIC_RELAXED);
+        uint64_t tag = (top >> 32) + 1;
+
+        if (free_top.compare_exchange_weak(top, (tag << 32) | index,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+// Link a node at the producer end (wait-free)
+template <typename T>
+void MpscQueue<T>::push(Node<T>* node) {
+    __atomic_store_n(&node->next, nullptr, __ATOMIC_RELAXED);
+    Node<T>* previous = __atomic_exchange_n(&head, node, __ATOMIC_ACQ_REL);
+    // Until this store lands the consumer sees the queue as momentarily cut
+    __atomic_store_n(&previous->next, node, __ATOMIC_RELEASE);
+}
+
+// Enqueue a copy of value using a shared pool node (lock-free: taking the
+// node may retry its CAS under contention)
+template <typename T>
+bool MpscQueue<T>::tryEnqueue(const T& value) {
+    Node<T>* node = acquireNode();
+    if (node == nullptr) {
+        return false;
+    }
+    node->data = value;
+    push(node);
+    return true;
+}
+
+// Unlink the oldest node, or nullptr if empty (or a push is mid-flight)
+template <typename T>
+Node<T>* MpscQueue<T>::pop() {
+    Node<T>* current = tail;
+    Node<T>* next = __atomic_load_n(&current->next, __ATOMIC_ACQUIRE);
+
+    // Skip over the stub
+    if (current == &stub) {
+        if (next == nullptr) {
+            return nullptr;
+        }
+        tail = next;
+        current = next;
+        next = __atomic_load_n(&current->next, __ATOMIC_ACQUIRE);
+    }
+
+    if (next != nullptr) {
+        tail = next;
+        return current;
+    }
+
+    // current is the last linked node; a producer may still be linking
+    if (current != __atomic_load_n(&head, __ATOMIC_ACQUIRE)) {
+        return nullptr;
+    }
+
+    // Re-insert the stub behind current so current can be handed out
+    push(&stub);
+    next = __atomic_load_n(&current->next, __ATOMIC_ACQUIRE);
+    if (next != nullptr) {
+        tail = next;
+        return current;
+    }
+    return nullptr;
+}
+
+// Dequeue into value; pool nodes go back to the pool they came from
+template <typename T>
+bool MpscQueue<T>::tryDequeue(T& value) {
+    Node<T>* node = pop();
+    if (node == nullptr) {
+        return false;
+    }
+    value = node->data;
+    if (ownsNode(node)) {
+        size_t slice = static_cast<size_t>(node - pool) / pool_capacity;
+        if (slice == 0) {
+            releaseNode(node);
+        } else {
+            producers[slice - 1].recycle(node);
+        }
+    }
+    return true;
+}
+
+// Producer handle for one thread
+template <typename T>
+typename MpscQueue<T>::Producer& MpscQueue<T>::getProducer(size_t id) {
+    return producers[id];
+}
+
+// Enqueue a copy of value using one of this handle's nodes (wait-free).
+// Only the consumer adds to the free ring and only this thread takes from
+// it, so the ring never holds more than its capacity and nothing retries.
+template <typename T>
+bool MpscQueue<T>::Producer::tryEnqueue(const T& value) {
+    if (taken == returned.load(std::memory_order_acquire)) {
+        return false;  // Every node of this handle is in the queue
+    }
+    size_t capacity = queue->pool_capacity;
+    Node<T>* node = &queue->pool[first + free_ring[taken % capacity]];
+    taken++;
+    node->data = value;
+    queue->push(node);
+    return true;
+}
+
+// Hand a dequeued node back to its producer (consumer side). The node was
+// taken from the ring, so at most capacity - 1 slots are live and the one
+// written here is free; the producer's push/our pop orders its earlier read.
+template <typename T>
+void MpscQueue<T>::Producer::recycle(Node<T>* node) {
+    size_t capacity = queue->pool_capacity;
+    size_t slot = returned.load(std::memory_order_relaxed);
+    free_ring[slot % capacity] = static_cast<uint32_t>(node - queue->pool - first);
+    returned.store(slot + 1, std::memory_order_release);
+}
+
+// Check if queue is empty (consumer side)
+template <typename T>
+bool MpscQueue<T>::isEmpty() const {
+    const Node<T>* current = tail;
+    const Node<T>* next = __atomic_load_n(&current->next, __ATOMIC_ACQUIRE);
+    return current == &stub && next == nullptr;
+}
+
+// Number of preallocated nodes
+template <typename T>
+size_t MpscQueue<T>::getPoolCapacity() const {
+    return pool_capacity;
+}
+
+#endif // MPSC_QUEUE_CPP
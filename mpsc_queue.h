@@ -0,0 +1,100 @@
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include "singly_linked_list.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// MpscQueue class template
+//
+// Lock-free multi-producer / single-consumer queue (Vyukov intrusive MPSC)
+// threaded through the same Node<T> used by SinglyLinkedList. `next` is
+// accessed with atomic builtins, so nodes need no extra fields.
+//
+// - push(node): intrusive, wait-free (one exchange + one store)
+// - getProducer(id).tryEnqueue(value): wait-free and allocation-free. Each
+//   producer handle owns pool_size nodes of its own; the consumer hands
+//   them back through a single-producer/single-consumer ring, so taking a
+//   node never retries. One thread per handle.
+// - tryEnqueue(value): any thread, allocation-free but only lock-free: the
+//   shared pool is a tagged Treiber stack whose CAS may retry under
+//   contention
+// - Both return false when their pool is exhausted
+// - pop()/tryDequeue(): consumer side, only ever called by one thread
+//
+// T must be default constructible (for the stub and pool nodes).
+template <typename T>
+class MpscQueue {
+public:
+    // Enqueue end for a single producer thread, with its own node pool
+    class Producer {
+    private:
+        friend class MpscQueue;
+
+        MpscQueue* queue;
+        size_t first;                    // Pool index of this handle's first node
+        size_t taken;                    // Free-ring reads (producer only)
+        std::unique_ptr<uint32_t[]> free_ring;
+        alignas(64) std::atomic<size_t> returned;  // Free-ring writes (consumer only)
+
+        void recycle(Node<T>* node);
+
+    public:
+        Producer() : queue(nullptr), first(0), taken(0), returned(0) {}
+
+        Producer(const Producer&) = delete;
+        Producer& operator=(const Producer&) = delete;
+
+        bool tryEnqueue(const T& value);
+    };
+
+private:
+    // Producer end: most recently pushed node
+    alignas(64) Node<T>* head;
+    // Consumer end: oldest node not yet popped
+    alignas(64) Node<T>* tail;
+    Node<T> stub;
+
+    // Node pool: pool_size shared nodes, then pool_size per producer handle.
+    // The shared ones form a Treiber stack, index + ABA tag in one word.
+    Node<T>* pool;
+    size_t pool_capacity;
+    size_t producer_count;
+    std::unique_ptr<Producer[]> producers;
+    alignas(64) std::atomic<uint64_t> free_top;
+
+    bool ownsNode(const Node<T>* node) const;
+    Node<T>* acquireNode();
+    void releaseNode(Node<T>* node);
+
+public:
+    // Constructor (pool_size nodes for the shared pool and pool_size more
+    // for each of the producer_handles are allocated up front)
+    explicit MpscQueue(size_t pool_size = 1024, size_t producer_handles = 0);
+
+    // Destructor
+    ~MpscQueue();
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Producer side (any thread)
+    void push(Node<T>* node);
+    bool tryEnqueue(const T& value);
+    // Handle for the id-th producer thread (id < producers)
+    Producer& getProducer(size_t id);
+
+    // Consumer side (single thread)
+    Node<T>* pop();
+    bool tryDequeue(T& value);
+
+    bool isEmpty() const;
+    size_t getPoolCapacity() const;
+};
+
+// Include the implementation
+#include "mpsc_queue.cpp"
+
+#endif // MPSC_QUEUE_H
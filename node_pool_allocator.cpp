@@ -0,0 +1,94 @@
+#ifndef NODE_POOL_ALLOCATOR_CPP
+#define NODE_POOL_ALLOCATOR_CPP
+
+#include "node_pool_allocator.h"
+#include <new>
+
+// ============== NODE POOL ==============
+
+inline NodePool::NodePool(size_t object_bytes, size_t alignment, size_t first_chunk_objects,
+                          size_t max_chunk)
+    : object_size(sizeof(Slot)),
+      object_align(alignment > alignof(Slot) ? alignment : alignof(Slot)),
+      next_chunk_objects(first_chunk_objects ? first_chunk_objects : 1),
+      max_chunk_objects(max_chunk),
+      free_list(nullptr) {
+    // Round the slot up so every object in a chunk keeps object_align
+    if (object_bytes > object_size) {
+        object_size = object_bytes;
+    }
+    object_size = (object_size + object_align - 1) / object_align * object_align;
+}
+
+inline NodePool::~NodePool() {
+    for (void* chunk : chunks) {
+        ::operator delete(chunk, std::align_val_t(object_align));
+    }
+}
+
+// Carve a new chunk into slots and push them onto the free list
+inline void NodePool::grow() {
+    size_t count = next_chunk_objects;
+    char* chunk = static_cast<char*>(::operator new(object_size * count, std::align_val_t(object_align)));
+    chunks.push_back(chunk);
+
+    for (size_t i = count; i > 0; i--) {
+        Slot* slot = reinterpret_cast<Slot*>(chunk + (i - 1) * object_size);
+        slot->next = free_list;
+        free_list = slot;
+    }
+
+    if (next_chunk_objects < max_chunk_objects) {
+        next_chunk_objects *= 2;
+    }
+}
+
+inline void* NodePool::allocate() {
+    if (free_list == nullptr) {
+        grow();
+    }
+    Slot* slot = free_list;
+    free_list = slot->next;
+    return slot;
+}
+
+inline void NodePool::deallocate(void* object) {
+    Slot* slot = static_cast<Slot*>(object);
+    slot->next = free_list;
+    free_list = slot;
+}
+
+inline size_t NodePool::getChunkCount() const {
+    return chunks.size();
+}
+
+// ============== NODE POOL SET ==============
+
+inline NodePool& NodePoolSet::poolFor(size_t object_bytes, size_t alignment) {
+    std::unique_ptr<NodePool>& pool = pools[{object_bytes, alignment}];
+    if (!pool) {
+        pool = std::make_unique<NodePool>(object_bytes, alignment);
+    }
+    return *pool;
+}
+
+// ============== NODE POOL ALLOCATOR ==============
+
+template <typename T>
+T* NodePoolAllocator<T>::allocate(size_t n) {
+    if (n != 1) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+    }
+    return static_cast<T*>(pool->allocate());
+}
+
+template <typename T>
+void NodePoolAllocator<T>::deallocate(T* object, size_t n) {
+    if (n != 1) {
+        ::operator delete(object, std::align_val_t(alignof(T)));
+        return;
+    }
+    pool->deallocate(object);
+}
+
+#endif // NODE_POOL_ALLOCATOR_CPP
@@ -0,0 +1,105 @@
+#ifndef NODE_POOL_ALLOCATOR_H
+#define NODE_POOL_ALLOCATOR_H
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// NodePool: slab allocator for fixed-size objects
+//
+// Objects are carved out of contiguous chunks (growing geometrically up to
+// max_chunk_objects) and recycled through an intrusive free list threaded
+// through the free slots themselves. Memory goes back to the system only
+// when the pool is destroyed, so a pool stays as large as its peak.
+// Not thread-safe: every list drawing from one pool must stay on one thread.
+class NodePool {
+private:
+    struct Slot {
+        Slot* next;
+    };
+
+    size_t object_size;
+    size_t object_align;
+    size_t next_chunk_objects;
+    size_t max_chunk_objects;
+    Slot* free_list;
+    std::vector<void*> chunks;
+
+    void grow();
+
+public:
+    // alignment must be a power of two; slots are padded to a multiple of it
+    NodePool(size_t object_bytes, size_t alignment = alignof(std::max_align_t),
+             size_t first_chunk_objects = 32, size_t max_chunk = 4096);
+    ~NodePool();
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    void* allocate();
+    void deallocate(void* object);
+    size_t getChunkCount() const;
+};
+
+// NodePoolSet: the pools behind one family of NodePoolAllocators, one
+// per object size and alignment, created on first use
+class NodePoolSet {
+private:
+    std::map<std::pair<size_t, size_t>, std::unique_ptr<NodePool>> pools;
+
+public:
+    NodePool& poolFor(size_t object_bytes, size_t alignment);
+};
+
+// NodePoolAllocator: standard allocator backed by a NodePool
+//
+// Opt-in (see PooledSinglyLinkedList); lists default to std::allocator.
+// Single-object requests come from the pool; array requests fall through
+// to operator new. Each default-constructed allocator owns a fresh
+// NodePoolSet and a copied container gets a fresh one too, so two lists
+// only share pools when one is built from the other's get_allocator().
+// Copies, moves (which leave the source usable) and rebound copies share
+// the set and compare equal, so an allocator rebound and rebound back
+// frees what the original allocated, as the allocator requirements demand.
+template <typename T>
+class NodePoolAllocator {
+private:
+    std::shared_ptr<NodePoolSet> pools;
+    NodePool* pool;     // The set's pool for T
+
+    template <typename U> friend class NodePoolAllocator;
+
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    NodePoolAllocator()
+        : pools(std::make_shared<NodePoolSet>()), pool(&pools->poolFor(sizeof(T), alignof(T))) {}
+    NodePoolAllocator(const NodePoolAllocator& other) = default;
+    NodePoolAllocator& operator=(const NodePoolAllocator& other) = default;
+
+    // Rebinding keeps the set and draws from its pool for T
+    template <typename U>
+    NodePoolAllocator(const NodePoolAllocator<U>& other)
+        : pools(other.pools), pool(&pools->poolFor(sizeof(T), alignof(T))) {}
+
+    // A copied container gets a pool of its own
+    NodePoolAllocator select_on_container_copy_construction() const { return NodePoolAllocator(); }
+
+    T* allocate(size_t n);
+    void deallocate(T* object, size_t n);
+
+    template <typename U>
+    bool operator==(const NodePoolAllocator<U>& other) const { return pools == other.pools; }
+    template <typename U>
+    bool operator!=(const NodePoolAllocator<U>& other) const { return pools != other.pools; }
+};
+
+// Include the implementation
+#include "node_pool_allocator.cpp"
+
+#endif // NODE_POOL_ALLOCATOR_H
@@ -0,0 +1,203 @@
+#include "perf_counters.h"
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+const char* perfEventName(PerfEvent event) {
+    static const char* const names[] = {
+        "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses", "dtlb_misses",
+    };
+    static_assert(sizeof(names) / sizeof(names[0]) == kPerfEventCount,
+                  "every PerfEvent needs a name");
+    return names[static_cast<size_t>(event)];
+}
+
+bool PerfReading::any() const {
+    for (bool v : valid) {
+        if (v) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#if defined(__linux__)
+
+namespace {
+
+struct EventConfig {
+    uint32_t type;
+    uint64_t config;
+    size_t group;                        // 0: core events, 1: cache/TLB misses
+};
+
+uint64_t cacheMiss(uint64_t cache) {
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+// Indexed by PerfEvent
+const EventConfig kEvents[kPerfEventCount] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, 0},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, 0},
+    {PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_L1D), 1},
+    {PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_LL), 1},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, 0},
+    {PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_DTLB), 1},
+};
+
+int openEvent(const EventConfig& event, int group_fd) {
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = event.type;
+    attr.config = event.config;
+    attr.disabled = group_fd < 0 ? 1 : 0;    // Members follow the leader
+    attr.exclude_kernel = 1;                 // Allowed up to perf_event_paranoid 2
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID |
+                       PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+
+}  // namespace
+
+PerfCounters::PerfCounters() {
+    fds.fill(-1);
+    ids.fill(0);
+    leaders.fill(-1);
+    int first_error = 0;
+    for (size_t i = 0; i < kPerfEventCount; i++) {
+        // A member the PMU cannot schedule alongside its group fails to
+        // open; the group simply goes without it
+        int& leader = leaders[kEvents[i].group];
+        fds[i] = openEvent(kEvents[i], leader);
+        if (fds[i] < 0) {
+            if (first_error == 0) {
+                first_error = errno;
+            }
+        } else {
+            if (ioctl(fds[i], PERF_EVENT_IOC_ID, &ids[i]) != 0) {
+                close(fds[i]);
+                fds[i] = -1;
+                continue;
+            }
+            if (leader < 0) {
+                leader = fds[i];
+            }
+        }
+    }
+
+    if (!available()) {
+        reason = string("perf_event_open: ") + strerror(first_error);
+        if (first_error == ENOENT || first_error == EOPNOTSUPP) {
+            reason += " (no hardware PMU, e.g. inside a VM)";
+        } else if (first_error == EACCES || first_error == EPERM) {
+            reason += " (see /proc/sys/kernel/perf_event_paranoid)";
+        }
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (int fd : fds) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+}
+
+void PerfCounters::start() {
+    for (int leader : leaders) {
+        if (leader >= 0) {
+            ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+    }
+}
+
+void PerfCounters::pause() {
+    for (int leader : leaders) {
+        if (leader >= 0) {
+            ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        }
+    }
+}
+
+void PerfCounters::resume() {
+    for (int leader : leaders) {
+        if (leader >= 0) {
+            ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+    }
+}
+
+PerfReading PerfCounters::read() const {
+    PerfReading reading;
+    for (size_t group = 0; group < kGroupCount; group++) {
+        if (leaders[group] < 0) {
+            continue;
+        }
+
+        // PERF_FORMAT_GROUP layout: nr, time_enabled, time_running, then
+        // {value, id} per member
+        uint64_t buffer[3 + 2 * kPerfEventCount];
+        ssize_t got = ::read(leaders[group], buffer, sizeof(buffer));
+        if (got < static_cast<ssize_t>(3 * sizeof(uint64_t))) {
+            continue;
+        }
+        uint64_t members = buffer[0];
+        uint64_t enabled = buffer[1];
+        uint64_t running = buffer[2];
+        if (running == 0) {
+            // Enabled but never got onto the PMU: say so instead of
+            // reporting nothing
+            for (size_t i = 0; i < kPerfEventCount; i++) {
+                if (fds[i] >= 0 && kEvents[i].group == group && enabled > 0) {
+                    reading.never_ran[i] = true;
+                }
+            }
+            continue;
+        }
+        double scale = static_cast<double>(enabled) / running;
+
+        for (uint64_t m = 0; m < members && m < kPerfEventCount; m++) {
+            uint64_t value = buffer[3 + 2 * m];
+            uint64_t id = buffer[4 + 2 * m];
+            for (size_t i = 0; i < kPerfEventCount; i++) {
+                if (fds[i] >= 0 && ids[i] == id) {
+                    reading.values[i] = static_cast<uint64_t>(value * scale);
+                    reading.valid[i] = true;
+                    break;
+                }
+            }
+        }
+    }
+    return reading;
+}
+
+#else
+
+PerfCounters::PerfCounters() : reason("perf_event_open is only available on Linux") {
+    fds.fill(-1);
+    ids.fill(0);
+    leaders.fill(-1);
+}
+
+PerfCounters::~PerfCounters() {}
+
+void PerfCounters::start() {}
+void PerfCounters::pause() {}
+void PerfCounters::resume() {}
+
+PerfReading PerfCounters::read() const {
+    return PerfReading();
+}
+
+#endif
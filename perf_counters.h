@@ -0,0 +1,85 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+// ============================================
+// HARDWARE PERFORMANCE COUNTERS
+// ============================================
+
+// Events read around benchmark sections
+enum class PerfEvent : uint8_t {
+    Cycles,
+    Instructions,
+    L1DMisses,         // L1 data cache read misses
+    LLCMisses,         // Last-level cache read misses
+    BranchMisses,
+    DTLBMisses,        // Data TLB read misses
+    Count
+};
+
+constexpr size_t kPerfEventCount = static_cast<size_t>(PerfEvent::Count);
+
+const char* perfEventName(PerfEvent event);
+
+// Counter values of one measured interval. Events the machine (or the
+// kernel's perf_event_paranoid setting) does not allow stay invalid.
+// When the PMU had to multiplex, values are scaled to the full interval.
+// Events that were open but whose group the PMU never scheduled (all
+// counters taken, e.g. by the NMI watchdog) are invalid and never_ran.
+struct PerfReading {
+    std::array<uint64_t, kPerfEventCount> values{};
+    std::array<bool, kPerfEventCount> valid{};
+    std::array<bool, kPerfEventCount> never_ran{};
+
+    bool any() const;
+    uint64_t value(PerfEvent event) const { return values[static_cast<size_t>(event)]; }
+    bool has(PerfEvent event) const { return valid[static_cast<size_t>(event)]; }
+    bool neverRan(PerfEvent event) const { return never_ran[static_cast<size_t>(event)]; }
+};
+
+// perf_event_open groups counting user-space events of the calling thread
+// (other threads, such as the buffer cache flusher, are not counted).
+// Cycles, instructions and branch misses form one group and the cache/TLB
+// misses another: six events in one group can exceed the general-purpose
+// counters of many x86 cores, and a group that does not fit is never
+// scheduled at all. Opening never fails hard: events that cannot be
+// opened are left out, and if none can, available() is false and
+// unavailableReason() says why (no PMU in a VM, perf_event_paranoid,
+// not Linux, ...). Every call is then a no-op.
+//
+// Counting is off until start(); pause()/resume() bracket the measured
+// sections, so setup work between them is not counted.
+class PerfCounters {
+private:
+    static constexpr size_t kGroupCount = 2;
+
+    std::array<int, kPerfEventCount> fds;
+    std::array<uint64_t, kPerfEventCount> ids;    // Kernel IDs, to match group reads
+    std::array<int, kGroupCount> leaders;
+    std::string reason;
+
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const { return leaders[0] >= 0 || leaders[1] >= 0; }
+    bool available(PerfEvent event) const { return fds[static_cast<size_t>(event)] >= 0; }
+    const std::string& unavailableReason() const { return reason; }
+
+    // Zero every counter and start counting
+    void start();
+    void pause();
+    void resume();
+
+    // Totals since start() (counting may continue)
+    PerfReading read() const;
+};
+
+#endif // PERF_COUNTERS_H
@@ -2,83 +2,260 @@
 #define SINGLY_LINKED_LIST_CPP
 
 #include <iostream>
+#include <utility>
 #include "singly_linked_list.h"
 
+// Allocate and construct a node through the node allocator
+template <typename T, typename Allocator>
+template <typename... Args>
+Node<T>* SinglyLinkedList<T, Allocator>::createNode(Args&&... args) {
+    Node<T>* node = NodeTraits::allocate(node_allocator, 1);
+    try {
+        NodeTraits::construct(node_allocator, node, std::in_place, std::forward<Args>(args)...);
+    } catch (...) {
+        NodeTraits::deallocate(node_allocator, node, 1);
+        throw;
+    }
+    return node;
+}
+
+// Destroy a node and hand its storage back to the node allocator
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::destroyNode(Node<T>* node) {
+    NodeTraits::destroy(node_allocator, node);
+    NodeTraits::deallocate(node_allocator, node, 1);
+}
+
 // Check if list is empty
-template <typename T>
-bool SinglyLinkedList<T>::isEmpty() const {
+template <typename T, typename Allocator>
+bool SinglyLinkedList<T, Allocator>::isEmpty() const {
     return head == nullptr;
 }
     
 // Get size of list
-template <typename T>
-int SinglyLinkedList<T>::getSize() const {
+template <typename T, typename Allocator>
+int SinglyLinkedList<T, Allocator>::getSize() const {
     return size;
 }
     
-// Insert at beginning
-template <typename T>
-void SinglyLinkedList<T>::insertAtBeginning(T value) {
-    Node<T>* newNode = new Node<T>(value);
-        
+// Node at position (0 <= position < size), resuming from the cursor
+// when it is at or before position; leaves the cursor where it was
+template <typename T, typename Allocator>
+Node<T>* SinglyLinkedList<T, Allocator>::findNode(int position) const {
+    if (position == size - 1) {
+        return tail;
+    }
+    
+    Node<T>* current = head;
+    int index = 0;
+    if (cursor_node != nullptr && cursor_position <= position) {
+        current = cursor_node;
+        index = cursor_position;
+    }
+    while (index < position) {
+        current = current->next;
+        index++;
+    }
+    return current;
+}
+
+// findNode, then park the cursor on the result
+template <typename T, typename Allocator>
+Node<T>* SinglyLinkedList<T, Allocator>::nodeAt(int position) {
+    Node<T>* node = findNode(position);
+    if (position != size - 1) {
+        cursor_node = node;
+        cursor_position = position;
+    }
+    return node;
+}
+
+// Drop the cursor if a mutation at position moves or frees its node
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::invalidateFrom(int position) {
+    if (cursor_node != nullptr && cursor_position >= position) {
+        cursor_node = nullptr;
+    }
+}
+
+// Link helpers (linkAfter leaves cursor upkeep to the caller)
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::linkFront(Node<T>* node) {
+    invalidateFrom(0);
     if (isEmpty()) {
-        head = tail = newNode;
+        head = tail = node;
     } else {
-        newNode->next = head;
-        head = newNode;
+        node->next = head;
+        head = node;
     }
     size++;
 }
-    
-// Insert at end
-template <typename T>
-void SinglyLinkedList<T>::insertAtEnd(T value) {
-    Node<T>* newNode = new Node<T>(value);
-        
+
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::linkBack(Node<T>* node) {
     if (isEmpty()) {
-        head = tail = newNode;
+        head = tail = node;
     } else {
-        tail->next = newNode;
-        tail = newNode;
+        tail->next = node;
+        tail = node;
+    }
+    size++;
+}
+
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::linkAfter(Node<T>* previous, Node<T>* node) {
+    node->next = previous->next;
+    previous->next = node;
+    if (previous == tail) {
+        tail = node;
     }
     size++;
 }
+
+// Take over other's nodes, leaving it empty
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::stealFrom(SinglyLinkedList& other) {
+    invalidateFrom(0);
+    other.invalidateFrom(0);
+    head = other.head;
+    tail = other.tail;
+    size = other.size;
+    other.head = other.tail = nullptr;
+    other.size = 0;
+}
+
+// Copy constructor (deep copy)
+template <typename T, typename Allocator>
+SinglyLinkedList<T, Allocator>::SinglyLinkedList(const SinglyLinkedList& other)
+    : head(nullptr), tail(nullptr), size(0),
+      node_allocator(NodeTraits::select_on_container_copy_construction(other.node_allocator)),
+      cursor_node(nullptr), cursor_position(0) {
+    for (const T& value : other) {
+        emplaceBack(value);
+    }
+}
+
+// Move constructor (O(1))
+template <typename T, typename Allocator>
+SinglyLinkedList<T, Allocator>::SinglyLinkedList(SinglyLinkedList&& other) noexcept
+    : head(nullptr), tail(nullptr), size(0), node_allocator(std::move(other.node_allocator)),
+      cursor_node(nullptr), cursor_position(0) {
+    stealFrom(other);
+}
+
+// Copy assignment (deep copy)
+template <typename T, typename Allocator>
+SinglyLinkedList<T, Allocator>& SinglyLinkedList<T, Allocator>::operator=(const SinglyLinkedList& other) {
+    if (this != &other) {
+        clear();
+        if constexpr (NodeTraits::propagate_on_container_copy_assignment::value) {
+            node_allocator = other.node_allocator;
+        }
+        for (const T& value : other) {
+            emplaceBack(value);
+        }
+    }
+    return *this;
+}
+
+// Move assignment (O(1) unless the allocators cannot share nodes)
+template <typename T, typename Allocator>
+SinglyLinkedList<T, Allocator>& SinglyLinkedList<T, Allocator>::operator=(SinglyLinkedList&& other) {
+    if (this == &other) {
+        return *this;
+    }
+    clear();
+    if constexpr (NodeTraits::propagate_on_container_move_assignment::value) {
+        node_allocator = std::move(other.node_allocator);
+        stealFrom(other);
+    } else {
+        if (node_allocator == other.node_allocator) {
+            stealFrom(other);
+        } else {
+            for (T& value : other) {
+                emplaceBack(std::move(value));
+            }
+            other.clear();
+        }
+    }
+    return *this;
+}
+
+// Insert at beginning
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::insertAtBeginning(const T& value) {
+    linkFront(createNode(value));
+}
+
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::insertAtBeginning(T&& value) {
+    linkFront(createNode(std::move(value)));
+}
+
+// Insert at end
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::insertAtEnd(const T& value) {
+    linkBack(createNode(value));
+}
+
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::insertAtEnd(T&& value) {
+    linkBack(createNode(std::move(value)));
+}
+
+// Construct at beginning
+template <typename T, typename Allocator>
+template <typename... Args>
+T& SinglyLinkedList<T, Allocator>::emplaceFront(Args&&... args) {
+    linkFront(createNode(std::forward<Args>(args)...));
+    return head->data;
+}
+
+// Construct at end
+template <typename T, typename Allocator>
+template <typename... Args>
+T& SinglyLinkedList<T, Allocator>::emplaceBack(Args&&... args) {
+    linkBack(createNode(std::forward<Args>(args)...));
+    return tail->data;
+}
     
 // Insert at specific position (0-based index)
-template <typename T>
-void SinglyLinkedList<T>::insertAtPosition(T value, int position) {
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::insertAtPosition(const T& value, int position) {
+    if (position < 0 || position > size) {
+        std::cout << "Invalid position!" << std::endl;
+        return;
+    }
+    insertAtPosition(T(value), position);
+}
+
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::insertAtPosition(T&& value, int position) {
     if (position < 0 || position > size) {
         std::cout << "Invalid position!" << std::endl;
         return;
     }
         
     if (position == 0) {
-        insertAtBeginning(value);
+        insertAtBeginning(std::move(value));
     } else if (position == size) {
-        insertAtEnd(value);
+        insertAtEnd(std::move(value));
     } else {
-        Node<T>* newNode = new Node<T>(value);
-        Node<T>* current = head;
-            
-        // Traverse to position-1
-        for (int i = 0; i < position - 1; i++) {
-            current = current->next;
-        }
-            
-        newNode->next = current->next;
-        current->next = newNode;
-        size++;
+        Node<T>* current = nodeAt(position - 1);
+        invalidateFrom(position);
+        linkAfter(current, createNode(std::move(value)));
     }
 }
     
 // Delete from beginning
-template <typename T>
-void SinglyLinkedList<T>::deleteFromBeginning() {
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::deleteFromBeginning() {
     if (isEmpty()) {
         std::cout << "List is empty!" << std::endl;
         return;
     }
         
+    invalidateFrom(0);
     Node<T>* temp = head;
     head = head->next;
         
@@ -86,30 +263,27 @@ void SinglyLinkedList<T>::deleteFromBeginning() {
         tail = nullptr;
     }
         
-    delete temp;
+    destroyNode(temp);
     size--;
 }
     
 // Delete from end
-template <typename T>
-void SinglyLinkedList<T>::deleteFromEnd() {
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::deleteFromEnd() {
     if (isEmpty()) {
         std::cout << "List is empty!" << std::endl;
         return;
     }
         
+    invalidateFrom(size - 1);
     if (head == tail) { // Only one element
-        delete head;
+        destroyNode(head);
         head = tail = nullptr;
     } else {
-        Node<T>* current = head;
-            
-        // Traverse to second last node
-        while (current->next != tail) {
-            current = current->next;
-        }
+        // Second last node
+        Node<T>* current = nodeAt(size - 2);
             
-        delete tail;
+        destroyNode(tail);
         tail = current;
         tail->next = nullptr;
     }
@@ -117,8 +291,8 @@ void SinglyLinkedList<T>::deleteFromEnd() {
 }
     
 // Delete from specific position
-template <typename T>
-void SinglyLinkedList<T>::deleteFromPosition(int position) {
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::deleteFromPosition(int position) {
     if (position < 0 || position >= size) {
         std::cout << "Invalid position!" << std::endl;
         return;
@@ -129,24 +303,19 @@ void SinglyLinkedList<T>::deleteFromPosition(int position) {
     } else if (position == size - 1) {
         deleteFromEnd();
     } else {
-        Node<T>* current = head;
-        Node<T>* previous = nullptr;
-            
-        // Traverse to the position
-        for (int i = 0; i < position; i++) {
-            previous = current;
-            current = current->next;
-        }
+        Node<T>* previous = nodeAt(position - 1);
+        Node<T>* current = previous->next;
+        invalidateFrom(position);
             
         previous->next = current->next;
-        delete current;
+        destroyNode(current);
         size--;
     }
 }
     
 // Search for a value
-template <typename T>
-bool SinglyLinkedList<T>::search(T value) const {
+template <typename T, typename Allocator>
+bool SinglyLinkedList<T, Allocator>::search(const T& value) const {
     Node<T>* current = head;
         
     while (current != nullptr) {
@@ -159,69 +328,71 @@ bool SinglyLinkedList<T>::search(T value) const {
 }
     
 // Get value at position (returns copy)
-template <typename T>
-T SinglyLinkedList<T>::get(int position) const {
+template <typename T, typename Allocator>
+T SinglyLinkedList<T, Allocator>::get(int position) const {
     if (position < 0 || position >= size) {
         throw std::out_of_range("Position out of range");
     }
-        
-    Node<T>* current = head;
-    for (int i = 0; i < position; i++) {
-        current = current->next;
+    return findNode(position)->data;
+}
+
+template <typename T, typename Allocator>
+T SinglyLinkedList<T, Allocator>::get(int position) {
+    if (position < 0 || position >= size) {
+        throw std::out_of_range("Position out of range");
     }
-        
-    return current->data;
+    return nodeAt(position)->data;
 }
 
 // Get reference at position (returns reference)
-template <typename T>
-T& SinglyLinkedList<T>::getRef(int position) {
+template <typename T, typename Allocator>
+T& SinglyLinkedList<T, Allocator>::getRef(int position) {
     if (position < 0 || position >= size) {
         throw std::out_of_range("Position out of range");
     }
-        
-    Node<T>* current = head;
-    for (int i = 0; i < position; i++) {
-        current = current->next;
-    }
-        
-    return current->data;
+    return nodeAt(position)->data;
 }
 
 // Get const reference at position
-template <typename T>
-const T& SinglyLinkedList<T>::getConstRef(int position) const {
+template <typename T, typename Allocator>
+const T& SinglyLinkedList<T, Allocator>::getConstRef(int position) const {
     if (position < 0 || position >= size) {
         throw std::out_of_range("Position out of range");
     }
-        
-    Node<T>* current = head;
-    for (int i = 0; i < position; i++) {
-        current = current->next;
+    return findNode(position)->data;
+}
+
+template <typename T, typename Allocator>
+const T& SinglyLinkedList<T, Allocator>::getConstRef(int position) {
+    if (position < 0 || position >= size) {
+        throw std::out_of_range("Position out of range");
     }
-        
-    return current->data;
+    return nodeAt(position)->data;
 }
     
 // Update value at position
-template <typename T>
-void SinglyLinkedList<T>::update(int position, T newValue) {
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::update(int position, const T& newValue) {
     if (position < 0 || position >= size) {
         std::cout << "Invalid position!" << std::endl;
         return;
     }
-        
-    Node<T>* current = head;
-    for (int i = 0; i < position; i++) {
-        current = current->next;
+    getRef(position) = newValue;
+}
+
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::update(int position, T&& newValue) {
+    if (position < 0 || position >= size) {
+        std::cout << "Invalid position!" << std::endl;
+        return;
     }
-        
-    current->data = newValue;
+    getRef(position) = std::move(newValue);
 }
     
 // Reverse the linked list
-template <typename T>
-void SinglyLinkedList<T>::reverse() {
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::reverse() {
+    invalidateFrom(0);
     if (isEmpty() || head == tail) {
         return; // Empty or single element list
     }
@@ -243,16 +414,16 @@ void SinglyLinkedList<T>::reverse() {
 }
     
 // Clear the entire list
-template <typename T>
-void SinglyLinkedList<T>::clear() {
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::clear() {
     while (!isEmpty()) {
         deleteFromBeginning();
     }
 }
     
 // Display the list
-template <typename T>
-void SinglyLinkedList<T>::display() const {
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::display() const {
     if (isEmpty()) {
         std::cout << "List is empty!" << std::endl;
         return;
@@ -271,9 +442,384 @@ void SinglyLinkedList<T>::display() const {
 }
     
 // Display list size
-template <typename T>
-void SinglyLinkedList<T>::displaySize() const {
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::displaySize() const {
     std::cout << "Size: " << size << std::endl;
 }
 
+// Insert after the node at position (before_begin() inserts at the front)
+template <typename T, typename Allocator>
+typename SinglyLinkedList<T, Allocator>::iterator
+SinglyLinkedList<T, Allocator>::insert_after(const_iterator position, const T& value) {
+    return emplaceAfter(position, value);
+}
+
+template <typename T, typename Allocator>
+typename SinglyLinkedList<T, Allocator>::iterator
+SinglyLinkedList<T, Allocator>::insert_after(const_iterator position, T&& value) {
+    return emplaceAfter(position, std::move(value));
+}
+
+// Construct after the node at position
+template <typename T, typename Allocator>
+template <typename... Args>
+typename SinglyLinkedList<T, Allocator>::iterator
+SinglyLinkedList<T, Allocator>::emplaceAfter(const_iterator position, Args&&... args) {
+    if (position == cend()) {
+        throw std::out_of_range("Cannot insert after end()");
+    }
+    Node<T>* newNode = createNode(std::forward<Args>(args)...);
+    invalidateFrom(0);
+    if (position.before) {
+        linkFront(newNode);
+    } else {
+        linkAfter(position.node, newNode);
+    }
+    return iterator(newNode);
+}
+
+// Erase the node following position; returns the iterator after it
+// (end() when nothing follows, including for position == end())
+template <typename T, typename Allocator>
+typename SinglyLinkedList<T, Allocator>::iterator
+SinglyLinkedList<T, Allocator>::erase_after(const_iterator position) {
+    if (position == cend()) {
+        return end();
+    }
+    Node<T>* previous = position.before ? nullptr : position.node;
+    Node<T>* victim = previous ? previous->next : head;
+    if (victim == nullptr) {
+        return end();
+    }
+    invalidateFrom(0);
+    
+    if (previous) {
+        previous->next = victim->next;
+    } else {
+        head = victim->next;
+    }
+    if (victim == tail) {
+        tail = previous;
+    }
+    
+    Node<T>* following = victim->next;
+    destroyNode(victim);
+    size--;
+    return iterator(following);
+}
+
+// First element satisfying pred, or end()
+template <typename T, typename Allocator>
+template <typename Predicate>
+typename SinglyLinkedList<T, Allocator>::iterator
+SinglyLinkedList<T, Allocator>::findIf(Predicate pred) {
+    Node<T>* current = head;
+    while (current != nullptr && !pred(current->data)) {
+        current = current->next;
+    }
+    return iterator(current);
+}
+
+template <typename T, typename Allocator>
+template <typename Predicate>
+typename SinglyLinkedList<T, Allocator>::const_iterator
+SinglyLinkedList<T, Allocator>::findIf(Predicate pred) const {
+    Node<T>* current = head;
+    while (current != nullptr && !pred(static_cast<const T&>(current->data))) {
+        current = current->next;
+    }
+    return const_iterator(current);
+}
+
+// Predecessor of the first element satisfying pred (before_begin() when it
+// is the head), or end() when nothing matches
+template <typename T, typename Allocator>
+template <typename Predicate>
+typename SinglyLinkedList<T, Allocator>::iterator
+SinglyLinkedList<T, Allocator>::findBeforeIf(Predicate pred) {
+    iterator previous = before_begin();
+    for (Node<T>* current = head; current != nullptr; current = current->next) {
+        if (pred(current->data)) {
+            return previous;
+        }
+        previous = iterator(current);
+    }
+    return end();
+}
+
+// Number of elements satisfying pred
+template <typename T, typename Allocator>
+template <typename Predicate>
+int SinglyLinkedList<T, Allocator>::countIf(Predicate pred) const {
+    int count = 0;
+    for (Node<T>* current = head; current != nullptr; current = current->next) {
+        if (pred(static_cast<const T&>(current->data))) {
+            count++;
+        }
+    }
+    return count;
+}
+
+// Unlink and destroy every element satisfying pred in one pass
+template <typename T, typename Allocator>
+template <typename Predicate>
+int SinglyLinkedList<T, Allocator>::removeIf(Predicate pred) {
+    int removed = 0;
+    int position = 0;
+    Node<T>* previous = nullptr;
+    Node<T>* current = head;
+    
+    while (current != nullptr) {
+        Node<T>* next = current->next;
+        if (pred(current->data)) {
+            if (removed == 0) {
+                invalidateFrom(position);
+            }
+            if (previous) {
+                previous->next = next;
+            } else {
+                head = next;
+            }
+            if (current == tail) {
+                tail = previous;
+            }
+            destroyNode(current);
+            removed++;
+        } else {
+            previous = current;
+        }
+        current = next;
+        position++;
+    }
+    
+    size -= removed;
+    return removed;
+}
+
+// Unlink the nodes strictly between `before` (nullptr = before head) and
+// `stop` from other, as a chain whose nodes this list can free
+template <typename T, typename Allocator>
+typename SinglyLinkedList<T, Allocator>::Chain
+SinglyLinkedList<T, Allocator>::detachFrom(SinglyLinkedList& other, Node<T>* before, Node<T>* stop) {
+    Chain chain{before ? before->next : other.head, nullptr, 0};
+    if (chain.first == stop) {
+        return Chain{nullptr, nullptr, 0};
+    }
+    
+    chain.last = chain.first;
+    chain.count = 1;
+    while (chain.last->next != stop) {
+        chain.last = chain.last->next;
+        chain.count++;
+    }
+    
+    if (before) {
+        before->next = stop;
+    } else {
+        other.head = stop;
+    }
+    if (stop == nullptr) {
+        other.tail = before;
+    }
+    other.size -= chain.count;
+    other.invalidateFrom(0);
+    chain.last->next = nullptr;
+    
+    if (node_allocator == other.node_allocator) {
+        return chain;
+    }
+    
+    // Different allocators: move the elements into nodes of our own
+    Chain rebuilt{nullptr, nullptr, 0};
+    for (Node<T>* node = chain.first; node != nullptr;) {
+        Node<T>* next = node->next;
+        Node<T>* copy = createNode(std::move(node->data));
+        if (rebuilt.last) {
+            rebuilt.last->next = copy;
+        } else {
+            rebuilt.first = copy;
+        }
+        rebuilt.last = copy;
+        rebuilt.count++;
+        other.destroyNode(node);
+        node = next;
+    }
+    return rebuilt;
+}
+
+// Link a detached chain after previous (nullptr = at the front)
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::linkChainAfter(Node<T>* previous, const Chain& chain) {
+    if (chain.first == nullptr) {
+        return;
+    }
+    invalidateFrom(0);
+    if (previous) {
+        chain.last->next = previous->next;
+        previous->next = chain.first;
+    } else {
+        chain.last->next = head;
+        head = chain.first;
+    }
+    if (previous == tail) {
+        tail = chain.last;
+    }
+    size += chain.count;
+}
+
+// Move all of other's elements after position
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::splice_after(const_iterator position, SinglyLinkedList& other) {
+    if (&other == this) {
+        return;
+    }
+    if (position == cend()) {
+        throw std::out_of_range("Cannot splice after end()");
+    }
+    Node<T>* previous = position.before ? nullptr : position.node;
+    linkChainAfter(previous, detachFrom(other, nullptr, nullptr));
+}
+
+// Move the elements of other in the open range (first, last) after position
+// (O(length of the range))
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::splice_after(const_iterator position, SinglyLinkedList& other,
+                                                  const_iterator first, const_iterator last) {
+    if (position == cend()) {
+        throw std::out_of_range("Cannot splice after end()");
+    }
+    if (first == other.cend()) {
+        return;                          // Nothing follows end(): empty range
+    }
+    Node<T>* previous = position.before ? nullptr : position.node;
+    Node<T>* before = first.before ? nullptr : first.node;
+    linkChainAfter(previous, detachFrom(other, before, last.node));
+}
+
+// Move all of other's elements to the end (O(1) with a shared allocator)
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::spliceAtEnd(SinglyLinkedList& other) {
+    if (&other == this) {
+        return;
+    }
+    linkChainAfter(tail, detachFrom(other, nullptr, nullptr));
+}
+
+// Merge sorted other into this sorted list
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::merge(SinglyLinkedList& other) {
+    merge(other, [](const T& a, const T& b) { return a < b; });
+}
+
+template <typename T, typename Allocator>
+template <typename Compare>
+void SinglyLinkedList<T, Allocator>::merge(SinglyLinkedList& other, Compare less) {
+    if (&other == this) {
+        return;
+    }
+    Chain incoming = detachFrom(other, nullptr, nullptr);
+    if (incoming.first == nullptr) {
+        return;
+    }
+    invalidateFrom(0);
+    
+    // Equal elements keep this list's ones first
+    Node<T>* mine = head;
+    Node<T>* theirs = incoming.first;
+    Node<T>* merged_tail = nullptr;
+    head = nullptr;
+    while (mine && theirs) {
+        Node<T>* taken;
+        if (less(theirs->data, mine->data)) {
+            taken = theirs;
+            theirs = theirs->next;
+        } else {
+            taken = mine;
+            mine = mine->next;
+        }
+        if (merged_tail) {
+            merged_tail->next = taken;
+        } else {
+            head = taken;
+        }
+        merged_tail = taken;
+    }
+    
+    Node<T>* rest = mine ? mine : theirs;
+    if (merged_tail) {
+        merged_tail->next = rest;
+    } else {
+        head = rest;
+    }
+    if (theirs) {
+        tail = incoming.last;
+    }
+    size += incoming.count;
+}
+
+// Sort ascending
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::sort() {
+    sort([](const T& a, const T& b) { return a < b; });
+}
+
+// Bottom-up merge sort: merge adjacent runs of width 1, 2, 4, ... until a
+// single pass performs one merge
+template <typename T, typename Allocator>
+template <typename Compare>
+void SinglyLinkedList<T, Allocator>::sort(Compare less) {
+    if (size < 2) {
+        return;
+    }
+    invalidateFrom(0);
+    
+    for (int width = 1;; width *= 2) {
+        Node<T>* left = head;
+        Node<T>* merged_tail = nullptr;
+        int merges = 0;
+        head = nullptr;
+        
+        while (left) {
+            merges++;
+            Node<T>* right = left;
+            int left_size = 0;
+            while (left_size < width && right) {
+                right = right->next;
+                left_size++;
+            }
+            int right_size = width;
+            
+            while (left_size > 0 || (right_size > 0 && right)) {
+                Node<T>* taken;
+                if (left_size == 0) {
+                    taken = right;
+                    right = right->next;
+                    right_size--;
+                } else if (right_size == 0 || !right || !less(right->data, left->data)) {
+                    taken = left;
+                    left = left->next;
+                    left_size--;
+                } else {
+                    taken = right;
+                    right = right->next;
+                    right_size--;
+                }
+                if (merged_tail) {
+                    merged_tail->next = taken;
+                } else {
+                    head = taken;
+                }
+                merged_tail = taken;
+            }
+            left = right;
+        }
+        
+        merged_tail->next = nullptr;
+        tail = merged_tail;
+        if (merges <= 1) {
+            return;
+        }
+    }
+}
+
 #endif // SINGLY_LINKED_LIST_CPP
\ No newline at end of file
@@ -3,6 +3,13 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <iterator>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+#include <memory>
+#include <memory_resource>
+#include "node_pool_allocator.h"
 
 // Node structure
 template <typename T>
@@ -10,21 +17,137 @@ struct Node {
     T data;
     Node<T>* next;
     
-    // Constructor
-    Node(T value) : data(value), next(nullptr) {}
+    // Constructors
+    Node(const T& value) : data(value), next(nullptr) {}
+    Node(T&& value) : data(std::move(value)), next(nullptr) {}
+    
+    // Construct data in place from constructor arguments
+    template <typename... Args>
+    explicit Node(std::in_place_t, Args&&... args)
+        : data(std::forward<Args>(args)...), next(nullptr) {}
 };
 
 // SinglyLinkedList class template
-template <typename T>
+//
+// Nodes come from Allocator (rebound to Node<T>). The default std::allocator
+// gives plain new/delete per node; PooledSinglyLinkedList carves them from
+// per-list slabs and PmrSinglyLinkedList draws from any
+// std::pmr::memory_resource.
+template <typename T, typename Allocator = std::allocator<Node<T>>>
 class SinglyLinkedList {
 private:
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node<T>>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+    
     Node<T>* head;
     Node<T>* tail;
     int size;
+    NodeAllocator node_allocator;
+    
+    // Last (position, node) reached by a positional lookup on a non-const
+    // list; lets ascending index loops resume instead of restarting from
+    // head. Mutations drop it when they shift or unlink anything at or
+    // before cursor_position. Const lookups may start from it but never
+    // move it, so concurrent readers of a const list do not race.
+    Node<T>* cursor_node;
+    int cursor_position;
+    
+    Node<T>* findNode(int position) const;
+    Node<T>* nodeAt(int position);
+    void invalidateFrom(int position);
+    
+    template <typename... Args>
+    Node<T>* createNode(Args&&... args);
+    void destroyNode(Node<T>* node);
+    
+    // Link an already constructed node into the list (O(1))
+    void linkFront(Node<T>* node);
+    void linkBack(Node<T>* node);
+    void linkAfter(Node<T>* previous, Node<T>* node);
+    void stealFrom(SinglyLinkedList& other);
+    
+    // Run of nodes detached from a list
+    struct Chain {
+        Node<T>* first;
+        Node<T>* last;
+        int count;
+    };
+    Chain detachFrom(SinglyLinkedList& other, Node<T>* before, Node<T>* stop);
+    void linkChainAfter(Node<T>* previous, const Chain& chain);
+    
+    // Forward iterator; `before` is set only for before_begin() and points
+    // at the list's head pointer, so ++ lands on the first node
+    template <bool IsConst>
+    class BasicIterator {
+    private:
+        Node<T>* node;
+        Node<T>* const* before;
+        
+        friend class SinglyLinkedList;
+        
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::conditional<IsConst, const T*, T*>::type;
+        using reference = typename std::conditional<IsConst, const T&, T&>::type;
+        
+        BasicIterator(Node<T>* n = nullptr, Node<T>* const* head_link = nullptr)
+            : node(n), before(head_link) {}
+        
+        // iterator -> const_iterator
+        template <bool WasConst, typename = typename std::enable_if<IsConst && !WasConst>::type>
+        BasicIterator(const BasicIterator<WasConst>& other)
+            : node(other.node), before(other.before) {}
+        
+        reference operator*() const { return node->data; }
+        pointer operator->() const { return &node->data; }
+        
+        BasicIterator& operator++() {
+            if (before) {
+                node = *before;
+                before = nullptr;
+            } else {
+                node = node->next;
+            }
+            return *this;
+        }
+        
+        BasicIterator operator++(int) {
+            BasicIterator previous = *this;
+            ++(*this);
+            return previous;
+        }
+        
+        friend bool operator==(const BasicIterator& a, const BasicIterator& b) {
+            return a.node == b.node && a.before == b.before;
+        }
+        friend bool operator!=(const BasicIterator& a, const BasicIterator& b) {
+            return !(a == b);
+        }
+        
+        template <bool> friend class BasicIterator;
+    };
     
 public:
+    using iterator = BasicIterator<false>;
+    using const_iterator = BasicIterator<true>;
+    
     // Constructor
-    SinglyLinkedList() : head(nullptr), tail(nullptr), size(0) {}
+    SinglyLinkedList()
+        : head(nullptr), tail(nullptr), size(0), node_allocator(),
+          cursor_node(nullptr), cursor_position(0) {}
+    
+    // Constructor with an explicit allocator (e.g. a pmr resource)
+    explicit SinglyLinkedList(const Allocator& allocator)
+        : head(nullptr), tail(nullptr), size(0), node_allocator(allocator),
+          cursor_node(nullptr), cursor_position(0) {}
+    
+    // Copy (deep) and move (O(1), steals the nodes)
+    SinglyLinkedList(const SinglyLinkedList& other);
+    SinglyLinkedList(SinglyLinkedList&& other) noexcept;
+    SinglyLinkedList& operator=(const SinglyLinkedList& other);
+    SinglyLinkedList& operator=(SinglyLinkedList&& other);
     
     // Destructor
     ~SinglyLinkedList() {
@@ -33,23 +156,99 @@ public:
 
     bool isEmpty() const;
     int getSize() const;
-    void insertAtBeginning(T value);
-    void insertAtEnd(T value);
-    void insertAtPosition(T value, int position);
+    void insertAtBeginning(const T& value);
+    void insertAtBeginning(T&& value);
+    void insertAtEnd(const T& value);
+    void insertAtEnd(T&& value);
+    void insertAtPosition(const T& value, int position);
+    void insertAtPosition(T&& value, int position);
+    
+    // Construct the element in place; returns a reference to it
+    template <typename... Args>
+    T& emplaceFront(Args&&... args);
+    template <typename... Args>
+    T& emplaceBack(Args&&... args);
+    
     void deleteFromBeginning();
     void deleteFromEnd();
     void deleteFromPosition(int position);
-    bool search(T value) const;
+    bool search(const T& value) const;
+    // Positional access. The non-const overloads move the lookup cursor;
+    // the const ones only read it, so they are safe for concurrent readers
+    // but an ascending index loop over a const list stays O(n^2) - iterate.
     T get(int position) const;
-    T& getRef(int position);  // ADD THIS: returns reference
-    const T& getConstRef(int position) const;  // ADD THIS: returns const reference
-    void update(int position, T newValue);
+    T get(int position);
+    T& getRef(int position);
+    const T& getConstRef(int position) const;
+    const T& getConstRef(int position);
+    void update(int position, const T& newValue);
+    void update(int position, T&& newValue);
     void reverse();
     void clear();
     void display() const;
     void displaySize() const;
+    
+    // Iteration (O(1) per step)
+    iterator begin() { return iterator(head); }
+    iterator end() { return iterator(); }
+    const_iterator begin() const { return const_iterator(head); }
+    const_iterator end() const { return const_iterator(); }
+    const_iterator cbegin() const { return const_iterator(head); }
+    const_iterator cend() const { return const_iterator(); }
+    iterator before_begin() { return iterator(nullptr, &head); }
+    const_iterator before_begin() const { return const_iterator(nullptr, &head); }
+    const_iterator cbefore_begin() const { return const_iterator(nullptr, &head); }
+    
+    // Iterator-based insertion/removal (O(1)). Inserting after end() throws
+    // std::out_of_range; erasing after it does nothing and returns end().
+    iterator insert_after(const_iterator position, const T& value);
+    iterator insert_after(const_iterator position, T&& value);
+    template <typename... Args>
+    iterator emplaceAfter(const_iterator position, Args&&... args);
+    iterator erase_after(const_iterator position);
+    
+    // Predicate queries (single pass, no copies)
+    template <typename Predicate>
+    iterator findIf(Predicate pred);
+    template <typename Predicate>
+    const_iterator findIf(Predicate pred) const;
+    // Iterator before the first match (for erase_after), end() if none
+    template <typename Predicate>
+    iterator findBeforeIf(Predicate pred);
+    template <typename Predicate>
+    int countIf(Predicate pred) const;
+    // Unlink every match; returns how many were removed
+    template <typename Predicate>
+    int removeIf(Predicate pred);
+    
+    // Node transfer (no allocation when both lists' allocators compare
+    // equal, otherwise elements move into freshly allocated nodes)
+    void splice_after(const_iterator position, SinglyLinkedList& other);
+    void splice_after(const_iterator position, SinglyLinkedList& other,
+                      const_iterator first, const_iterator last);
+    void spliceAtEnd(SinglyLinkedList& other);
+    
+    // Stable merge of two sorted lists; other is left empty
+    void merge(SinglyLinkedList& other);
+    template <typename Compare>
+    void merge(SinglyLinkedList& other, Compare less);
+    
+    // Stable bottom-up merge sort, relinking nodes in place (O(n log n))
+    void sort();
+    template <typename Compare>
+    void sort(Compare less);
+    
+    Allocator get_allocator() const { return Allocator(node_allocator); }
 };
 
+// List whose nodes come from a std::pmr::memory_resource
+template <typename T>
+using PmrSinglyLinkedList = SinglyLinkedList<T, std::pmr::polymorphic_allocator<Node<T>>>;
+
+// List whose nodes come from a NodePool of its own (single-threaded use)
+template <typename T>
+using PooledSinglyLinkedList = SinglyLinkedList<T, NodePoolAllocator<Node<T>>>;
+
 // Include the implementation
 #include "singly_linked_list.cpp"
 
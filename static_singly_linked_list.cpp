@@ -0,0 +1,379 @@
+#ifndef STATIC_SINGLY_LINKED_LIST_CPP
+#define STATIC_SINGLY_LINKED_LIST_CPP
+
+#include <iostream>
+#include "static_singly_linked_list.h"
+
+// Take a slot from the free list, else from the never-used tail of the array
+template <typename T, size_t N>
+typename StaticSinglyLinkedList<T, N>::Index StaticSinglyLinkedList<T, N>::acquireSlot() {
+    if (free_head != npos) {
+        Index index = free_head;
+        free_head = slots[index].next;
+        return index;
+    }
+    if (high_water < N) {
+        return high_water++;
+    }
+    return npos;
+}
+
+// Return a slot to the free list
+template <typename T, size_t N>
+void StaticSinglyLinkedList<T, N>::releaseSlot(Index index) {
+    slots[index].next = free_head;
+    free_head = index;
+}
+
+// Slot at position (0 <= position < size)
+template <typename T, size_t N>
+typename StaticSinglyLinkedList<T, N>::Index StaticSinglyLinkedList<T, N>::indexAt(int position) const {
+    if (position == size - 1) {
+        return tail;
+    }
+    Index index = head;
+    for (int i = 0; i < position; i++) {
+        index = slots[index].next;
+    }
+    return index;
+}
+
+// Construct an element after previous (npos = at the front); npos if full
+template <typename T, size_t N>
+template <typename... Args>
+typename StaticSinglyLinkedList<T, N>::Index
+StaticSinglyLinkedList<T, N>::constructAfter(Index previous, Args&&... args) {
+    Index index = acquireSlot();
+    if (index == npos) {
+        return npos;
+    }
+    new (slots[index].storage) T(std::forward<Args>(args)...);
+
+    if (previous == npos) {
+        slots[index].next = head;
+        head = index;
+    } else {
+        slots[index].next = slots[previous].next;
+        slots[previous].next = index;
+    }
+    if (previous == tail) {
+        tail = index;
+    }
+    size++;
+    return index;
+}
+
+// Destroy the element after previous (npos = the head)
+template <typename T, size_t N>
+void StaticSinglyLinkedList<T, N>::destroyAfter(Index previous) {
+    Index victim = (previous == npos) ? head : slots[previous].next;
+    if (previous == npos) {
+        head = slots[victim].next;
+    } else {
+        slots[previous].next = slots[victim].next;
+    }
+    if (victim == tail) {
+        tail = previous;
+    }
+    at(victim).~T();
+    releaseSlot(victim);
+    size--;
+}
+
+// Copy constructor
+template <typename T, size_t N>
+StaticSinglyLinkedList<T, N>::StaticSinglyLinkedList(const StaticSinglyLinkedList& other)
+    : StaticSinglyLinkedList() {
+    for (const T& value : other) {
+        emplaceBack(value);
+    }
+}
+
+// Move constructor (element-wise)
+template <typename T, size_t N>
+StaticSinglyLinkedList<T, N>::StaticSinglyLinkedList(StaticSinglyLinkedList&& other)
+    : StaticSinglyLinkedList() {
+    for (T& value : other) {
+        emplaceBack(std::move(value));
+    }
+    other.clear();
+}
+
+// Copy assignment
+template <typename T, size_t N>
+StaticSinglyLinkedList<T, N>& StaticSinglyLinkedList<T, N>::operator=(const StaticSinglyLinkedList& other) {
+    if (this != &other) {
+        clear();
+        for (const T& value : other) {
+            emplaceBack(value);
+        }
+    }
+    return *this;
+}
+
+// Move assignment (element-wise)
+template <typename T, size_t N>
+StaticSinglyLinkedList<T, N>& StaticSinglyLinkedList<T, N>::operator=(StaticSinglyLinkedList&& other) {
+    if (this != &other) {
+        clear();
+        for (T& value : other) {
+            emplaceBack(std::move(value));
+        }
+        other.clear();
+    }
+    return *this;
+}
+
+// Check if list is empty
+template <typename T, size_t N>
+bool StaticSinglyLinkedList<T, N>::isEmpty() const {
+    return size == 0;
+}
+
+// Check if every slot is in use
+template <typename T, size_t N>
+bool StaticSinglyLinkedList<T, N>::full() const {
+    return static_cast<size_t>(size) == N;
+}
+
+// Get size of list
+template <typename T, size_t N>
+int StaticSinglyLinkedList<T, N>::getSize() const {
+    return size;
+}
+
+// Insert at beginning
+template <typename T, size_t N>
+bool StaticSinglyLinkedList<T, N>::insertAtBeginning(const T& value) {
+    return constructAfter(npos, value) != npos;
+}
+
+template <typename T, size_t N>
+bool StaticSinglyLinkedList<T, N>::insertAtBeginning(T&& value) {
+    return constructAfter(npos, std::move(value)) != npos;
+}
+
+// Insert at end
+template <typename T, size_t N>
+bool StaticSinglyLinkedList<T, N>::insertAtEnd(const T& value) {
+    return constructAfter(tail, value) != npos;
+}
+
+template <typename T, size_t N>
+bool StaticSinglyLinkedList<T, N>::insertAtEnd(T&& value) {
+    return constructAfter(tail, std::move(value)) != npos;
+}
+
+// Insert at specific position (0-based index)
+template <typename T, size_t N>
+bool StaticSinglyLinkedList<T, N>::insertAtPosition(const T& value, int position) {
+    if (position < 0 || position > size) {
+        return false;
+    }
+    Index previous = (position == 0) ? npos : indexAt(position - 1);
+    return constructAfter(previous, value) != npos;
+}
+
+template <typename T, size_t N>
+bool StaticSinglyLinkedList<T, N>::insertAtPosition(T&& value, int position) {
+    if (position < 0 || position > size) {
+        return false;
+    }
+    Index previous = (position == 0) ? npos : indexAt(position - 1);
+    return constructAfter(previous, std::move(value)) != npos;
+}
+
+// Construct at beginning
+template <typename T, size_t N>
+template <typename... Args>
+T* StaticSinglyLinkedList<T, N>::emplaceFront(Args&&... args) {
+    Index index = constructAfter(npos, std::forward<Args>(args)...);
+    return index == npos ? nullptr : &at(index);
+}
+
+// Construct at end
+template <typename T, size_t N>
+template <typename... Args>
+T* StaticSinglyLinkedList<T, N>::emplaceBack(Args&&... args) {
+    Index index = constructAfter(tail, std::forward<Args>(args)...);
+    return index == npos ? nullptr : &at(index);
+}
+
+// Delete from beginning
+template <typename T, size_t N>
+bool StaticSinglyLinkedList<T, N>::deleteFromBeginning() {
+    if (isEmpty()) {
+        return false;
+    }
+    destroyAfter(npos);
+    return true;
+}
+
+// Delete from end
+template <typename T, size_t N>
+bool StaticSinglyLinkedList<T, N>::deleteFromEnd() {
+    if (isEmpty()) {
+        return false;
+    }
+    destroyAfter(size == 1 ? npos : indexAt(size - 2));
+    return true;
+}
+
+// Delete from specific position
+template <typename T, size_t N>
+bool StaticSinglyLinkedList<T, N>::deleteFromPosition(int position) {
+    if (position < 0 || position >= size) {
+        return false;
+    }
+    destroyAfter(position == 0 ? npos : indexAt(position - 1));
+    return true;
+}
+
+// Search for a value
+template <typename T, size_t N>
+bool StaticSinglyLinkedList<T, N>::search(const T& value) const {
+    for (const T& item : *this) {
+        if (item == value) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Get value at position (returns copy)
+template <typename T, size_t N>
+T StaticSinglyLinkedList<T, N>::get(int position) const {
+    return getConstRef(position);
+}
+
+// Get reference at position
+template <typename T, size_t N>
+T& StaticSinglyLinkedList<T, N>::getRef(int position) {
+    if (position < 0 || position >= size) {
+        throw std::out_of_range("Position out of range");
+    }
+    return at(indexAt(position));
+}
+
+// Get const reference at position
+template <typename T, size_t N>
+const T& StaticSinglyLinkedList<T, N>::getConstRef(int position) const {
+    if (position < 0 || position >= size) {
+        throw std::out_of_range("Position out of range");
+    }
+    return at(indexAt(position));
+}
+
+// Update value at position
+template <typename T, size_t N>
+bool StaticSinglyLinkedList<T, N>::update(int position, const T& newValue) {
+    if (position < 0 || position >= size) {
+        return false;
+    }
+    at(indexAt(position)) = newValue;
+    return true;
+}
+
+template <typename T, size_t N>
+bool StaticSinglyLinkedList<T, N>::update(int position, T&& newValue) {
+    if (position < 0 || position >= size) {
+        return false;
+    }
+    at(indexAt(position)) = std::move(newValue);
+    return true;
+}
+
+// Reverse the linked list
+template <typename T, size_t N>
+void StaticSinglyLinkedList<T, N>::reverse() {
+    Index previous = npos;
+    Index current = head;
+    tail = head;
+    while (current != npos) {
+        Index next = slots[current].next;
+        slots[current].next = previous;
+        previous = current;
+        current = next;
+    }
+    head = previous;
+}
+
+// Clear the entire list (slots are reset, so the list starts fresh)
+template <typename T, size_t N>
+void StaticSinglyLinkedList<T, N>::clear() {
+    for (Index index = head; index != npos; index = slots[index].next) {
+        at(index).~T();
+    }
+    head = tail = free_head = npos;
+    high_water = 0;
+    size = 0;
+}
+
+// Display the list
+template <typename T, size_t N>
+void StaticSinglyLinkedList<T, N>::display() const {
+    if (isEmpty()) {
+        std::cout << "List is empty!" << std::endl;
+        return;
+    }
+
+    std::cout << "List: ";
+    for (Index index = head; index != npos; index = slots[index].next) {
+        std::cout << at(index);
+        if (slots[index].next != npos) {
+            std::cout << " -> ";
+        }
+    }
+    std::cout << std::endl;
+}
+
+// Display list size
+template <typename T, size_t N>
+void StaticSinglyLinkedList<T, N>::displaySize() const {
+    std::cout << "Size: " << size << "/" << N << std::endl;
+}
+
+// Insert after the element at position (before_begin() inserts at the front)
+template <typename T, size_t N>
+typename StaticSinglyLinkedList<T, N>::iterator
+StaticSinglyLinkedList<T, N>::insert_after(const_iterator position, const T& value) {
+    return emplaceAfter(position, value);
+}
+
+template <typename T, size_t N>
+typename StaticSinglyLinkedList<T, N>::iterator
+StaticSinglyLinkedList<T, N>::insert_after(const_iterator position, T&& value) {
+    return emplaceAfter(position, std::move(value));
+}
+
+// Construct after the element at position; end() when full or when
+// position is end()
+template <typename T, size_t N>
+template <typename... Args>
+typename StaticSinglyLinkedList<T, N>::iterator
+StaticSinglyLinkedList<T, N>::emplaceAfter(const_iterator position, Args&&... args) {
+    if (position == cend()) {
+        return end();
+    }
+    Index previous = position.before ? npos : position.index;
+    return iterator(this, constructAfter(previous, std::forward<Args>(args)...));
+}
+
+// Erase the element following position; returns the iterator after it
+template <typename T, size_t N>
+typename StaticSinglyLinkedList<T, N>::iterator
+StaticSinglyLinkedList<T, N>::erase_after(const_iterator position) {
+    if (position == cend()) {
+        return end();
+    }
+    Index previous = position.before ? npos : position.index;
+    Index victim = (previous == npos) ? head : slots[previous].next;
+    if (victim == npos) {
+        return end();
+    }
+    Index following = slots[victim].next;
+    destroyAfter(previous);
+    return iterator(this, following);
+}
+
+#endif // STATIC_SINGLY_LINKED_LIST_CPP
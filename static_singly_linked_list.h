@@ -0,0 +1,185 @@
+#ifndef STATIC_SINGLY_LINKED_LIST_H
+#define STATIC_SINGLY_LINKED_LIST_H
+
+#include <iostream>
+#include <stdexcept>
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+// StaticSinglyLinkedList class template
+//
+// Fixed-capacity SinglyLinkedList for deterministic (RTOS) code: all N
+// nodes live in an inline array, links are array indices, and free slots
+// form an index free list. Nothing touches the heap and every insert or
+// delete at the ends is O(1) with no allocator call.
+//
+// Differences from SinglyLinkedList:
+// - inserts return false (emplace/insert_after return nullptr/end()) when
+//   the list is full or the position is invalid; deletes and update return
+//   false when there is nothing to do. None of them throw or print.
+// - get/getRef/getConstRef still throw std::out_of_range, as before.
+// - moving is element-wise (the storage is inline).
+template <typename T, size_t N>
+class StaticSinglyLinkedList {
+    static_assert(N > 0, "capacity must be positive");
+
+public:
+    using Index = typename std::conditional<(N < 0xFFFF), uint16_t, uint32_t>::type;
+    static constexpr Index npos = static_cast<Index>(~Index(0));
+
+private:
+    struct Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+        Index next;
+    };
+
+    Slot slots[N];
+    Index head;
+    Index tail;
+    Index free_head;     // Recycled slots
+    Index high_water;    // Slots [high_water, N) have never been used
+    int size;
+
+    T& at(Index index) { return *std::launder(reinterpret_cast<T*>(slots[index].storage)); }
+    const T& at(Index index) const { return *std::launder(reinterpret_cast<const T*>(slots[index].storage)); }
+
+    Index acquireSlot();
+    void releaseSlot(Index index);
+    Index indexAt(int position) const;
+    template <typename... Args>
+    Index constructAfter(Index previous, Args&&... args);
+    void destroyAfter(Index previous);
+
+    template <bool IsConst>
+    class BasicIterator {
+    private:
+        using ListPtr = typename std::conditional<IsConst, const StaticSinglyLinkedList*,
+                                                  StaticSinglyLinkedList*>::type;
+        ListPtr list;
+        Index index;
+        bool before;
+
+        friend class StaticSinglyLinkedList;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::conditional<IsConst, const T*, T*>::type;
+        using reference = typename std::conditional<IsConst, const T&, T&>::type;
+
+        BasicIterator(ListPtr l = nullptr, Index i = npos, bool before_begin = false)
+            : list(l), index(i), before(before_begin) {}
+
+        // iterator -> const_iterator
+        template <bool WasConst, typename = typename std::enable_if<IsConst && !WasConst>::type>
+        BasicIterator(const BasicIterator<WasConst>& other)
+            : list(other.list), index(other.index), before(other.before) {}
+
+        reference operator*() const { return list->at(index); }
+        pointer operator->() const { return &list->at(index); }
+
+        BasicIterator& operator++() {
+            if (before) {
+                index = list->head;
+                before = false;
+            } else {
+                index = list->slots[index].next;
+            }
+            return *this;
+        }
+
+        BasicIterator operator++(int) {
+            BasicIterator previous = *this;
+            ++(*this);
+            return previous;
+        }
+
+        friend bool operator==(const BasicIterator& a, const BasicIterator& b) {
+            return a.index == b.index && a.before == b.before;
+        }
+        friend bool operator!=(const BasicIterator& a, const BasicIterator& b) {
+            return !(a == b);
+        }
+
+        template <bool> friend class BasicIterator;
+    };
+
+public:
+    using iterator = BasicIterator<false>;
+    using const_iterator = BasicIterator<true>;
+
+    // Constructor (O(1): slots are handed out lazily)
+    StaticSinglyLinkedList()
+        : head(npos), tail(npos), free_head(npos), high_water(0), size(0) {}
+
+    // Copy and move are element-wise
+    StaticSinglyLinkedList(const StaticSinglyLinkedList& other);
+    StaticSinglyLinkedList(StaticSinglyLinkedList&& other);
+    StaticSinglyLinkedList& operator=(const StaticSinglyLinkedList& other);
+    StaticSinglyLinkedList& operator=(StaticSinglyLinkedList&& other);
+
+    // Destructor
+    ~StaticSinglyLinkedList() {
+        clear();
+    }
+
+    static constexpr size_t capacity() { return N; }
+    bool isEmpty() const;
+    bool full() const;
+    int getSize() const;
+    bool insertAtBeginning(const T& value);
+    bool insertAtBeginning(T&& value);
+    bool insertAtEnd(const T& value);
+    bool insertAtEnd(T&& value);
+    bool insertAtPosition(const T& value, int position);
+    bool insertAtPosition(T&& value, int position);
+
+    // Construct in place; nullptr when full
+    template <typename... Args>
+    T* emplaceFront(Args&&... args);
+    template <typename... Args>
+    T* emplaceBack(Args&&... args);
+
+    bool deleteFromBeginning();
+    bool deleteFromEnd();
+    bool deleteFromPosition(int position);
+    bool search(const T& value) const;
+    T get(int position) const;
+    T& getRef(int position);
+    const T& getConstRef(int position) const;
+    bool update(int position, const T& newValue);
+    bool update(int position, T&& newValue);
+    void reverse();
+    void clear();
+    void display() const;
+    void displaySize() const;
+
+    // Iteration
+    iterator begin() { return iterator(this, head); }
+    iterator end() { return iterator(this); }
+    const_iterator begin() const { return const_iterator(this, head); }
+    const_iterator end() const { return const_iterator(this); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    iterator before_begin() { return iterator(this, npos, true); }
+    const_iterator before_begin() const { return const_iterator(this, npos, true); }
+    const_iterator cbefore_begin() const { return before_begin(); }
+
+    // Iterator-based insertion/removal (O(1)); insert_after returns end() when
+    // full or when position is end(), and erase_after(end()) does nothing
+    iterator insert_after(const_iterator position, const T& value);
+    iterator insert_after(const_iterator position, T&& value);
+    template <typename... Args>
+    iterator emplaceAfter(const_iterator position, Args&&... args);
+    iterator erase_after(const_iterator position);
+};
+
+// Include the implementation
+#include "static_singly_linked_list.cpp"
+
+#endif // STATIC_SINGLY_LINKED_LIST_H
@@ -1,10 +1,26 @@
 #include "fat_file_system.h"
+#include "uring_block_device.h"
+#include "mapped_block_device.h"
 #include <iostream>
 #include <cassert>
 #include <vector>
 #include <string>
 #include <cstring>
 #include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <future>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <atomic>
+
+#if defined(__cpp_impl_coroutine)
+#include <coroutine>
+#endif
 
 using namespace std;
 
@@ -18,14 +34,16 @@ private:
     string test_name;
     int test_count;
     int passed_count;
+    static inline int failed_total = 0;     // Across every suite, for main's exit status
     
 public:
-    FATTestHarness(const string& name, size_t disk_kb = 1024, size_t cluster_size = 1024)
+    FATTestHarness(const string& name, size_t disk_kb = 1024, size_t cluster_size = 1024,
+                   shared_ptr<BlockDevice> device = nullptr)
         : test_name(name), test_count(0), passed_count(0) {
         cout << "\n" << string(60, '=') << endl;
         cout << "TEST SUITE: " << test_name << endl;
         cout << string(60, '=') << endl;
-        fs = make_unique<FATFileSystem>(disk_kb, cluster_size);
+        fs = make_unique<FATFileSystem>(disk_kb, cluster_size, "RTOS_FS", device);
     }
     
     template<typename Func>
@@ -40,11 +58,15 @@ public:
             passed_count++;
         } catch (const exception& e) {
             cout << "✗ FAILED: " << e.what() << endl;
+            failed_total++;
         } catch (...) {
             cout << "✗ FAILED: Unknown error" << endl;
+            failed_total++;
         }
     }
     
+    static int failedTotal() { return failed_total; }
+    
     void printSummary() {
         cout << "\n" << string(60, '=') << endl;
         cout << "TEST SUMMARY: " << test_name << endl;
@@ -64,6 +86,120 @@ public:
     FATFileSystem* getFS() { return fs.get(); }
 };
 
+// Slow fake device: every block write costs `write_delay`, and the
+// order of written blocks is recorded
+class SlowBlockDevice : public MemoryBlockDevice {
+private:
+    chrono::milliseconds write_delay;
+    mutable mutex log_mutex;
+    vector<size_t> write_log;
+    
+public:
+    SlowBlockDevice(size_t block_size, size_t blocks, int delay_ms)
+        : MemoryBlockDevice(block_size, blocks), write_delay(delay_ms) {}
+    
+    bool writeBlock(size_t block, const void* data) override {
+        this_thread::sleep_for(write_delay);
+        {
+            lock_guard<mutex> lock(log_mutex);
+            write_log.push_back(block);
+        }
+        return MemoryBlockDevice::writeBlock(block, data);
+    }
+    
+    vector<size_t> getWriteLog() const {
+        lock_guard<mutex> lock(log_mutex);
+        return write_log;
+    }
+    
+    void clearWriteLog() {
+        lock_guard<mutex> lock(log_mutex);
+        write_log.clear();
+    }
+};
+
+// Fake device whose transfers can be held mid-flight, to line up races
+// deterministically: while held, every block read (or write too) waits.
+// A held read has already copied the block, as if its caller were
+// descheduled right after the transfer.
+class GatedBlockDevice : public MemoryBlockDevice {
+private:
+    mutex gate_mutex;
+    condition_variable gate_cv;
+    bool holding = false;
+    bool holding_writes = false;
+    int waiting = 0;
+    
+    void pass(bool is_write) {
+        unique_lock<mutex> lock(gate_mutex);
+        if (!holding || (is_write && !holding_writes)) return;
+        waiting++;
+        gate_cv.notify_all();
+        gate_cv.wait(lock, [this]() { return !holding; });
+        waiting--;
+    }
+    
+public:
+    using MemoryBlockDevice::MemoryBlockDevice;
+    
+    void hold(bool writes_too = true) {
+        lock_guard<mutex> lock(gate_mutex);
+        holding = true;
+        holding_writes = writes_too;
+    }
+    
+    void release() {
+        lock_guard<mutex> lock(gate_mutex);
+        holding = false;
+        gate_cv.notify_all();
+    }
+    
+    // Returns once some transfer is stuck at the gate
+    void waitUntilHeld() {
+        unique_lock<mutex> lock(gate_mutex);
+        gate_cv.wait(lock, [this]() { return waiting > 0; });
+    }
+    
+    bool readBlock(size_t block, void* buffer) override {
+        bool ok = MemoryBlockDevice::readBlock(block, buffer);
+        pass(false);
+        return ok;
+    }
+    
+    bool writeBlock(size_t block, const void* data) override {
+        pass(true);
+        return MemoryBlockDevice::writeBlock(block, data);
+    }
+};
+
+#if defined(__cpp_impl_coroutine)
+// Minimal eagerly started coroutine; `finished` is ready once it returns
+struct AsyncTask {
+    struct promise_type {
+        promise<void> done;
+        
+        AsyncTask get_return_object() { return AsyncTask{done.get_future()}; }
+        suspend_never initial_suspend() noexcept { return {}; }
+        suspend_never final_suspend() noexcept { return {}; }
+        void return_void() { done.set_value(); }
+        void unhandled_exception() { done.set_exception(current_exception()); }
+    };
+    
+    future<void> finished;
+};
+
+AsyncTask roundTripThroughAwaitables(FATFileSystem& fs, bool& created, string& readback) {
+    created = co_await fs.createFileAwaitable("coro.dat", 0);
+    int handle = fs.openFile("coro.dat", "w");
+    string text = "written from a coroutine";
+    size_t written = co_await fs.writeAwaitable(handle, text.data(), text.size());
+    fs.seekFile(handle, 0);
+    readback.assign(written, '\0');
+    readback.resize(co_await fs.readAwaitable(handle, &readback[0], readback.size()));
+    fs.closeFile(handle);
+}
+#endif
+
 // ============================================
 // COMPREHENSIVE TEST CASES
 // ============================================
@@ -275,6 +411,53 @@ void testFileSystemIntegrity() {
         cout << "  Directory tree displayed" << endl;
     });
     
+    harness.runTest("FS info counters agree with a full scan", [&]() {
+        FATFileSystem* fs = harness.getFS();
+        auto matchesScan = [fs]() {
+            FATFileSystem::FSInfo counted = fs->getFileSystemInfo();
+            FATFileSystem::FSInfo scanned = fs->scanFileSystemInfo();
+            return counted.total_space == scanned.total_space &&
+                   counted.free_space == scanned.free_space &&
+                   counted.used_space == scanned.used_space &&
+                   counted.total_files == scanned.total_files &&
+                   counted.total_directories == scanned.total_directories &&
+                   counted.bad_clusters == scanned.bad_clusters;
+        };
+        assert(matchesScan());
+        
+        FATFileSystem::FSInfo before = fs->getFileSystemInfo();
+        assert(fs->createDirectory("/counters") == true);
+        assert(fs->createFile("/counters/a.bin", 5000) == true);
+        assert(fs->copyFile("/counters/a.bin", "/counters/b.bin") == true);
+        assert(fs->createFile("/counters/a.bin", 10) == false);       // Exists: no change
+        assert(fs->deleteDirectory("/counters/a.bin") == false);      // Not a directory
+        assert(fs->createFile("/counters/huge.bin", 1 << 30) == false);
+        
+        FATFileSystem::FSInfo after = fs->getFileSystemInfo();
+        assert(after.total_files == before.total_files + 2);
+        assert(after.total_directories == before.total_directories + 1);
+        assert(after.free_space == before.free_space - (2 * 10 + 1) * 512);
+        assert(matchesScan());
+        
+        // Growing a file through writes allocates clusters too
+        int handle = fs->openFile("/counters/grown.bin", "w");
+        vector<char> data(3000, 'g');
+        assert(fs->writeFile(handle, data.data(), data.size()) == data.size());
+        fs->closeFile(handle);
+        assert(matchesScan());
+        
+        assert(fs->deleteFile("/counters/a.bin") == true);
+        assert(fs->deleteFile("/counters/b.bin") == true);
+        assert(fs->deleteFile("/counters/grown.bin") == true);
+        assert(fs->deleteDirectory("/counters") == true);
+        after = fs->getFileSystemInfo();
+        assert(after.total_files == before.total_files);
+        assert(after.total_directories == before.total_directories);
+        assert(after.free_space == before.free_space);
+        assert(after.bad_clusters == 2);
+        assert(matchesScan());
+    });
+    
     harness.printSummary();
 }
 
@@ -395,6 +578,997 @@ void testEdgeCases() {
     harness.printSummary();
 }
 
+void testFileIOAndWriteBack() {
+    // 256 KB volume of 1 KB clusters: 1 FAT block + 256 data blocks
+    auto device = make_shared<SlowBlockDevice>(1024, 257, 5);
+    FATTestHarness harness("File I/O and Write-Back Cache", 256, 1024, device);
+    
+    WriteBackPolicy lazy;
+    lazy.max_dirty_age_ms = 60000;  // Only explicit syncs write back
+    harness.getFS()->setWriteBackPolicy(lazy);
+    device->clearWriteLog();
+    
+    vector<char> payload(8 * 1024);
+    for (size_t i = 0; i < payload.size(); i++) {
+        payload[i] = static_cast<char>('a' + i % 26);
+    }
+    int handle = -1;
+    
+    harness.runTest("Write returns once data is cached", [&]() {
+        handle = harness.getFS()->openFile("data.bin", "w");
+        assert(handle > 0);
+        
+        size_t written = harness.getFS()->writeFile(handle, payload.data(), payload.size());
+        
+        assert(written == payload.size());
+        assert(device->getWriteLog().empty());
+        assert(harness.getFS()->getDirtyClusterCount() >= 8);
+    });
+    
+    harness.runTest("Read back through the cache", [&]() {
+        vector<char> readback(payload.size());
+        assert(harness.getFS()->seekFile(handle, 0) == true);
+        assert(harness.getFS()->readFile(handle, readback.data(), readback.size()) == payload.size());
+        assert(readback == payload);
+    });
+    
+    harness.runTest("syncFile writes sorted blocks to the device", [&]() {
+        assert(harness.getFS()->syncFile(handle) == true);
+        
+        vector<size_t> log = device->getWriteLog();
+        assert(log.size() >= 9);  // 8 data clusters + FAT block
+        for (size_t i = 1; i < log.size(); i++) {
+            assert(log[i - 1] < log[i]);
+        }
+        assert(harness.getFS()->getDirtyClusterCount() == 0);
+    });
+    
+    harness.runTest("Data survives on the device", [&]() {
+        // The first data cluster of the file follows the FAT block
+        vector<char> block(1024);
+        bool found = false;
+        for (size_t b = 1; b < device->getBlockCount() && !found; b++) {
+            device->readBlock(b, block.data());
+            found = equal(block.begin(), block.end(), payload.begin());
+        }
+        assert(found);
+        assert(harness.getFS()->closeFile(handle) == true);
+    });
+    
+    harness.runTest("Background flusher honours the age threshold", [&]() {
+        WriteBackPolicy eager;
+        eager.max_dirty_age_ms = 20;
+        eager.flush_interval_ms = 10;
+        harness.getFS()->setWriteBackPolicy(eager);
+        
+        int h = harness.getFS()->openFile("aged.bin", "w");
+        assert(harness.getFS()->writeFile(h, payload.data(), 1024) == 1024);
+        assert(harness.getFS()->getDirtyClusterCount() > 0);
+        
+        for (int i = 0; i < 100 && harness.getFS()->getDirtyClusterCount() > 0; i++) {
+            this_thread::sleep_for(chrono::milliseconds(10));
+        }
+        assert(harness.getFS()->getDirtyClusterCount() == 0);
+        harness.getFS()->closeFile(h);
+    });
+    
+    harness.runTest("Open files cannot be deleted", [&]() {
+        int h = harness.getFS()->openFile("data.bin", "r");
+        assert(harness.getFS()->deleteFile("data.bin") == false);
+        assert(harness.getFS()->writeFile(h, payload.data(), 10) == 0);
+        harness.getFS()->closeFile(h);
+        assert(harness.getFS()->deleteFile("data.bin") == true);
+    });
+    
+    harness.runTest("syncAll of an unchanged volume writes nothing", [&]() {
+        assert(harness.getFS()->syncAll() == true);
+        device->clearWriteLog();
+        
+        int h = harness.getFS()->openFile("aged.bin", "r");
+        char byte = 0;
+        assert(harness.getFS()->readFile(h, &byte, 1) == 1);
+        harness.getFS()->closeFile(h);
+        assert(harness.getFS()->syncAll() == true);
+        assert(device->getWriteLog().empty());
+    });
+    
+    harness.runTest("Block rewritten after a discard during a flush stays dirty", [&]() {
+        auto gated = make_shared<GatedBlockDevice>(1024, 16);
+        WriteBackPolicy manual;
+        manual.background_flush = false;
+        BufferCache cache(gated, manual);
+        vector<uint8_t> old_data(1024, 'o');
+        vector<uint8_t> new_data(1024, 'n');
+        assert(cache.write(7, 0, old_data.data(), old_data.size()));
+        
+        // The flush snapshots block 7, then stalls in the device while the
+        // block's cluster is freed and reused with one fresh write
+        gated->hold();
+        auto flush = async(launch::async, [&cache]() { return cache.flushAll(); });
+        gated->waitUntilHeld();
+        cache.discard(7);
+        assert(cache.write(7, 0, new_data.data(), new_data.size()));
+        gated->release();
+        
+        assert(flush.get() == true);
+        assert(cache.getDirtyCount() == 1);
+        assert(cache.flushAll());
+        vector<uint8_t> stored(1024);
+        gated->readBlock(7, stored.data());
+        assert(stored == new_data);
+    });
+    
+    harness.runTest("Cache fill racing a write-back does not keep stale data", [&]() {
+        auto gated = make_shared<GatedBlockDevice>(1024, 16);
+        WriteBackPolicy manual;
+        manual.background_flush = false;
+        BufferCache cache(gated, manual);
+        vector<uint8_t> old_data(1024, 'o');
+        vector<uint8_t> new_data(1024, 'n');
+        
+        // Each fill reads the old contents, then stalls while the block is
+        // rewritten, written back and evicted
+        auto rewrite = [&](uint8_t fill_byte) {
+            gated->waitUntilHeld();
+            new_data.assign(1024, fill_byte);
+            assert(cache.write(7, 0, new_data.data(), new_data.size()));
+            assert(cache.flushAll());
+            cache.discard(7);
+            gated->release();
+        };
+        
+        gated->writeBlock(7, old_data.data());
+        gated->hold(false);
+        auto reading = async(launch::async, [&cache]() {
+            uint8_t byte = 0;
+            assert(cache.read(7, 0, &byte, 1));
+            return byte;
+        });
+        rewrite('n');
+        assert(reading.get() == 'n');
+        cache.discard(7);
+        
+        gated->writeBlock(7, old_data.data());
+        gated->hold(false);
+        auto prefetching = async(launch::async, [&cache]() { cache.prefetch({7}); });
+        rewrite('p');
+        prefetching.get();
+        uint8_t byte = 0;
+        assert(cache.read(7, 0, &byte, 1));
+        assert(byte == 'p');
+    });
+    
+    harness.runTest("closeFile waits for a read still using the handle", [&]() {
+        auto gated = make_shared<GatedBlockDevice>(1024, 65);
+        FATFileSystem fs(64, 1024, "GATED", gated);
+        string text(3000, 'g');
+        int h = fs.openFile("pinned.dat", "w");
+        assert(fs.writeFile(h, text.data(), text.size()) == text.size());
+        assert(fs.seekFile(h, 0) == true);
+        fs.setWriteBackPolicy(WriteBackPolicy());   // Empty cache: the read goes to the device
+        
+        gated->hold();
+        string readback(text.size(), '\0');
+        auto reading = async(launch::async, [&]() {
+            return fs.readFile(h, &readback[0], readback.size());
+        });
+        gated->waitUntilHeld();
+        auto closing = async(launch::async, [&]() { return fs.closeFile(h); });
+        
+        // Until the read is done the handle stays open and protects the file
+        assert(closing.wait_for(chrono::milliseconds(20)) == future_status::timeout);
+        assert(fs.deleteFile("pinned.dat") == false);
+        gated->release();
+        
+        assert(reading.get() == text.size());
+        assert(readback == text);
+        assert(closing.get() == true);
+        assert(fs.deleteFile("pinned.dat") == true);
+    });
+    
+    harness.printSummary();
+}
+
+void testAsynchronousIO() {
+    FATTestHarness harness("Asynchronous I/O", 1024, 1024);
+    
+    harness.runTest("createFileAsync resolves its future", [&]() {
+        auto created = harness.getFS()->createFileAsync("async.dat", 0);
+        assert(created.get() == true);
+        assert(harness.getFS()->fileExists("async.dat") == true);
+        assert(harness.getFS()->createFileAsync("async.dat", 0).get() == false);
+    });
+    
+    harness.runTest("Many writes in flight on separate handles", [&]() {
+        const int files = 16;
+        vector<string> payloads;
+        vector<int> handles;
+        vector<future<size_t>> pending;
+        
+        for (int i = 0; i < files; i++) {
+            payloads.push_back(string(3000, static_cast<char>('A' + i)));
+            handles.push_back(harness.getFS()->openFile("inflight" + to_string(i) + ".dat", "w"));
+            assert(handles.back() > 0);
+        }
+        for (int i = 0; i < files; i++) {
+            pending.push_back(harness.getFS()->writeAsync(handles[i], payloads[i].data(), payloads[i].size()));
+        }
+        for (auto& result : pending) {
+            assert(result.get() == 3000);
+        }
+        
+        for (int i = 0; i < files; i++) {
+            string readback(3000, '\0');
+            assert(harness.getFS()->seekFile(handles[i], 0) == true);
+            assert(harness.getFS()->readAsync(handles[i], &readback[0], readback.size()).get() == 3000);
+            assert(readback == payloads[i]);
+            harness.getFS()->closeFile(handles[i]);
+        }
+    });
+    
+    harness.runTest("Completion callbacks fire", [&]() {
+        int handle = harness.getFS()->openFile("callback.dat", "w");
+        promise<size_t> written;
+        harness.getFS()->writeAsync(handle, "hello", 5, [&](size_t n) { written.set_value(n); });
+        assert(written.get_future().get() == 5);
+        harness.getFS()->closeFile(handle);
+    });
+    
+#if defined(__cpp_impl_coroutine)
+    harness.runTest("co_await create, write and read", [&]() {
+        bool created = false;
+        string readback;
+        roundTripThroughAwaitables(*harness.getFS(), created, readback).finished.get();
+        assert(created == true);
+        assert(readback == "written from a coroutine");
+    });
+#endif
+    
+    harness.printSummary();
+}
+
+void testUringImageDevice() {
+    const string image = "fat_test_uring.img";
+    // 256 KB volume of 1 KB clusters: 1 FAT block + 256 data blocks
+    auto device = make_shared<UringBlockDevice>(image, 1024, 257);
+    FATTestHarness harness("io_uring Image Device", 256, 1024, device);
+    
+    harness.runTest("Device opens (io_uring or pread fallback)", [&]() {
+        assert(device->isOpen());
+        cout << "  io_uring: " << (device->usingIoUring() ? "yes" : "no, using pread/pwrite") << endl;
+    });
+    
+    harness.runTest("Batched write-back and cold re-read", [&]() {
+        string payload(20 * 1024, '\0');
+        for (size_t i = 0; i < payload.size(); i++) {
+            payload[i] = static_cast<char>(i * 7);
+        }
+        
+        int handle = harness.getFS()->openFile("uring.bin", "w");
+        assert(harness.getFS()->writeFile(handle, payload.data(), payload.size()) == payload.size());
+        assert(harness.getFS()->syncFile(handle) == true);
+        
+        // A fresh cache forces the read to come from the image file
+        harness.getFS()->setWriteBackPolicy(WriteBackPolicy());
+        string readback(payload.size(), '\0');
+        assert(harness.getFS()->seekFile(handle, 0) == true);
+        assert(harness.getFS()->readFile(handle, &readback[0], readback.size()) == payload.size());
+        assert(readback == payload);
+        harness.getFS()->closeFile(handle);
+    });
+    
+    harness.printSummary();
+    remove(image.c_str());
+}
+
+void testMappedVolume() {
+    const string image = "fat_test_mapped.img";
+    auto device = make_shared<MappedBlockDevice>(image, 1024,
+                                                 FATFileSystem::requiredDeviceBlocks(256, 1024));
+    FATTestHarness harness("Memory-Mapped Volume", 256, 1024, device);
+    string payload(5000, 'm');
+    
+    harness.runTest("Image maps", [&]() {
+        assert(device->isOpen());
+        assert(device->mappedBlock(0) != nullptr);
+    });
+    
+    harness.runTest("Writes land in the mapping, not the cache", [&]() {
+        int handle = harness.getFS()->openFile("firmware.bin", "w");
+        assert(harness.getFS()->writeFile(handle, payload.data(), payload.size()) == payload.size());
+        assert(harness.getFS()->getDirtyClusterCount() == 0);
+        assert(harness.getFS()->syncFile(handle) == true);
+        harness.getFS()->closeFile(handle);
+    });
+    
+    harness.runTest("Streaming read straight from the mapping", [&]() {
+        int handle = harness.getFS()->openFile("firmware.bin", "r");
+        string readback(payload.size(), '\0');
+        assert(harness.getFS()->readFile(handle, &readback[0], readback.size()) == payload.size());
+        assert(readback == payload);
+        harness.getFS()->closeFile(handle);
+    });
+    
+    harness.runTest("Image file holds the data", [&]() {
+        ifstream in(image, ios::binary);
+        string contents((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+        assert(contents.find(payload) != string::npos);
+    });
+    
+    harness.runTest("Existing image mounts with its files intact", [&]() {
+        const string firmware = "fat_test_firmware.img";
+        size_t blocks = FATFileSystem::requiredDeviceBlocks(256, 1024);
+        size_t free_before = 0;
+        {
+            auto writer = make_shared<MappedBlockDevice>(firmware, 1024, blocks);
+            FATFileSystem fs(256, 1024, "FIRMWARE", writer);
+            int handle = fs.openFile("loader.bin", "w");
+            assert(fs.writeFile(handle, payload.data(), payload.size()) == payload.size());
+            fs.closeFile(handle);
+            assert(fs.createDirectory("config") == true);
+            for (int i = 0; i < 40; i++) {      // More records than one root cluster holds
+                assert(fs.createFile("part" + to_string(i) + ".cfg", 100) == true);
+            }
+            assert(fs.syncAll() == true);
+            free_before = fs.getFileSystemInfo().free_space;
+        }
+        
+        auto reader = make_shared<MappedBlockDevice>(firmware, 1024, blocks);
+        FATFileSystem fs(256, 1024, "", reader, true);
+        assert(fs.getFileSystemInfo().free_space == free_before);
+        assert(fs.getFileSystemInfo().total_files == 41);
+        assert(fs.isDirectory("config") == true);
+        assert(fs.fileExists("part39.cfg") == true);
+        
+        int handle = fs.openFile("loader.bin", "r");
+        string readback(payload.size(), '\0');
+        assert(fs.readFile(handle, &readback[0], readback.size()) == payload.size());
+        assert(readback == payload);
+        fs.closeFile(handle);
+        remove(firmware.c_str());
+    });
+    
+    harness.runTest("A synced file survives without syncAll", [&]() {
+        const string live = "fat_test_live.img";
+        const string crashed = "fat_test_crashed.img";
+        size_t blocks = FATFileSystem::requiredDeviceBlocks(256, 1024);
+        {
+            auto writer = make_shared<MappedBlockDevice>(live, 1024, blocks);
+            FATFileSystem fs(256, 1024, "LIVE", writer);
+            int handle = fs.openFile("journal.log", "w");
+            assert(fs.writeFile(handle, payload.data(), payload.size()) == payload.size());
+            assert(fs.syncFile(handle) == true);
+            
+            // Snapshot the image as a crash here would leave it
+            ifstream in(live, ios::binary);
+            ofstream out(crashed, ios::binary);
+            out << in.rdbuf();
+        }
+        
+        auto reader = make_shared<MappedBlockDevice>(crashed, 1024, blocks);
+        FATFileSystem fs(256, 1024, "", reader, true);
+        int handle = fs.openFile("journal.log", "r");
+        assert(handle > 0);
+        string readback(payload.size() + 1, '\0');
+        assert(fs.readFile(handle, &readback[0], readback.size()) == payload.size());
+        assert(readback.compare(0, payload.size(), payload) == 0);
+        fs.closeFile(handle);
+        remove(live.c_str());
+        remove(crashed.c_str());
+    });
+    
+    harness.runTest("Mounting an unformatted image is refused", [&]() {
+        const string blank = "fat_test_blank.img";
+        auto device = make_shared<MappedBlockDevice>(blank, 1024,
+                                                     FATFileSystem::requiredDeviceBlocks(256, 1024));
+        bool refused = false;
+        try {
+            FATFileSystem fs(256, 1024, "", device, true);
+        } catch (const invalid_argument&) {
+            refused = true;
+        }
+        assert(refused);
+        remove(blank.c_str());
+    });
+    
+    harness.runTest("An existing image of the wrong size is refused, not resized", [&]() {
+        const string small = "fat_test_small.img";
+        {
+            ofstream out(small, ios::binary);
+            out << string(100, 's');
+        }
+        MappedBlockDevice device(small, 1024, FATFileSystem::requiredDeviceBlocks(256, 1024));
+        assert(!device.isOpen());
+        ifstream in(small, ios::binary | ios::ate);
+        assert(in.tellg() == 100);
+        remove(small.c_str());
+    });
+    
+    harness.runTest("Read-only image mounts and is left untouched", [&]() {
+        const string sealed = "fat_test_readonly.img";
+        size_t blocks = FATFileSystem::requiredDeviceBlocks(256, 1024);
+        auto image_bytes = [&]() {
+            ifstream in(sealed, ios::binary);
+            return string((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+        };
+        assert(!MappedBlockDevice(sealed, 1024, blocks, true).isOpen());   // Never created
+        {
+            auto writer = make_shared<MappedBlockDevice>(sealed, 1024, blocks);
+            FATFileSystem fs(256, 1024, "SEALED", writer);
+            int handle = fs.openFile("loader.bin", "w");
+            assert(fs.writeFile(handle, payload.data(), payload.size()) == payload.size());
+            fs.closeFile(handle);
+        }
+        string before = image_bytes();
+        
+        // Reading a read-write mount leaves nothing to write back on unmount
+        {
+            auto reader = make_shared<MappedBlockDevice>(sealed, 1024, blocks);
+            FATFileSystem fs(256, 1024, "", reader, true);
+            int handle = fs.openFile("loader.bin", "r");
+            string readback(payload.size(), '\0');
+            assert(fs.readFile(handle, &readback[0], readback.size()) == payload.size());
+            fs.closeFile(handle);
+        }
+        assert(image_bytes() == before);
+        
+        {
+            auto reader = make_shared<MappedBlockDevice>(sealed, 1024, blocks, true);
+            assert(reader->isOpen() && reader->isReadOnly());
+            assert(reader->mappedBlock(0) == nullptr);
+            vector<uint8_t> block(1024, 0);
+            assert(reader->writeBlock(0, block.data()) == false);
+            
+            FATFileSystem fs(256, 1024, "", reader, true);
+            int handle = fs.openFile("loader.bin", "r");
+            string readback(payload.size(), '\0');
+            assert(fs.readFile(handle, &readback[0], readback.size()) == payload.size());
+            assert(readback == payload);
+            fs.closeFile(handle);
+            
+            handle = fs.openFile("loader.bin", "w");
+            fs.writeFile(handle, "patched", 7);
+            fs.closeFile(handle);
+            assert(fs.syncAll() == false);
+        }
+        assert(image_bytes() == before);
+        remove(sealed.c_str());
+    });
+    
+    harness.printSummary();
+    remove(image.c_str());
+}
+
+void testLatencyStats() {
+    FATTestHarness harness("Per-Operation Latency Statistics");
+    FATFileSystem* fs = harness.getFS();
+    
+    harness.runTest("Histogram buckets cover every value", []() {
+        uint64_t last_limit = 0;
+        for (size_t i = 0; i < LatencyHistogram::kBucketCount; i++) {
+            uint64_t limit = LatencyHistogram::bucketLimit(i);
+            assert(limit > last_limit);
+            assert(LatencyHistogram::bucketIndex(last_limit) == i);
+            assert(LatencyHistogram::bucketIndex(limit - 1) == i);
+            last_limit = limit;
+        }
+        assert(LatencyHistogram::bucketIndex(UINT64_MAX) == LatencyHistogram::kBucketCount - 1);
+    });
+    
+    harness.runTest("Percentiles stay within one bucket of the samples", []() {
+        LatencyHistogram histogram;
+        for (uint64_t v = 1; v <= 1000; v++) {
+            histogram.record(v);
+        }
+        LatencyHistogram::Snapshot snap = histogram.snapshot();
+        snap.ns_per_tick = 1.0;
+        assert(snap.count == 1000);
+        assert(snap.percentileNs(0.5) >= 500 && snap.percentileNs(0.5) <= 500 * 1.125);
+        assert(snap.percentileNs(0.99) >= 990 && snap.percentileNs(0.99) <= 990 * 1.125);
+        assert(snap.maxNs() >= 1000 && snap.maxNs() <= 1000 * 1.125);
+        
+        histogram.reset();
+        assert(histogram.snapshot().count == 0);
+    });
+    
+    harness.runTest("Operations are counted per call", [fs]() {
+        fs->resetStats();
+        fs->createFile("stats_a.txt", 100);
+        fs->createFile("stats_b.txt", 100);
+        fs->createFile("stats_a.txt", 100);   // Fails, still timed
+        fs->fileExists("stats_a.txt");
+        int handle = fs->openFile("stats_b.txt", "r");
+        char buffer[16];
+        fs->readFile(handle, buffer, sizeof(buffer));
+        fs->closeFile(handle);
+        fs->deleteFile("stats_a.txt");
+        
+        vector<FATFileSystem::OperationStats> stats = fs->getStats();
+        assert(stats.size() == kFsOperationCount);
+        auto count = [&stats](FsOperation op) {
+            const FATFileSystem::OperationStats& entry = stats[static_cast<size_t>(op)];
+            assert(entry.operation == op);
+            return entry.latency.count;
+        };
+        
+#if FAT_FS_STATS
+        assert(count(FsOperation::CreateFile) == 3);
+        assert(count(FsOperation::OpenFile) == 1);
+        assert(count(FsOperation::ReadFile) == 1);
+        assert(count(FsOperation::CloseFile) == 1);
+        assert(count(FsOperation::DeleteFile) == 1);
+        assert(count(FsOperation::WriteFile) == 0);
+        assert(count(FsOperation::FileExists) >= 1);
+        
+        const FATFileSystem::OperationStats& create = stats[static_cast<size_t>(FsOperation::CreateFile)];
+        assert(string(create.name) == "createFile");
+        assert(create.latency.percentileNs(0.5) > 0);
+        assert(create.latency.maxNs() >= create.latency.percentileNs(0.5));
+        cout << "createFile p50 " << create.latency.percentileNs(0.5)
+             << " ns, max " << create.latency.maxNs() << " ns" << endl;
+#else
+        assert(count(FsOperation::CreateFile) == 0);
+#endif
+        
+        fs->resetStats();
+        for (const FATFileSystem::OperationStats& entry : fs->getStats()) {
+            assert(entry.latency.count == 0);
+        }
+    });
+    
+    harness.printSummary();
+}
+
+void testEventLog() {
+    FATTestHarness harness("Event Log");
+    FATFileSystem* fs = harness.getFS();
+    
+    harness.runTest("Operations log events instead of printing", [fs]() {
+        fs->readLog();   // Discard construction events
+        
+        streambuf* console = cout.rdbuf();
+        ostringstream captured;
+        cout.rdbuf(captured.rdbuf());
+        fs->createFile("log_a.txt", 100);
+        fs->createFile("log_a.txt", 100);
+        fs->deleteFile("missing.txt");
+        fs->copyFile("log_a.txt", "log_b.txt");
+        cout.rdbuf(console);
+        assert(captured.str().empty());
+        
+        vector<fs_log::Record> records = fs->readLog();
+#if FAT_FS_LOG_LEVEL <= 2
+        assert(records.size() >= 4);
+        assert(records[0].event == fs_log::Event::FileCreated);
+        assert(records[0].level == fs_log::Level::Info);
+        assert(records[0].message() == "Created file: log_a.txt (size: 100 bytes, clusters: 1)");
+        assert(records[1].event == fs_log::Event::FileAlreadyExists);
+        assert(records[1].level == fs_log::Level::Warn);
+        assert(records[2].message() == "Error: File not found: missing.txt");
+        assert(records.back().message() == "Copied file: log_a.txt -> log_b.txt");
+        for (size_t i = 1; i < records.size(); i++) {
+            assert(records[i].sequence == records[i - 1].sequence + 1);
+        }
+#endif
+        assert(fs->readLog().empty());
+    });
+    
+    harness.runTest("drainLog formats pending events", [fs]() {
+        fs->createDirectory("/logdir");
+        ostringstream out;
+        size_t drained = fs->drainLog(out);
+#if FAT_FS_LOG_LEVEL <= 2
+        assert(drained == 1);
+        assert(out.str() == "Created directory: /logdir\n");
+#else
+        assert(drained == 0);
+#endif
+    });
+    
+    harness.runTest("Full ring keeps the newest events", []() {
+        fs_log::LogRing ring(8);
+        assert(ring.capacity() == 8);
+        for (int i = 0; i < 20; i++) {
+            ring.record(fs_log::Level::Warn, fs_log::Event::InvalidHandle, "", "", i);
+        }
+        vector<fs_log::Record> records = ring.read();
+        assert(records.size() == 8);
+        assert(records.front().args[0] == 12 && records.back().args[0] == 19);
+        assert(ring.dropped() == 12);
+        assert(records.back().message() == "Error: Invalid file handle: 19");
+    });
+    
+    harness.runTest("Long paths are truncated, not overflowed", []() {
+        fs_log::LogRing ring(4);
+        string path(300, 'p');
+        ring.record(fs_log::Level::Info, fs_log::Event::FileCopied, path, path);
+        vector<fs_log::Record> records = ring.read();
+        assert(records.size() == 1);
+        assert(records[0].text[0].size() + records[0].text[1].size() == fs_log::LogRing::kTextBytes);
+        assert(records[0].text[1].size() == fs_log::LogRing::kTextBytes / 2);
+    });
+    
+    harness.runTest("Concurrent writers with a reader", []() {
+        fs_log::LogRing ring(64);
+        atomic<bool> done{false};
+        size_t seen = 0;
+        thread reader([&]() {
+            while (!done.load()) {
+                for (const fs_log::Record& record : ring.read()) {
+                    assert(record.event == fs_log::Event::FileDeleted);
+                    assert(record.text[0] == "writer-file");
+                    seen++;
+                }
+            }
+        });
+        vector<thread> writers;
+        for (int t = 0; t < 4; t++) {
+            writers.emplace_back([&ring]() {
+                for (int i = 0; i < 5000; i++) {
+                    ring.record(fs_log::Level::Info, fs_log::Event::FileDeleted, "writer-file", "");
+                }
+            });
+        }
+        for (thread& w : writers) {
+            w.join();
+        }
+        done = true;
+        reader.join();
+        seen += ring.read().size();
+        assert(ring.recorded() == 20000);
+        assert(seen + ring.dropped() == 20000);
+    });
+    
+    harness.printSummary();
+}
+
+void testStructuredErrors() {
+    FATTestHarness harness("Structured Error Codes", 64, 1024);
+    FATFileSystem* fs = harness.getFS();
+    
+    harness.runTest("Namespace errors are distinguishable", [fs]() {
+        assert(fs->tryCreateFile("err_a.txt", 100));
+        assert(fs->tryCreateFile("err_a.txt", 100).error() == FsError::AlreadyExists);
+        assert(fs->tryDeleteFile("missing.txt").error() == FsError::NotFound);
+        assert(fs->tryCopyFile("missing.txt", "x.txt").error() == FsError::NotFound);
+        assert(fs->tryCopyFile("err_a.txt", "err_a.txt").error() == FsError::AlreadyExists);
+        
+        assert(fs->tryCreateDirectory("/err_dir"));
+        assert(fs->tryCreateDirectory("/err_dir").error() == FsError::AlreadyExists);
+        assert(fs->tryDeleteFile("/err_dir").error() == FsError::IsDirectory);
+        assert(fs->tryDeleteDirectory("err_a.txt").error() == FsError::NotDirectory);
+        assert(fs->tryDeleteDirectory("/nowhere").error() == FsError::NotFound);
+        assert(fs->tryDeleteDirectory("/err_dir"));
+        
+        assert(toErrno(FsError::AlreadyExists) == EEXIST);
+        assert(toErrno(FsError::NoSpace) == ENOSPC);
+        assert(string(fsErrorName(FsError::NotFound)) == "not found");
+    });
+    
+    harness.runTest("Out of space is reported as NoSpace", [fs]() {
+        FsResult<void> huge = fs->tryCreateFile("huge.bin", 1024 * 1024);
+        assert(!huge && huge.error() == FsError::NoSpace);
+        assert(!fs->createFile("huge.bin", 1024 * 1024));   // Bool wrapper agrees
+    });
+    
+    harness.runTest("Handle errors and results", [fs]() {
+        FsResult<int> opened = fs->tryOpenFile("err_a.txt", "r");
+        assert(opened.ok() && opened.value() > 0);
+        int handle = opened.value();
+        
+        assert(fs->tryDeleteFile("err_a.txt").error() == FsError::Busy);
+        char buffer[8] = {};
+        assert(fs->tryWriteFile(handle, buffer, sizeof(buffer)).error() == FsError::NotWritable);
+        FsResult<size_t> read = fs->tryReadFile(handle, buffer, sizeof(buffer));
+        assert(read.ok() && read.value() == sizeof(buffer));
+        assert(fs->trySeekFile(handle, 1 << 20).error() == FsError::InvalidArgument);
+        assert(fs->tryCloseFile(handle));
+        
+        assert(fs->tryCloseFile(handle).error() == FsError::BadHandle);
+        assert(fs->tryReadFile(handle, buffer, sizeof(buffer)).error() == FsError::BadHandle);
+        assert(fs->trySyncFile(handle).error() == FsError::BadHandle);
+        assert(fs->tryOpenFile("missing.txt", "r").error() == FsError::NotFound);
+        assert(fs->openFile("missing.txt", "r") == -1);
+        
+        bool threw = false;
+        try {
+            fs->tryOpenFile("missing.txt", "r").value();
+        } catch (const logic_error&) {
+            threw = true;
+        }
+        assert(threw);
+    });
+    
+    harness.printSummary();
+}
+
+void testTracing() {
+    FATTestHarness harness("Chrome Trace Export");
+    FATFileSystem* fs = harness.getFS();
+    
+    harness.runTest("Spans are only recorded while tracing", []() {
+        fs_trace::clear();
+        {
+            fs_trace::Span idle("idle", "test");
+        }
+        assert(fs_trace::spanCount() == 0);
+        
+        fs_trace::start();
+        {
+            fs_trace::Span outer("outer", "test");
+            fs_trace::Span inner("inner", "test");
+        }
+        fs_trace::stop();
+        assert(fs_trace::spanCount() == 2);
+    });
+    
+    harness.runTest("Per-thread buffers are exported together", []() {
+        fs_trace::clear();
+        fs_trace::start();
+        vector<thread> threads;
+        for (int t = 0; t < 3; t++) {
+            threads.emplace_back([]() {
+                for (int i = 0; i < 100; i++) {
+                    fs_trace::Span span("work", "test");
+                }
+            });
+        }
+        for (thread& t : threads) {
+            t.join();
+        }
+        fs_trace::stop();
+        assert(fs_trace::spanCount() == 300);
+        
+        ostringstream json;
+        assert(fs_trace::writeChromeTrace(json) == 300);
+        string text = json.str();
+        assert(text.rfind("{\"traceEvents\":[", 0) == 0);
+        assert(text.find("\"ph\":\"X\"") != string::npos);
+        assert(text.find("\"name\":\"work\"") != string::npos);
+        fs_trace::clear();
+        assert(fs_trace::spanCount() == 0);
+    });
+    
+    harness.runTest("File system operations emit spans when compiled in", [fs]() {
+        fs_trace::clear();
+        fs_trace::start();
+        fs->createFile("trace_a.txt", 4096);
+        int handle = fs->openFile("trace_a.txt", "r");
+        char buffer[64];
+        fs->readFile(handle, buffer, sizeof(buffer));
+        fs->closeFile(handle);
+        fs->deleteFile("trace_a.txt");
+        fs_trace::stop();
+        
+        ostringstream json;
+        size_t spans = fs_trace::writeChromeTrace(json);
+#if FAT_FS_TRACE
+        string text = json.str();
+        for (const char* name : {"createFile", "findFreeCluster", "getClusterChain",
+                                 "readFile", "resolvePath", "deleteFile"}) {
+            assert(text.find(string("\"name\":\"") + name + "\"") != string::npos);
+        }
+        assert(spans > 6);
+#else
+        assert(spans == 0);
+#endif
+        fs_trace::clear();
+    });
+    
+    harness.printSummary();
+}
+
+void testWorkloadReplay() {
+    FATTestHarness harness("Workload Record and Replay", 1024, 1024);
+    FATFileSystem* fs = harness.getFS();
+    const string trace_path = "fat_replay_test.trace";
+    
+    harness.runTest("Only the caller's calls are recorded", [&]() {
+        assert(fs->startRecording(trace_path) == true);
+        assert(fs->createDirectory("/logs") == true);
+        
+        // openFile("w") creates the file internally: one record, not two
+        int handle = fs->openFile("/logs/app.log", "w");
+        assert(handle >= 0);
+        char line[300];
+        memset(line, 'x', sizeof(line));
+        assert(fs->writeFile(handle, line, sizeof(line)) == sizeof(line));
+        assert(fs->seekFile(handle, 0) == true);
+        assert(fs->readFile(handle, line, 100) == 100);
+        fs->closeFile(handle);
+        
+        assert(fs->createFile("data.bin", 3000) == true);
+        assert(fs->copyFile("data.bin", "data_copy.bin") == true);
+        assert(fs->deleteFile("data.bin") == true);
+        assert(fs->deleteFile("missing.bin") == false);
+        fs->stopRecording();
+        
+        // Calls after stopRecording() are not part of the trace
+        assert(fs->createFile("untracked.bin", 100) == true);
+    });
+    
+    harness.runTest("Trace loads with geometry and call sequence", [&]() {
+        WorkloadTrace trace;
+        assert(trace.load(trace_path) == true);
+        assert(trace.volume_kb == 1024);
+        assert(trace.cluster_size == 1024);
+        
+        vector<FsOperation> expected = {
+            FsOperation::CreateDirectory, FsOperation::OpenFile, FsOperation::WriteFile,
+            FsOperation::SeekFile, FsOperation::ReadFile, FsOperation::CloseFile,
+            FsOperation::CreateFile, FsOperation::CopyFile, FsOperation::DeleteFile,
+            FsOperation::DeleteFile};
+        assert(trace.calls.size() == expected.size());
+        for (size_t i = 0; i < expected.size(); i++) {
+            assert(trace.calls[i].operation == expected[i]);
+            if (i > 0) {
+                assert(trace.calls[i].time_ns >= trace.calls[i - 1].time_ns);
+            }
+        }
+        assert(trace.calls[1].path == "/logs/app.log" && trace.calls[1].path2 == "w");
+        assert(trace.calls[2].number == 300);
+        assert(trace.calls[2].handle == trace.calls[1].handle);
+        assert(trace.calls[6].number == 3000);
+        assert(trace.calls[7].path2 == "data_copy.bin");
+        
+        WorkloadTrace missing;
+        assert(missing.load("no_such_file.trace") == false);
+    });
+    
+    harness.runTest("Replay onto a volume with another geometry", [&]() {
+        WorkloadTrace trace;
+        assert(trace.load(trace_path) == true);
+        
+        FATFileSystem replica(2048, 512, "REPLICA");
+        ReplayResult result = replayWorkload(replica, trace);
+        assert(result.calls == trace.calls.size());
+        assert(result.failures == 1);            // The recorded failing delete
+        
+        assert(replica.isDirectory("/logs") == true);
+        assert(replica.fileExists("/logs/app.log") == true);
+        assert(replica.fileExists("data_copy.bin") == true);
+        assert(replica.fileExists("data.bin") == false);
+        assert(replica.fileExists("untracked.bin") == false);
+        
+        int handle = replica.openFile("/logs/app.log", "r");
+        char buffer[400];
+        assert(replica.readFile(handle, buffer, sizeof(buffer)) == 300);
+        replica.closeFile(handle);
+    });
+    
+    harness.runTest("Truncated traces are rejected", [&]() {
+        ifstream in(trace_path, ios::binary);
+        string bytes((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+        in.close();
+        
+        const string truncated_path = "fat_replay_truncated.trace";
+        ofstream out(truncated_path, ios::binary);
+        out.write(bytes.data(), bytes.size() - 3);
+        out.close();
+        
+        WorkloadTrace trace;
+        assert(trace.load(truncated_path) == false);
+        remove(truncated_path.c_str());
+    });
+    
+    harness.runTest("Unusable volume geometry is rejected", [&]() {
+        assert(FATFileSystem::validGeometry(1024, 1024) == true);
+        assert(FATFileSystem::validGeometry(1024, 0) == false);
+        assert(FATFileSystem::validGeometry(1024, 16) == false);    // Header does not fit
+        assert(FATFileSystem::validGeometry(2, 1024) == false);     // No root cluster
+        assert(FATFileSystem::requiredDeviceBlocks(1024, 0) == 0);
+        
+        for (size_t cluster : {size_t(0), size_t(16), size_t(4096)}) {
+            bool threw = false;
+            try {
+                FATFileSystem fs(1, cluster, "BAD");
+            } catch (const invalid_argument&) {
+                threw = true;
+            }
+            assert(threw);
+        }
+        
+        const string bad_path = "fat_replay_bad_geometry.trace";
+        {
+            WorkloadRecorder recorder(bad_path, 1024, 0);
+        }
+        WorkloadTrace trace;
+        assert(trace.load(bad_path) == false);
+        remove(bad_path.c_str());
+    });
+    
+    harness.printSummary();
+    remove(trace_path.c_str());
+}
+
+void testAllocationAccounting() {
+    FATTestHarness harness("Heap Allocation Accounting", 1024, 1024);
+    FATFileSystem* fs = harness.getFS();
+    
+    harness.runTest("Hook counts the calling thread's allocations", []() {
+        assert(alloc_counter::installed() == true);
+        vector<unique_ptr<string>> held;
+        alloc_counter::Counts before = alloc_counter::thread();
+        held.reserve(4);
+        held.push_back(make_unique<string>(100, 'x'));
+        alloc_counter::Counts after = alloc_counter::thread();
+        assert(after.allocations >= before.allocations + 3);    // Vector, string object, buffer
+        assert(after.bytes >= before.bytes + 100);
+        
+        // Another thread's allocations stay on that thread
+        before = alloc_counter::thread();
+        thread([&held]() { held.push_back(make_unique<string>(200, 'y')); }).join();
+        after = alloc_counter::thread();
+        assert(after.allocations - before.allocations <= 2);    // Thread start-up only
+    });
+    
+    harness.runTest("Operations report their allocations", [fs]() {
+        fs->resetStats();
+        assert(fs->createFile("/alloc_counted_file_name.dat", 4096) == true);
+        auto listing = fs->listDirectory("/");
+        assert(!listing.empty());
+        
+        vector<FATFileSystem::OperationStats> stats = fs->getStats();
+        const auto& list = stats[static_cast<size_t>(FsOperation::ListDirectory)];
+#if FAT_FS_STATS
+        assert(list.latency.count == 1);
+        assert(list.allocations.allocations >= 1);
+        assert(list.allocations.bytes > 0);
+#else
+        assert(list.allocations.allocations == 0);
+#endif
+        
+        fs->resetStats();
+        stats = fs->getStats();
+        assert(stats[static_cast<size_t>(FsOperation::ListDirectory)].allocations.allocations == 0);
+    });
+    
+    harness.runTest("Operations marked allocation-free never allocate", [fs]() {
+        assert(fs->createDirectory("/configuration_directory") == true);
+        assert(fs->createFile("/configuration_directory/settings_long_name.ini", 3000) == true);
+        assert(fs->createFile("short.txt", 100) == true);
+        int handle = fs->openFile("/configuration_directory/settings_long_name.ini", "r");
+        assert(handle >= 0);
+        
+        fs->resetStats();
+        for (int i = 0; i < 50; i++) {
+            assert(fs->fileExists("/configuration_directory/settings_long_name.ini") == true);
+            assert(fs->fileExists("/configuration_directory/not_there_either.ini") == false);
+            assert(fs->isDirectory("/configuration_directory") == true);
+            assert(fs->isDirectory("/configuration_directory/settings_long_name.ini") == false);
+            assert(fs->seekFile(handle, i * 10) == true);
+            assert(fs->seekFile(handle, 1 << 20) == false);
+            assert(fs->getFileSystemInfo().total_files >= 2);
+            assert(fs->closeFile(-7) == false);
+        }
+        // openFile and deleteFile allocate, but their path lookups must not
+        int second = fs->openFile("/configuration_directory/settings_long_name.ini", "r");
+        assert(fs->closeFile(second) == true);
+        assert(fs->closeFile(handle) == true);
+        assert(fs->deleteFile("/some/where/missing_file_with_long_name.dat") == false);
+        assert(fs->deleteFile("short.txt") == true);
+        
+#if FAT_FS_STATS
+        for (const FATFileSystem::OperationStats& op : fs->getStats()) {
+            if (!fsOperationAllocationFree(op.operation)) {
+                continue;
+            }
+            cout << "  " << op.name << ": " << op.latency.count << " calls, "
+                 << op.allocations.allocations << " allocations" << endl;
+            // Checked without assert so NDEBUG builds cannot skip it
+            if (op.latency.count == 0) {
+                throw runtime_error(string(op.name) + " was never called");
+            }
+            if (op.allocations.allocations != 0) {
+                throw runtime_error(string(op.name) + " is marked allocation-free but allocated");
+            }
+        }
+#endif
+    });
+    
+    harness.printSummary();
+}
+
 // ============================================
 // MAIN TEST RUNNER
 // ============================================
@@ -416,6 +1590,21 @@ int main() {
         testConcurrentOperations();
         testMetadataOperations();
         testEdgeCases();
+        testFileIOAndWriteBack();
+        testAsynchronousIO();
+        testUringImageDevice();
+        testMappedVolume();
+        testLatencyStats();
+        testEventLog();
+        testStructuredErrors();
+        testTracing();
+        testWorkloadReplay();
+        testAllocationAccounting();
+        
+        if (FATTestHarness::failedTotal() > 0) {
+            cerr << "\n❌ " << FATTestHarness::failedTotal() << " TEST(S) FAILED" << endl;
+            return 1;
+        }
         
         cout << "\n" << string(70, '=') << endl;
         cout << "🎉 ALL TEST SUITES COMPLETED SUCCESSFULLY! 🎉" << endl;
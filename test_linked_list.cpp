@@ -0,0 +1,1151 @@
+#include "singly_linked_list.h"
+#include "mpsc_queue.h"
+#include "unrolled_linked_list.h"
+#include "intrusive_list.h"
+#include "static_singly_linked_list.h"
+#include "concurrent_linked_list.h"
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <numeric>
+#include <memory_resource>
+#include <random>
+#include <sstream>
+#include <cstdint>
+
+using namespace std;
+
+// ============================================
+// TEST UTILITIES
+// ============================================
+
+class ListTestHarness {
+private:
+    string test_name;
+    int test_count;
+    int passed_count;
+
+public:
+    ListTestHarness(const string& name)
+        : test_name(name), test_count(0), passed_count(0) {
+        cout << "\n" << string(60, '=') << endl;
+        cout << "TEST SUITE: " << test_name << endl;
+        cout << string(60, '=') << endl;
+    }
+
+    template<typename Func>
+    void runTest(const string& description, Func test_func) {
+        test_count++;
+        cout << "\nTest " << test_count << ": " << description << endl;
+        cout << string(40, '-') << endl;
+
+        try {
+            test_func();
+            cout << "✓ PASSED" << endl;
+            passed_count++;
+        } catch (const exception& e) {
+            cout << "✗ FAILED: " << e.what() << endl;
+        } catch (...) {
+            cout << "✗ FAILED: Unknown error" << endl;
+        }
+    }
+
+    void printSummary() {
+        cout << "\n" << string(60, '=') << endl;
+        cout << "TEST SUMMARY: " << test_name << endl;
+        cout << "Passed: " << passed_count << "/" << test_count << endl;
+        cout << string(60, '=') << endl;
+    }
+
+    bool allPassed() const { return passed_count == test_count; }
+};
+
+// ============================================
+// LINKED LIST TEST CASES
+// ============================================
+
+bool testMpscQueue() {
+    ListTestHarness harness("Lock-free MPSC Queue");
+
+    harness.runTest("FIFO order with a single producer", [&]() {
+        MpscQueue<int> queue(16);
+        assert(queue.isEmpty());
+        for (int i = 0; i < 10; i++) {
+            assert(queue.tryEnqueue(i));
+        }
+        int value = -1;
+        for (int i = 0; i < 10; i++) {
+            assert(queue.tryDequeue(value));
+            assert(value == i);
+        }
+        assert(!queue.tryDequeue(value));
+        assert(queue.isEmpty());
+    });
+
+    harness.runTest("Bounded pool reports exhaustion and recycles", [&]() {
+        MpscQueue<int> queue(4);
+        for (int i = 0; i < 4; i++) {
+            assert(queue.tryEnqueue(i));
+        }
+        assert(!queue.tryEnqueue(99));
+        int value = -1;
+        assert(queue.tryDequeue(value) && value == 0);
+        assert(queue.tryEnqueue(4));
+    });
+
+    harness.runTest("Intrusive push of caller-owned Node<T>", [&]() {
+        MpscQueue<string> queue(1);
+        Node<string> a("alpha");
+        Node<string> b("beta");
+        queue.push(&a);
+        queue.push(&b);
+        assert(queue.pop() == &a);
+        assert(queue.pop() == &b);
+        assert(queue.pop() == nullptr);
+    });
+
+    harness.runTest("Multiple producers, no loss or duplication", [&]() {
+        const int producers = 4;
+        const int per_producer = 20000;
+        MpscQueue<int> queue(256);
+        vector<thread> threads;
+
+        for (int p = 0; p < producers; p++) {
+            threads.emplace_back([&queue, p]() {
+                for (int i = 0; i < per_producer; i++) {
+                    while (!queue.tryEnqueue(p * per_producer + i)) {
+                        this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        vector<int> last_seen(producers, -1);
+        vector<bool> seen(producers * per_producer, false);
+        int received = 0;
+        int value = 0;
+        while (received < producers * per_producer) {
+            if (!queue.tryDequeue(value)) {
+                this_thread::yield();
+                continue;
+            }
+            assert(!seen[value]);
+            seen[value] = true;
+            // Per-producer FIFO order is preserved
+            int p = value / per_producer;
+            assert(value % per_producer > last_seen[p]);
+            last_seen[p] = value % per_producer;
+            received++;
+        }
+
+        for (thread& t : threads) {
+            t.join();
+        }
+        assert(queue.isEmpty());
+    });
+
+    harness.runTest("Producer handle pool reports exhaustion and recycles", [&]() {
+        MpscQueue<int> queue(3, 2);
+        MpscQueue<int>::Producer& first = queue.getProducer(0);
+        for (int i = 0; i < 3; i++) {
+            assert(first.tryEnqueue(i));
+        }
+        assert(!first.tryEnqueue(99));
+        assert(queue.getProducer(1).tryEnqueue(10));   // other handles unaffected
+        assert(queue.tryEnqueue(20));                  // nor is the shared pool
+        int value = -1;
+        assert(queue.tryDequeue(value) && value == 0);
+        assert(first.tryEnqueue(3));
+        vector<int> rest;
+        while (queue.tryDequeue(value)) rest.push_back(value);
+        assert((rest == vector<int>{1, 2, 10, 20, 3}));
+    });
+
+    harness.runTest("Producer handles, no loss or duplication", [&]() {
+        const int producers = 4;
+        const int per_producer = 20000;
+        MpscQueue<int> queue(64, producers);
+        vector<thread> threads;
+
+        for (int p = 0; p < producers; p++) {
+            threads.emplace_back([&queue, p]() {
+                MpscQueue<int>::Producer& producer = queue.getProducer(p);
+                for (int i = 0; i < per_producer; i++) {
+                    while (!producer.tryEnqueue(p * per_producer + i)) {
+                        this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        vector<int> last_seen(producers, -1);
+        int received = 0;
+        int value = 0;
+        while (received < producers * per_producer) {
+            if (!queue.tryDequeue(value)) {
+                this_thread::yield();
+                continue;
+            }
+            int p = value / per_producer;
+            assert(value % per_producer == last_seen[p] + 1);
+            last_seen[p] = value % per_producer;
+            received++;
+        }
+
+        for (thread& t : threads) {
+            t.join();
+        }
+        assert(queue.isEmpty());
+    });
+
+    harness.printSummary();
+    return harness.allPassed();
+}
+
+bool testIterators() {
+    ListTestHarness harness("Forward Iterators");
+
+    harness.runTest("Range-for visits elements in order", [&]() {
+        SinglyLinkedList<int> list;
+        for (int i = 1; i <= 5; i++) list.insertAtEnd(i);
+        vector<int> seen;
+        for (int value : list) seen.push_back(value);
+        assert((seen == vector<int>{1, 2, 3, 4, 5}));
+        assert(list.begin() != list.end());
+        assert(SinglyLinkedList<int>().begin() == SinglyLinkedList<int>().end());
+    });
+
+    harness.runTest("Works with <algorithm>", [&]() {
+        SinglyLinkedList<int> list;
+        for (int i = 1; i <= 5; i++) list.insertAtEnd(i * 10);
+        assert(accumulate(list.cbegin(), list.cend(), 0) == 150);
+        auto it = find(list.begin(), list.end(), 30);
+        assert(it != list.end() && *it == 30);
+        *it = 35;
+        assert(list.get(2) == 35);
+        assert(count_if(list.begin(), list.end(), [](int v) { return v > 20; }) == 3);
+    });
+
+    harness.runTest("insert_after / erase_after keep head, tail and size", [&]() {
+        SinglyLinkedList<int> list;
+        auto it = list.insert_after(list.before_begin(), 2);
+        list.insert_after(list.before_begin(), 1);
+        it = list.insert_after(it, 4);
+        list.insert_after(list.begin(), 99);   // 1 99 2 4
+        assert(list.getSize() == 4);
+
+        list.erase_after(list.begin());        // 1 2 4
+        list.insert_after(it, 5);              // appends after tail
+        list.insertAtEnd(6);                   // tail must be the new node
+        vector<int> seen(list.begin(), list.end());
+        assert((seen == vector<int>{1, 2, 4, 5, 6}));
+
+        list.erase_after(list.before_begin()); // drop head
+        assert(list.get(0) == 2);
+        auto last = list.begin();
+        while (next(last) != list.end()) {
+            auto prev = last++;
+            if (next(last) == list.end()) {
+                list.erase_after(prev);        // drop tail
+                break;
+            }
+        }
+        list.insertAtEnd(7);
+        seen.assign(list.begin(), list.end());
+        assert((seen == vector<int>{2, 4, 5, 7}));
+        assert(list.getSize() == 4);
+    });
+
+    harness.runTest("end() is not a valid insert or erase position", [&]() {
+        SinglyLinkedList<int> list;
+        list.insertAtEnd(1);
+        list.insertAtEnd(2);
+        assert(list.erase_after(list.end()) == list.end());
+        bool threw = false;
+        try {
+            list.insert_after(list.end(), 9);
+        } catch (const out_of_range&) {
+            threw = true;
+        }
+        assert(threw);
+
+        SinglyLinkedList<int> other;
+        other.insertAtEnd(3);
+        threw = false;
+        try {
+            list.splice_after(list.end(), other);
+        } catch (const out_of_range&) {
+            threw = true;
+        }
+        assert(threw);
+        list.splice_after(list.begin(), other, other.end(), other.end());   // empty range
+        assert(other.getSize() == 1);
+        assert((vector<int>(list.begin(), list.end()) == vector<int>{1, 2}));
+    });
+
+    harness.printSummary();
+    return harness.allPassed();
+}
+
+bool testNodeAllocators() {
+    ListTestHarness harness("Node Allocators");
+
+    harness.runTest("NodePool recycles freed slots before growing", [&]() {
+        NodePool pool(sizeof(Node<int>), alignof(Node<int>), 4, 16);
+        vector<void*> slots;
+        for (int i = 0; i < 4; i++) slots.push_back(pool.allocate());
+        assert(pool.getChunkCount() == 1);
+        void* freed = slots[2];
+        pool.deallocate(freed);
+        assert(pool.allocate() == freed);
+        pool.allocate();   // fifth object needs a second chunk
+        assert(pool.getChunkCount() == 2);
+    });
+
+    harness.runTest("Pooled list survives insert/delete churn", [&]() {
+        PooledSinglyLinkedList<string> list;
+        vector<string> expected;
+        for (int round = 0; round < 50; round++) {
+            for (int i = 0; i < 100; i++) {
+                string value = to_string(round) + ":" + to_string(i);
+                list.insertAtEnd(value);
+                expected.push_back(value);
+            }
+            for (int i = 0; i < 60; i++) list.deleteFromBeginning();
+            expected.erase(expected.begin(), expected.begin() + 60);
+        }
+        assert(list.getSize() == 50 * 40);
+        assert((vector<string>(list.begin(), list.end()) == expected));
+        list.clear();
+        assert(list.isEmpty());
+    });
+
+    harness.runTest("Pooled nodes honour over-aligned element types", [&]() {
+        struct alignas(64) Line {
+            int value;
+        };
+        PooledSinglyLinkedList<Line> list;
+        for (int i = 0; i < 100; i++) list.insertAtEnd(Line{i});
+        for (const Line& line : list) {
+            assert(reinterpret_cast<uintptr_t>(&line) % 64 == 0);
+        }
+        assert(list.get(99).value == 99);
+    });
+
+    harness.runTest("Copied pooled list gets a pool of its own", [&]() {
+        PooledSinglyLinkedList<int> original;
+        for (int i = 0; i < 5; i++) original.insertAtEnd(i);
+        PooledSinglyLinkedList<int> copy(original);
+        assert(copy.get_allocator() != original.get_allocator());
+        PooledSinglyLinkedList<int> moved(std::move(copy));
+        assert(copy.get_allocator() == moved.get_allocator());   // moved-from stays usable
+        copy.insertAtEnd(7);
+        assert(copy.getSize() == 1 && moved.getSize() == 5 && moved.get(4) == 4);
+    });
+
+    harness.runTest("Rebound allocators share their pools", [&]() {
+        NodePoolAllocator<Node<int>> nodes;
+        NodePoolAllocator<double> doubles(nodes);
+        NodePoolAllocator<Node<int>> back(doubles);
+        assert(doubles == nodes && back == nodes);
+        assert(NodePoolAllocator<Node<int>>() != nodes);
+
+        Node<int>* node = nodes.allocate(1);
+        back.deallocate(node, 1);
+        assert(nodes.allocate(1) == node);   // the freed slot went back to the same pool
+        nodes.deallocate(node, 1);
+        double* value = doubles.allocate(1);
+        NodePoolAllocator<double>(back).deallocate(value, 1);
+        assert(doubles.allocate(1) == value);
+        doubles.deallocate(value, 1);
+    });
+
+    harness.runTest("std::allocator gives plain new/delete nodes", [&]() {
+        SinglyLinkedList<int, std::allocator<Node<int>>> list;
+        for (int i = 0; i < 10; i++) list.insertAtPosition(i, i);
+        list.deleteFromPosition(5);
+        list.reverse();
+        vector<int> seen(list.begin(), list.end());
+        assert((seen == vector<int>{9, 8, 7, 6, 4, 3, 2, 1, 0}));
+    });
+
+    harness.runTest("PmrSinglyLinkedList draws from the given resource", [&]() {
+        unsigned char buffer[4096];
+        std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                                   std::pmr::null_memory_resource());
+        PmrSinglyLinkedList<int> list(&arena);
+        for (int i = 0; i < 32; i++) list.insertAtEnd(i);
+        assert(list.getSize() == 32);
+        assert(list.get_allocator().resource() == &arena);
+
+        // The arena is exhausted long before 4096 more nodes
+        bool threw = false;
+        try {
+            for (int i = 0; i < 4096; i++) list.insertAtEnd(i);
+        } catch (const std::bad_alloc&) {
+            threw = true;
+        }
+        assert(threw);
+    });
+
+    harness.printSummary();
+    return harness.allPassed();
+}
+
+// Element type that records how it was constructed
+struct Tracked {
+    static int copies;
+    static int moves;
+    int value;
+
+    explicit Tracked(int v = 0) : value(v) {}
+    Tracked(int a, int b) : value(a * 100 + b) {}
+    Tracked(const Tracked& other) : value(other.value) { copies++; }
+    Tracked(Tracked&& other) noexcept : value(other.value) { moves++; }
+    Tracked& operator=(const Tracked& other) { value = other.value; copies++; return *this; }
+    Tracked& operator=(Tracked&& other) noexcept { value = other.value; moves++; return *this; }
+    bool operator==(const Tracked& other) const { return value == other.value; }
+
+    static void reset() { copies = moves = 0; }
+};
+int Tracked::copies = 0;
+int Tracked::moves = 0;
+
+bool testCopyAndMove() {
+    ListTestHarness harness("Copy, Move and Emplace");
+
+    harness.runTest("Emplace constructs in place, rvalues are moved", [&]() {
+        SinglyLinkedList<Tracked> list;
+        Tracked::reset();
+        list.emplaceBack(1, 2);
+        list.emplaceFront(7);
+        list.emplaceAfter(list.begin(), 3, 4);
+        assert(Tracked::copies == 0 && Tracked::moves == 0);
+
+        list.insertAtEnd(Tracked(9));
+        list.insertAtPosition(Tracked(5), 1);
+        list.update(0, Tracked(8));
+        assert(Tracked::copies == 0);
+
+        Tracked lvalue(6);
+        list.insertAtBeginning(lvalue);
+        assert(Tracked::copies == 1);
+
+        vector<int> seen;
+        for (const Tracked& t : list) seen.push_back(t.value);
+        assert((seen == vector<int>{6, 8, 5, 304, 102, 9}));
+    });
+
+    harness.runTest("Copy is deep and independent", [&]() {
+        SinglyLinkedList<string> original;
+        original.insertAtEnd("a");
+        original.insertAtEnd("b");
+
+        SinglyLinkedList<string> copy(original);
+        copy.update(0, "z");
+        copy.insertAtEnd("c");
+        assert(original.getSize() == 2 && original.get(0) == "a");
+        assert(copy.getSize() == 3 && copy.get(0) == "z" && copy.get(2) == "c");
+
+        SinglyLinkedList<string> assigned;
+        assigned.insertAtEnd("old");
+        assigned = original;
+        original.clear();
+        assert(assigned.getSize() == 2 && assigned.get(1) == "b");
+        assigned.insertAtEnd("tail");   // tail pointer belongs to the copy
+        assert(assigned.get(2) == "tail");
+    });
+
+    harness.runTest("Move steals nodes in O(1)", [&]() {
+        SinglyLinkedList<Tracked> source;
+        for (int i = 0; i < 100; i++) source.emplaceBack(i);
+        Tracked::reset();
+
+        SinglyLinkedList<Tracked> moved(std::move(source));
+        assert(Tracked::copies == 0 && Tracked::moves == 0);
+        assert(moved.getSize() == 100 && source.isEmpty());
+
+        SinglyLinkedList<Tracked> target;
+        target.emplaceBack(-1);
+        target = std::move(moved);
+        assert(Tracked::copies == 0 && Tracked::moves == 0);
+        assert(target.getSize() == 100 && moved.isEmpty());
+        assert(target.get(99).value == 99);
+
+        // The moved-from list is still usable
+        moved.emplaceBack(42);
+        assert(moved.getSize() == 1);
+    });
+
+    harness.runTest("Nested lists survive copies of their owner", [&]() {
+        struct Directory {
+            string name;
+            SinglyLinkedList<string> entries;
+        };
+        SinglyLinkedList<Directory> tree;
+        {
+            Directory dir{"docs", {}};
+            dir.entries.insertAtEnd("readme.txt");
+            tree.insertAtEnd(dir);          // copy: dir keeps its own entries
+            dir.entries.insertAtEnd("notes.txt");
+        }
+        SinglyLinkedList<Directory> snapshot = tree;
+        tree.getRef(0).entries.clear();
+        assert(snapshot.get(0).entries.getSize() == 1);
+        assert(snapshot.get(0).entries.get(0) == "readme.txt");
+    });
+
+    harness.runTest("pmr lists move by element across resources", [&]() {
+        std::pmr::unsynchronized_pool_resource first_resource;
+        std::pmr::unsynchronized_pool_resource second_resource;
+        PmrSinglyLinkedList<int> first(&first_resource);
+        PmrSinglyLinkedList<int> second(&second_resource);
+        for (int i = 0; i < 5; i++) first.insertAtEnd(i);
+
+        second = std::move(first);
+        assert(second.get_allocator().resource() == &second_resource);
+        assert(second.getSize() == 5 && second.get(4) == 4);
+        assert(first.isEmpty());
+    });
+
+    harness.printSummary();
+    return harness.allPassed();
+}
+
+bool testUnrolledList() {
+    ListTestHarness harness("Unrolled Linked List");
+
+    harness.runTest("Appends pack chunks and index lookups agree", [&]() {
+        UnrolledLinkedList<int, 8> list;
+        for (int i = 0; i < 100; i++) list.insertAtEnd(i);
+        assert(list.getSize() == 100);
+        assert(list.getChunkCount() == 13);
+        for (int i = 0; i < 100; i++) assert(list.get(i) == i);
+        list.getRef(57) = -57;
+        assert(list.getConstRef(57) == -57);
+        assert(list.search(-57) && !list.search(1000));
+
+        bool threw = false;
+        try {
+            list.get(100);
+        } catch (const out_of_range&) {
+            threw = true;
+        }
+        assert(threw);
+    });
+
+    harness.runTest("Random inserts and deletes match std::vector", [&]() {
+        UnrolledLinkedList<int, 4> list;
+        vector<int> model;
+        mt19937 rng(1234);
+        for (int step = 0; step < 20000; step++) {
+            int op = rng() % 6;
+            int n = static_cast<int>(model.size());
+            if (op < 3 || n == 0) {
+                int position = rng() % (n + 1);
+                list.insertAtPosition(step, position);
+                model.insert(model.begin() + position, step);
+            } else if (op == 3) {
+                list.deleteFromBeginning();
+                model.erase(model.begin());
+            } else if (op == 4) {
+                list.deleteFromEnd();
+                model.pop_back();
+            } else {
+                int position = rng() % n;
+                list.deleteFromPosition(position);
+                model.erase(model.begin() + position);
+            }
+            assert(list.getSize() == static_cast<int>(model.size()));
+        }
+        assert((vector<int>(list.begin(), list.end()) == model));
+        for (size_t i = 0; i < model.size(); i += 7) {
+            assert(list.get(static_cast<int>(i)) == model[i]);
+        }
+    });
+
+    harness.runTest("Reverse, copy, move and clear", [&]() {
+        UnrolledLinkedList<string, 3> list;
+        for (int i = 0; i < 10; i++) list.emplaceBack(to_string(i));
+        list.emplaceFront("front");
+        list.reverse();
+        vector<string> seen(list.begin(), list.end());
+        assert((seen == vector<string>{"9", "8", "7", "6", "5", "4", "3", "2", "1", "0", "front"}));
+        assert(list.get(10) == "front");
+
+        UnrolledLinkedList<string, 3> copy(list);
+        copy.update(0, "changed");
+        assert(list.get(0) == "9" && copy.get(0) == "changed");
+
+        UnrolledLinkedList<string, 3> moved(std::move(copy));
+        assert(copy.isEmpty() && moved.getSize() == 11);
+        moved.insertAtEnd("last");
+        assert(moved.get(11) == "last");
+
+        list = moved;
+        moved.clear();
+        assert(moved.isEmpty() && moved.getChunkCount() == 0);
+        assert(list.getSize() == 12 && list.get(0) == "changed");
+    });
+
+    harness.printSummary();
+    return harness.allPassed();
+}
+
+bool testPositionCursor() {
+    ListTestHarness harness("Positional Cursor Cache");
+
+    harness.runTest("Ascending, repeated and backward lookups", [&]() {
+        SinglyLinkedList<int> list;
+        for (int i = 0; i < 50; i++) list.insertAtEnd(i);
+        for (int i = 0; i < 50; i++) assert(list.getConstRef(i) == i);
+        assert(list.get(20) == 20 && list.get(20) == 20);
+        assert(list.get(3) == 3);      // behind the cursor: restart from head
+        assert(list.getRef(49) == 49);
+    });
+
+    harness.runTest("Every mutation keeps lookups correct", [&]() {
+        SinglyLinkedList<int> list;
+        vector<int> model;
+        mt19937 rng(99);
+        for (int step = 0; step < 5000; step++) {
+            int n = static_cast<int>(model.size());
+            // Park the cursor somewhere first
+            if (n > 0) {
+                int probe = rng() % n;
+                assert(list.get(probe) == model[probe]);
+            }
+
+            int op = rng() % 10;
+            if (op < 2 || n == 0) {
+                list.insertAtEnd(step);
+                model.push_back(step);
+            } else if (op == 2) {
+                list.insertAtBeginning(step);
+                model.insert(model.begin(), step);
+            } else if (op == 3) {
+                int position = rng() % (n + 1);
+                list.insertAtPosition(step, position);
+                model.insert(model.begin() + position, step);
+            } else if (op == 4) {
+                list.deleteFromBeginning();
+                model.erase(model.begin());
+            } else if (op == 5) {
+                list.deleteFromEnd();
+                model.pop_back();
+            } else if (op == 6) {
+                int position = rng() % n;
+                list.deleteFromPosition(position);
+                model.erase(model.begin() + position);
+            } else if (op == 7) {
+                list.insert_after(list.begin(), step);
+                model.insert(model.begin() + 1, step);
+            } else if (op == 8) {
+                list.erase_after(list.before_begin());
+                model.erase(model.begin());
+            } else {
+                list.reverse();
+                std::reverse(model.begin(), model.end());
+            }
+
+            for (size_t i = 0; i < model.size(); i += 1 + model.size() / 8) {
+                assert(list.getConstRef(static_cast<int>(i)) == model[i]);
+            }
+        }
+    });
+
+    harness.runTest("Copies and moves do not share the cursor", [&]() {
+        SinglyLinkedList<int> list;
+        for (int i = 0; i < 10; i++) list.insertAtEnd(i);
+        assert(list.get(7) == 7);
+
+        SinglyLinkedList<int> moved(std::move(list));
+        assert(moved.get(8) == 8);
+        list.insertAtEnd(100);
+        list.insertAtEnd(101);
+        assert(list.get(1) == 101);
+
+        list = moved;
+        assert(list.get(9) == 9);
+        list.clear();
+        list.insertAtEnd(5);
+        assert(list.get(0) == 5);
+    });
+
+    harness.runTest("Concurrent readers of a const list", [&]() {
+        SinglyLinkedList<int> list;
+        for (int i = 0; i < 200; i++) list.insertAtEnd(i);
+        assert(list.get(150) == 150);     // Park the cursor mid-list
+        const SinglyLinkedList<int>& shared = list;
+
+        atomic<int> mismatches{0};
+        vector<thread> readers;
+        for (int t = 0; t < 4; t++) {
+            readers.emplace_back([&shared, &mismatches, t]() {
+                for (int round = 0; round < 50; round++) {
+                    for (int i = t; i < 200; i += 3) {
+                        if (shared.getConstRef(i) != i || shared.get(199 - i) != 199 - i) {
+                            mismatches++;
+                        }
+                    }
+                }
+            });
+        }
+        for (thread& reader : readers) reader.join();
+        assert(mismatches == 0);
+        assert(list.get(151) == 151);     // The cursor was left where it was
+    });
+
+    harness.printSummary();
+    return harness.allPassed();
+}
+
+// Element threaded onto two lists: one base hook, one member hook
+struct CacheEntry : IntrusiveListNode<CacheEntry> {
+    int block;
+    IntrusiveLink<CacheEntry> dirty_link;
+
+    explicit CacheEntry(int b) : block(b) {}
+};
+using DirtyList = IntrusiveSinglyLinkedList<CacheEntry, MemberLink<CacheEntry, &CacheEntry::dirty_link>>;
+
+bool testIntrusiveList() {
+    ListTestHarness harness("Intrusive Singly Linked List");
+
+    harness.runTest("Objects are linked in place, not copied", [&]() {
+        vector<CacheEntry> entries;
+        for (int i = 0; i < 6; i++) entries.emplace_back(i);
+
+        IntrusiveSinglyLinkedList<CacheEntry> free_list;
+        for (CacheEntry& entry : entries) free_list.insertAtEnd(entry);
+        assert(free_list.getSize() == 6);
+        assert(&free_list.getRef(3) == &entries[3]);
+        assert(&free_list.front() == &entries[0] && &free_list.back() == &entries[5]);
+
+        CacheEntry* taken = free_list.deleteFromBeginning();
+        assert(taken == &entries[0] && !IntrusiveSinglyLinkedList<CacheEntry>::isLinked(*taken));
+        assert(free_list.deleteFromEnd() == &entries[5]);
+        assert(free_list.deleteFromPosition(1) == &entries[2]);
+        assert(free_list.remove(entries[3]) && !free_list.remove(entries[3]));
+        free_list.insertAtPosition(entries[0], 1);
+
+        vector<int> seen;
+        for (const CacheEntry& entry : free_list) seen.push_back(entry.block);
+        assert((seen == vector<int>{1, 0, 4}));
+    });
+
+    harness.runTest("One object on two lists through two hooks", [&]() {
+        CacheEntry a(1), b(2), c(3);
+        IntrusiveSinglyLinkedList<CacheEntry> lru;
+        DirtyList dirty;
+        lru.insertAtEnd(a);
+        lru.insertAtEnd(b);
+        lru.insertAtEnd(c);
+        dirty.insertAtEnd(c);
+        dirty.insertAtEnd(a);
+
+        assert(lru.getSize() == 3 && dirty.getSize() == 2);
+        dirty.deleteFromBeginning();
+        assert(lru.contains(c) && !dirty.contains(c) && dirty.contains(a));
+
+        lru.reverse();
+        assert(&lru.front() == &c && &lru.back() == &a);
+        assert(dirty.deleteFromBeginning() == &a);
+        assert(DirtyList::isLinked(a) == false && lru.contains(a));
+    });
+
+    harness.runTest("Double insertion through one hook is rejected", [&]() {
+        CacheEntry a(1);
+        IntrusiveSinglyLinkedList<CacheEntry> first;
+        IntrusiveSinglyLinkedList<CacheEntry> second;
+        first.insertAtEnd(a);
+        bool threw = false;
+        try {
+            second.insertAtEnd(a);
+        } catch (const logic_error&) {
+            threw = true;
+        }
+        assert(threw && second.isEmpty());
+
+        // Copies start unlinked; clearing unlinks without destroying
+        CacheEntry copy = a;
+        second.insertAtEnd(copy);
+        first.clear();
+        assert(!IntrusiveSinglyLinkedList<CacheEntry>::isLinked(a) && a.block == 1);
+        second.insertAtEnd(a);
+        assert(second.getSize() == 2);
+    });
+
+    harness.runTest("insert_after / erase_after and move", [&]() {
+        CacheEntry a(1), b(2), c(3);
+        IntrusiveSinglyLinkedList<CacheEntry> list;
+        auto it = list.insert_after(list.before_begin(), a);
+        list.insert_after(it, c);
+        list.insert_after(it, b);
+        list.erase_after(list.before_begin());
+        assert(list.getSize() == 2 && &list.front() == &b && &list.back() == &c);
+
+        IntrusiveSinglyLinkedList<CacheEntry> moved(std::move(list));
+        assert(list.isEmpty() && moved.getSize() == 2);
+        moved.insertAtEnd(a);
+        assert(&moved.back() == &a);
+    });
+
+    harness.runTest("end() is not a valid insert or erase position", [&]() {
+        CacheEntry a(1), b(2), c(3);
+        IntrusiveSinglyLinkedList<CacheEntry> list;
+        list.insertAtEnd(a);
+        list.insertAtEnd(b);
+        assert(list.erase_after(list.end()) == list.end());
+        assert(list.getSize() == 2 && &list.front() == &a);
+
+        bool threw = false;
+        try {
+            list.insert_after(list.end(), c);
+        } catch (const out_of_range&) {
+            threw = true;
+        }
+        assert(threw && !IntrusiveSinglyLinkedList<CacheEntry>::isLinked(c));
+        assert(list.getSize() == 2 && &list.back() == &b);
+    });
+
+    harness.printSummary();
+    return harness.allPassed();
+}
+
+bool testSortMergeSplice() {
+    ListTestHarness harness("Sort, Merge and Splice");
+
+    harness.runTest("Sort matches std::stable_sort", [&]() {
+        mt19937 rng(7);
+        for (int n : {0, 1, 2, 3, 17, 64, 1000}) {
+            SinglyLinkedList<pair<int, int>> list;
+            vector<pair<int, int>> model;
+            for (int i = 0; i < n; i++) {
+                pair<int, int> value(static_cast<int>(rng() % 10), i);
+                list.insertAtEnd(value);
+                model.push_back(value);
+            }
+            auto by_key = [](const pair<int, int>& a, const pair<int, int>& b) { return a.first < b.first; };
+            list.sort(by_key);
+            stable_sort(model.begin(), model.end(), by_key);
+            assert((vector<pair<int, int>>(list.begin(), list.end()) == model));
+            if (n > 0) {
+                list.insertAtEnd({99, -1});   // tail must be the last node
+                assert(list.get(n).first == 99);
+            }
+        }
+    });
+
+    harness.runTest("Sort relinks nodes instead of copying", [&]() {
+        SinglyLinkedList<Tracked> list;
+        for (int i = 10; i > 0; i--) list.emplaceBack(i);
+        const Tracked* smallest = &list.getConstRef(9);
+        Tracked::reset();
+        list.sort([](const Tracked& a, const Tracked& b) { return a.value < b.value; });
+        assert(Tracked::copies == 0 && Tracked::moves == 0);
+        assert(&list.getConstRef(0) == smallest);
+    });
+
+    harness.runTest("Merge is stable and empties the donor", [&]() {
+        SinglyLinkedList<pair<int, char>> mine;
+        SinglyLinkedList<pair<int, char>> theirs(mine.get_allocator());
+        for (int v : {1, 3, 3, 7}) mine.insertAtEnd({v, 'a'});
+        for (int v : {0, 3, 8, 9}) theirs.insertAtEnd({v, 'b'});
+        mine.merge(theirs, [](const pair<int, char>& a, const pair<int, char>& b) { return a.first < b.first; });
+        assert(theirs.isEmpty() && mine.getSize() == 8);
+        vector<pair<int, char>> expected = {{0, 'b'}, {1, 'a'}, {3, 'a'}, {3, 'a'}, {3, 'b'},
+                                            {7, 'a'}, {8, 'b'}, {9, 'b'}};
+        assert((vector<pair<int, char>>(mine.begin(), mine.end()) == expected));
+        mine.insertAtEnd({10, 'c'});
+        assert(mine.get(8).first == 10);
+
+        SinglyLinkedList<int> empty;
+        SinglyLinkedList<int> sorted;
+        for (int i = 0; i < 3; i++) sorted.insertAtEnd(i);
+        empty.merge(sorted);
+        assert(empty.getSize() == 3 && sorted.isEmpty() && empty.get(2) == 2);
+    });
+
+    harness.runTest("Splice whole lists and ranges", [&]() {
+        PooledSinglyLinkedList<int> a;
+        PooledSinglyLinkedList<int> b(a.get_allocator());
+        for (int i = 0; i < 3; i++) a.insertAtEnd(i);        // 0 1 2
+        for (int i = 10; i < 15; i++) b.insertAtEnd(i);      // 10..14
+
+        // Shared pool: node addresses survive the move
+        const int* eleven = &b.getConstRef(1);
+        a.splice_after(a.begin(), b, b.begin(), next(b.begin(), 3));  // moves 11 12
+        assert(&a.getConstRef(1) == eleven);
+        assert((vector<int>(a.begin(), a.end()) == vector<int>{0, 11, 12, 1, 2}));
+        assert((vector<int>(b.begin(), b.end()) == vector<int>{10, 13, 14}));
+
+        a.splice_after(a.before_begin(), b, b.begin(), b.end());      // moves 13 14
+        assert(b.getSize() == 1 && b.get(0) == 10);
+        b.insertAtEnd(15);                                            // b's tail was fixed up
+        a.spliceAtEnd(b);
+        assert(b.isEmpty());
+        assert((vector<int>(a.begin(), a.end()) == vector<int>{13, 14, 0, 11, 12, 1, 2, 10, 15}));
+        a.insertAtEnd(16);
+        assert(a.getSize() == 10 && a.get(9) == 16);
+    });
+
+    harness.runTest("Splice between unrelated allocators still works", [&]() {
+        PooledSinglyLinkedList<string> a;
+        PooledSinglyLinkedList<string> b;
+        a.insertAtEnd("a");
+        b.insertAtEnd("b1");
+        b.insertAtEnd("b2");
+        a.spliceAtEnd(b);                    // separate pools: elements move
+        assert(b.isEmpty() && a.getSize() == 3 && a.get(2) == "b2");
+
+        std::pmr::unsynchronized_pool_resource r1, r2;
+        PmrSinglyLinkedList<int> p(&r1), q(&r2);
+        q.insertAtEnd(1);
+        q.insertAtEnd(2);
+        p.splice_after(p.before_begin(), q);
+        assert(q.isEmpty() && p.getSize() == 2 && p.get_allocator().resource() == &r1);
+    });
+
+    harness.printSummary();
+    return harness.allPassed();
+}
+
+bool testStaticList() {
+    ListTestHarness harness("Static (fixed-capacity) Singly Linked List");
+
+    harness.runTest("Full list rejects inserts silently", [&]() {
+        StaticSinglyLinkedList<int, 4> list;
+        assert(list.isEmpty() && !list.full() && list.capacity() == 4);
+        assert(list.insertAtEnd(1) && list.insertAtEnd(2) && list.insertAtBeginning(0));
+        assert(list.emplaceBack(3) != nullptr);
+        assert(list.full());
+
+        streambuf* saved = cout.rdbuf();
+        ostringstream captured;
+        cout.rdbuf(captured.rdbuf());
+        bool rejected = !list.insertAtEnd(4) && !list.insertAtBeginning(-1) &&
+                        !list.insertAtPosition(9, 2) && list.emplaceFront(5) == nullptr &&
+                        list.insert_after(list.begin(), 7) == list.end() &&
+                        !list.insertAtPosition(1, 99) && !list.deleteFromPosition(-1);
+        cout.rdbuf(saved);
+        assert(rejected && captured.str().empty());
+        assert((vector<int>(list.begin(), list.end()) == vector<int>{0, 1, 2, 3}));
+    });
+
+    harness.runTest("Slots are recycled through the free list", [&]() {
+        StaticSinglyLinkedList<string, 3> list;
+        for (int round = 0; round < 100; round++) {
+            assert(list.insertAtEnd("a" + to_string(round)));
+            assert(list.insertAtEnd("b"));
+            assert(list.insertAtPosition("mid", 1));
+            assert(list.full());
+            assert(list.deleteFromEnd() && list.deleteFromPosition(1) && list.deleteFromBeginning());
+            assert(!list.deleteFromBeginning());
+        }
+        assert(list.isEmpty());
+    });
+
+    harness.runTest("Same API as SinglyLinkedList", [&]() {
+        StaticSinglyLinkedList<int, 16> list;
+        for (int i = 0; i < 6; i++) list.insertAtEnd(i);
+        assert(list.update(2, 20) && !list.update(6, 0));
+        assert(list.get(2) == 20 && list.getRef(5) == 5 && list.search(20) && !list.search(2));
+        list.reverse();
+        assert((vector<int>(list.begin(), list.end()) == vector<int>{5, 4, 3, 20, 1, 0}));
+        list.erase_after(list.before_begin());
+        list.insert_after(list.begin(), 99);
+        list.insertAtEnd(7);
+        assert((vector<int>(list.cbegin(), list.cend()) == vector<int>{4, 99, 3, 20, 1, 0, 7}));
+
+        StaticSinglyLinkedList<int, 16> copy(list);
+        copy.deleteFromBeginning();
+        assert(list.getSize() == 7 && copy.getSize() == 6);
+        StaticSinglyLinkedList<int, 16> moved(std::move(copy));
+        assert(copy.isEmpty() && moved.get(0) == 99);
+
+        bool threw = false;
+        try {
+            moved.get(6);
+        } catch (const out_of_range&) {
+            threw = true;
+        }
+        assert(threw);
+    });
+
+    harness.runTest("end() is not a valid insert or erase position", [&]() {
+        StaticSinglyLinkedList<int, 4> list;
+        list.insertAtEnd(1);
+        list.insertAtEnd(2);
+        assert(list.erase_after(list.end()) == list.end());
+        assert(list.insert_after(list.end(), 9) == list.end());
+        assert((vector<int>(list.begin(), list.end()) == vector<int>{1, 2}));
+    });
+
+    harness.printSummary();
+    return harness.allPassed();
+}
+
+bool testConcurrentList() {
+    ListTestHarness harness("Concurrent Singly Linked List");
+
+    harness.runTest("Single-threaded semantics", [&]() {
+        ConcurrentSinglyLinkedList<int> list;
+        assert(list.isEmpty());
+        list.insertAtEnd(2);
+        list.insertAtBeginning(1);
+        list.insertAtEnd(3);
+        assert(list.getSize() == 3 && list.search(2) && !list.search(4));
+        assert(list.remove(2) && !list.remove(2));
+        assert(list.deleteFromBeginning());
+        vector<int> seen;
+        list.forEach([&](int v) { seen.push_back(v); });
+        assert((seen == vector<int>{3}));
+        assert(list.collectGarbage() == 0);   // no reader active: all freed
+    });
+
+    harness.runTest("Readers always see untouched keys while writers churn", [&]() {
+        ConcurrentSinglyLinkedList<int> list;
+        const int stable = 64;
+        for (int i = 0; i < stable; i++) list.insertAtEnd(i);
+
+        atomic<bool> stop(false);
+        atomic<int> misses(0);
+        vector<thread> threads;
+        for (int w = 0; w < 3; w++) {
+            threads.emplace_back([&, w]() {
+                for (int i = 0; i < 3000; i++) {
+                    int key = 1000 + w * 10000 + i;
+                    if (i % 2) list.insertAtEnd(key); else list.insertAtBeginning(key);
+                    assert(list.remove(key));
+                }
+            });
+        }
+        for (int r = 0; r < 3; r++) {
+            threads.emplace_back([&]() {
+                while (!stop.load()) {
+                    for (int key = 0; key < stable; key += 7) {
+                        if (!list.search(key)) misses++;
+                    }
+                    int visited = 0;
+                    list.forEach([&](int v) { if (v < stable) visited++; });
+                    if (visited != stable) misses++;
+                }
+            });
+        }
+        for (int w = 0; w < 3; w++) threads[w].join();
+        stop = true;
+        for (size_t t = 3; t < threads.size(); t++) threads[t].join();
+
+        assert(misses.load() == 0);
+        assert(list.getSize() == stable);
+        assert(list.collectGarbage() == 0);
+    });
+
+    harness.runTest("Concurrent removals each succeed exactly once", [&]() {
+        ConcurrentSinglyLinkedList<int> list;
+        for (int i = 0; i < 2000; i++) list.insertAtEnd(i);
+        atomic<int> removed(0);
+        vector<thread> threads;
+        for (int t = 0; t < 4; t++) {
+            threads.emplace_back([&]() {
+                for (int i = 0; i < 2000; i++) {
+                    if (list.remove(i)) removed++;
+                }
+            });
+        }
+        for (thread& t : threads) t.join();
+        assert(removed.load() == 2000 && list.isEmpty() && list.getSize() == 0);
+    });
+
+    harness.printSummary();
+    return harness.allPassed();
+}
+
+bool testPredicates() {
+    ListTestHarness harness("Predicate Search and Removal");
+
+    struct Entry {
+        string name;
+        bool is_directory;
+    };
+
+    harness.runTest("findIf / findBeforeIf / countIf", [&]() {
+        SinglyLinkedList<Entry> list;
+        list.insertAtEnd({"/", true});
+        list.insertAtEnd({"a.txt", false});
+        list.insertAtEnd({"docs", true});
+
+        auto it = list.findIf([](const Entry& e) { return e.name == "docs"; });
+        assert(it != list.end() && it->is_directory);
+        it->name = "documents";   // mutable through the iterator
+        assert(list.getConstRef(2).name == "documents");
+
+        const SinglyLinkedList<Entry>& view = list;
+        assert(view.findIf([](const Entry& e) { return e.name == "zzz"; }) == view.end());
+        assert(list.countIf([](const Entry& e) { return e.is_directory; }) == 2);
+
+        auto before = list.findBeforeIf([](const Entry& e) { return e.name == "/"; });
+        assert(before == list.before_begin());
+        before = list.findBeforeIf([](const Entry& e) { return e.name == "documents"; });
+        assert(before->name == "a.txt");
+        list.erase_after(before);
+        assert(list.getSize() == 2);
+        list.insertAtEnd({"new", false});   // tail was fixed up
+        assert(list.get(2).name == "new");
+        assert(list.findBeforeIf([](const Entry&) { return false; }) == list.end());
+    });
+
+    harness.runTest("removeIf unlinks all matches in one pass", [&]() {
+        SinglyLinkedList<int> list;
+        for (int i = 0; i < 20; i++) list.insertAtEnd(i);
+        assert(list.get(15) == 15);   // park the cursor past the first removal
+        assert(list.removeIf([](int v) { return v % 3 == 0 || v == 19; }) == 8);
+        assert(list.getSize() == 12);
+        assert((vector<int>(list.begin(), list.end()) ==
+                vector<int>{1, 2, 4, 5, 7, 8, 10, 11, 13, 14, 16, 17}));
+        assert(list.get(9) == 14);
+        list.insertAtEnd(99);
+        assert(list.get(12) == 99);
+
+        assert(list.removeIf([](int) { return true; }) == 13);
+        assert(list.isEmpty());
+        list.insertAtEnd(1);
+        assert(list.get(0) == 1 && list.removeIf([](int v) { return v > 5; }) == 0);
+    });
+
+    harness.printSummary();
+    return harness.allPassed();
+}
+
+// ============================================
+// MAIN TEST RUNNER
+// ============================================
+
+int main() {
+    cout << string(70, '=') << endl;
+    cout << "SINGLY LINKED LIST TEST SUITE" << endl;
+    cout << string(70, '=') << endl;
+
+    bool ok = true;
+    ok = testMpscQueue() && ok;
+    ok = testIterators() && ok;
+    ok = testNodeAllocators() && ok;
+    ok = testCopyAndMove() && ok;
+    ok = testUnrolledList() && ok;
+    ok = testPositionCursor() && ok;
+    ok = testIntrusiveList() && ok;
+    ok = testSortMergeSplice() && ok;
+    ok = testStaticList() && ok;
+    ok = testConcurrentList() && ok;
+    ok = testPredicates() && ok;
+
+    cout << "\n" << string(70, '=') << endl;
+    cout << (ok ? "🎉 ALL TEST SUITES PASSED! 🎉" : "❌ SOME TESTS FAILED ❌") << endl;
+    cout << string(70, '=') << endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,415 @@
+#ifndef UNROLLED_LINKED_LIST_CPP
+#define UNROLLED_LINKED_LIST_CPP
+
+#include <iostream>
+#include <algorithm>
+#include <utility>
+#include "unrolled_linked_list.h"
+
+// Chunk holding position (0 <= position < size) via the chunk index
+template <typename T, size_t ChunkCapacity>
+size_t UnrolledLinkedList<T, ChunkCapacity>::locate(int position) const {
+    // Appends and tail reads hit the last chunk without a search
+    if (position >= chunk_start.back()) {
+        return chunks.size() - 1;
+    }
+    auto it = std::upper_bound(chunk_start.begin(), chunk_start.end(), position);
+    return static_cast<size_t>(it - chunk_start.begin()) - 1;
+}
+
+// Create an empty chunk at index and link it between its neighbours
+template <typename T, size_t ChunkCapacity>
+void UnrolledLinkedList<T, ChunkCapacity>::insertChunk(size_t index, int start) {
+    Chunk* chunk = new Chunk();
+    chunks.insert(chunks.begin() + index, chunk);
+    chunk_start.insert(chunk_start.begin() + index, start);
+
+    if (index > 0) {
+        chunks[index - 1]->next = chunk;
+    }
+    chunk->next = (index + 1 < chunks.size()) ? chunks[index + 1] : nullptr;
+}
+
+// Unlink and free an empty chunk
+template <typename T, size_t ChunkCapacity>
+void UnrolledLinkedList<T, ChunkCapacity>::removeChunk(size_t index) {
+    Chunk* chunk = chunks[index];
+    if (index > 0) {
+        chunks[index - 1]->next = chunk->next;
+    }
+    chunks.erase(chunks.begin() + index);
+    chunk_start.erase(chunk_start.begin() + index);
+    delete chunk;
+}
+
+// Adjust the first position of every chunk from `from` onwards
+template <typename T, size_t ChunkCapacity>
+void UnrolledLinkedList<T, ChunkCapacity>::shiftStarts(size_t from, int delta) {
+    for (size_t i = from; i < chunk_start.size(); i++) {
+        chunk_start[i] += delta;
+    }
+}
+
+// Move the upper half of a full chunk into a new chunk after it
+template <typename T, size_t ChunkCapacity>
+void UnrolledLinkedList<T, ChunkCapacity>::splitChunk(size_t index) {
+    Chunk* chunk = chunks[index];
+    size_t keep = chunk->count - chunk->count / 2;
+    insertChunk(index + 1, chunk_start[index] + static_cast<int>(keep));
+
+    Chunk* upper = chunks[index + 1];
+    T* from = chunk->items();
+    T* to = upper->items();
+    for (size_t i = keep; i < chunk->count; i++) {
+        new (&to[i - keep]) T(std::move(from[i]));
+        from[i].~T();
+    }
+    upper->count = chunk->count - keep;
+    chunk->count = keep;
+}
+
+// Construct an element at position (0 <= position <= size)
+template <typename T, size_t ChunkCapacity>
+template <typename... Args>
+T& UnrolledLinkedList<T, ChunkCapacity>::emplaceAt(int position, Args&&... args) {
+    if (chunks.empty()) {
+        insertChunk(0, 0);
+    }
+
+    size_t index;
+    if (position == size) {
+        // Appends fill the last chunk completely before starting a new one
+        index = chunks.size() - 1;
+        if (chunks[index]->count == ChunkCapacity) {
+            insertChunk(++index, size);
+        }
+    } else {
+        index = locate(position);
+        if (chunks[index]->count == ChunkCapacity) {
+            splitChunk(index);
+            if (position >= chunk_start[index + 1]) {
+                index++;
+            }
+        }
+    }
+
+    Chunk* chunk = chunks[index];
+    T* items = chunk->items();
+    size_t offset = static_cast<size_t>(position - chunk_start[index]);
+
+    if (offset == chunk->count) {
+        new (&items[offset]) T(std::forward<Args>(args)...);
+    } else {
+        // Open a gap at offset by shifting the tail of the chunk up by one
+        T value(std::forward<Args>(args)...);
+        new (&items[chunk->count]) T(std::move(items[chunk->count - 1]));
+        for (size_t i = chunk->count - 1; i > offset; i--) {
+            items[i] = std::move(items[i - 1]);
+        }
+        items[offset] = std::move(value);
+    }
+
+    chunk->count++;
+    shiftStarts(index + 1, 1);
+    size++;
+    return items[offset];
+}
+
+// Remove the element at position (0 <= position < size)
+template <typename T, size_t ChunkCapacity>
+void UnrolledLinkedList<T, ChunkCapacity>::eraseAt(int position) {
+    size_t index = locate(position);
+    Chunk* chunk = chunks[index];
+    T* items = chunk->items();
+    size_t offset = static_cast<size_t>(position - chunk_start[index]);
+
+    for (size_t i = offset; i + 1 < chunk->count; i++) {
+        items[i] = std::move(items[i + 1]);
+    }
+    items[chunk->count - 1].~T();
+    chunk->count--;
+    shiftStarts(index + 1, -1);
+    size--;
+
+    if (chunk->count == 0) {
+        removeChunk(index);
+        return;
+    }
+
+    // Fold a sparse chunk's successor into it to keep chunks dense
+    if (chunk->count < ChunkCapacity / 2 && index + 1 < chunks.size()) {
+        Chunk* successor = chunks[index + 1];
+        if (chunk->count + successor->count <= ChunkCapacity) {
+            T* from = successor->items();
+            for (size_t i = 0; i < successor->count; i++) {
+                new (&items[chunk->count + i]) T(std::move(from[i]));
+                from[i].~T();
+            }
+            chunk->count += successor->count;
+            successor->count = 0;
+            removeChunk(index + 1);
+        }
+    }
+}
+
+// Copy constructor (deep copy)
+template <typename T, size_t ChunkCapacity>
+UnrolledLinkedList<T, ChunkCapacity>::UnrolledLinkedList(const UnrolledLinkedList& other)
+    : size(0) {
+    for (const T& value : other) {
+        emplaceBack(value);
+    }
+}
+
+// Move constructor (O(1))
+template <typename T, size_t ChunkCapacity>
+UnrolledLinkedList<T, ChunkCapacity>::UnrolledLinkedList(UnrolledLinkedList&& other) noexcept
+    : chunks(std::move(other.chunks)), chunk_start(std::move(other.chunk_start)), size(other.size) {
+    other.chunks.clear();
+    other.chunk_start.clear();
+    other.size = 0;
+}
+
+// Copy assignment (deep copy)
+template <typename T, size_t ChunkCapacity>
+UnrolledLinkedList<T, ChunkCapacity>&
+UnrolledLinkedList<T, ChunkCapacity>::operator=(const UnrolledLinkedList& other) {
+    if (this != &other) {
+        clear();
+        for (const T& value : other) {
+            emplaceBack(value);
+        }
+    }
+    return *this;
+}
+
+// Move assignment (O(1))
+template <typename T, size_t ChunkCapacity>
+UnrolledLinkedList<T, ChunkCapacity>&
+UnrolledLinkedList<T, ChunkCapacity>::operator=(UnrolledLinkedList&& other) noexcept {
+    if (this != &other) {
+        clear();
+        chunks = std::move(other.chunks);
+        chunk_start = std::move(other.chunk_start);
+        size = other.size;
+        other.chunks.clear();
+        other.chunk_start.clear();
+        other.size = 0;
+    }
+    return *this;
+}
+
+// Check if list is empty
+template <typename T, size_t ChunkCapacity>
+bool UnrolledLinkedList<T, ChunkCapacity>::isEmpty() const {
+    return size == 0;
+}
+
+// Get size of list
+template <typename T, size_t ChunkCapacity>
+int UnrolledLinkedList<T, ChunkCapacity>::getSize() const {
+    return size;
+}
+
+// Get number of chunks
+template <typename T, size_t ChunkCapacity>
+int UnrolledLinkedList<T, ChunkCapacity>::getChunkCount() const {
+    return static_cast<int>(chunks.size());
+}
+
+// Insert at beginning
+template <typename T, size_t ChunkCapacity>
+void UnrolledLinkedList<T, ChunkCapacity>::insertAtBeginning(const T& value) {
+    emplaceAt(0, value);
+}
+
+template <typename T, size_t ChunkCapacity>
+void UnrolledLinkedList<T, ChunkCapacity>::insertAtBeginning(T&& value) {
+    emplaceAt(0, std::move(value));
+}
+
+// Insert at end
+template <typename T, size_t ChunkCapacity>
+void UnrolledLinkedList<T, ChunkCapacity>::insertAtEnd(const T& value) {
+    emplaceAt(size, value);
+}
+
+template <typename T, size_t ChunkCapacity>
+void UnrolledLinkedList<T, ChunkCapacity>::insertAtEnd(T&& value) {
+    emplaceAt(size, std::move(value));
+}
+
+// Insert at specific position (0-based index)
+template <typename T, size_t ChunkCapacity>
+void UnrolledLinkedList<T, ChunkCapacity>::insertAtPosition(const T& value, int position) {
+    if (position < 0 || position > size) {
+        std::cout << "Invalid position!" << std::endl;
+        return;
+    }
+    emplaceAt(position, value);
+}
+
+template <typename T, size_t ChunkCapacity>
+void UnrolledLinkedList<T, ChunkCapacity>::insertAtPosition(T&& value, int position) {
+    if (position < 0 || position > size) {
+        std::cout << "Invalid position!" << std::endl;
+        return;
+    }
+    emplaceAt(position, std::move(value));
+}
+
+// Construct at beginning
+template <typename T, size_t ChunkCapacity>
+template <typename... Args>
+T& UnrolledLinkedList<T, ChunkCapacity>::emplaceFront(Args&&... args) {
+    return emplaceAt(0, std::forward<Args>(args)...);
+}
+
+// Construct at end
+template <typename T, size_t ChunkCapacity>
+template <typename... Args>
+T& UnrolledLinkedList<T, ChunkCapacity>::emplaceBack(Args&&... args) {
+    return emplaceAt(size, std::forward<Args>(args)...);
+}
+
+// Delete from beginning
+template <typename T, size_t ChunkCapacity>
+void UnrolledLinkedList<T, ChunkCapacity>::deleteFromBeginning() {
+    if (isEmpty()) {
+        std::cout << "List is empty!" << std::endl;
+        return;
+    }
+    eraseAt(0);
+}
+
+// Delete from end (O(1): the last chunk is indexed)
+template <typename T, size_t ChunkCapacity>
+void UnrolledLinkedList<T, ChunkCapacity>::deleteFromEnd() {
+    if (isEmpty()) {
+        std::cout << "List is empty!" << std::endl;
+        return;
+    }
+    eraseAt(size - 1);
+}
+
+// Delete from specific position
+template <typename T, size_t ChunkCapacity>
+void UnrolledLinkedList<T, ChunkCapacity>::deleteFromPosition(int position) {
+    if (position < 0 || position >= size) {
+        std::cout << "Invalid position!" << std::endl;
+        return;
+    }
+    eraseAt(position);
+}
+
+// Search for a value
+template <typename T, size_t ChunkCapacity>
+bool UnrolledLinkedList<T, ChunkCapacity>::search(const T& value) const {
+    for (const T& item : *this) {
+        if (item == value) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Get value at position (returns copy)
+template <typename T, size_t ChunkCapacity>
+T UnrolledLinkedList<T, ChunkCapacity>::get(int position) const {
+    return getConstRef(position);
+}
+
+// Get reference at position
+template <typename T, size_t ChunkCapacity>
+T& UnrolledLinkedList<T, ChunkCapacity>::getRef(int position) {
+    if (position < 0 || position >= size) {
+        throw std::out_of_range("Position out of range");
+    }
+    size_t index = locate(position);
+    return chunks[index]->items()[position - chunk_start[index]];
+}
+
+// Get const reference at position
+template <typename T, size_t ChunkCapacity>
+const T& UnrolledLinkedList<T, ChunkCapacity>::getConstRef(int position) const {
+    if (position < 0 || position >= size) {
+        throw std::out_of_range("Position out of range");
+    }
+    size_t index = locate(position);
+    return chunks[index]->items()[position - chunk_start[index]];
+}
+
+// Update value at position
+template <typename T, size_t ChunkCapacity>
+void UnrolledLinkedList<T, ChunkCapacity>::update(int position, const T& newValue) {
+    if (position < 0 || position >= size) {
+        std::cout << "Invalid position!" << std::endl;
+        return;
+    }
+    getRef(position) = newValue;
+}
+
+template <typename T, size_t ChunkCapacity>
+void UnrolledLinkedList<T, ChunkCapacity>::update(int position, T&& newValue) {
+    if (position < 0 || position >= size) {
+        std::cout << "Invalid position!" << std::endl;
+        return;
+    }
+    getRef(position) = std::move(newValue);
+}
+
+// Reverse the list: reverse the chunk order and each chunk's contents
+template <typename T, size_t ChunkCapacity>
+void UnrolledLinkedList<T, ChunkCapacity>::reverse() {
+    std::reverse(chunks.begin(), chunks.end());
+    int start = 0;
+    for (size_t i = 0; i < chunks.size(); i++) {
+        Chunk* chunk = chunks[i];
+        std::reverse(chunk->items(), chunk->items() + chunk->count);
+        chunk->next = (i + 1 < chunks.size()) ? chunks[i + 1] : nullptr;
+        chunk_start[i] = start;
+        start += static_cast<int>(chunk->count);
+    }
+}
+
+// Clear the entire list
+template <typename T, size_t ChunkCapacity>
+void UnrolledLinkedList<T, ChunkCapacity>::clear() {
+    for (Chunk* chunk : chunks) {
+        T* items = chunk->items();
+        for (size_t i = 0; i < chunk->count; i++) {
+            items[i].~T();
+        }
+        delete chunk;
+    }
+    chunks.clear();
+    chunk_start.clear();
+    size = 0;
+}
+
+// Display the list
+template <typename T, size_t ChunkCapacity>
+void UnrolledLinkedList<T, ChunkCapacity>::display() const {
+    if (isEmpty()) {
+        std::cout << "List is empty!" << std::endl;
+        return;
+    }
+
+    std::cout << "List: ";
+    int printed = 0;
+    for (const T& item : *this) {
+        std::cout << item;
+        if (++printed < size) {
+            std::cout << " -> ";
+        }
+    }
+    std::cout << std::endl;
+}
+
+// Display list size
+template <typename T, size_t ChunkCapacity>
+void UnrolledLinkedList<T, ChunkCapacity>::displaySize() const {
+    std::cout << "Size: " << size << " (" << chunks.size() << " chunks)" << std::endl;
+}
+
+#endif // UNROLLED_LINKED_LIST_CPP
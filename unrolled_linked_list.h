@@ -0,0 +1,167 @@
+#ifndef UNROLLED_LINKED_LIST_H
+#define UNROLLED_LINKED_LIST_H
+
+#include <iostream>
+#include <stdexcept>
+#include <iterator>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Default chunk capacity: as many elements as fit in one 64-byte cache
+// line, but never fewer than 4 so large elements still amortise the links
+template <typename T>
+constexpr size_t unrolledChunkCapacity() {
+    return (64 / sizeof(T)) > 4 ? (64 / sizeof(T)) : 4;
+}
+
+// UnrolledLinkedList class template
+//
+// Drop-in alternative to SinglyLinkedList for index-heavy use (the FAT).
+// Each node (chunk) stores up to ChunkCapacity elements contiguously and a
+// side index keeps every chunk's first position, so:
+// - get/getRef/update/insertAtPosition/deleteFromPosition locate their
+//   chunk by binary search (O(log n/B)) instead of walking n nodes
+// - traversal touches one cache line per B elements
+// - middle insert/delete shift within one chunk and fix up the index (O(n/B))
+//
+// Unlike SinglyLinkedList, inserting or deleting may move elements, which
+// invalidates references and iterators into the affected chunk.
+template <typename T, size_t ChunkCapacity = unrolledChunkCapacity<T>()>
+class UnrolledLinkedList {
+    static_assert(ChunkCapacity >= 2, "chunks must hold at least two elements");
+
+private:
+    struct Chunk {
+        Chunk* next;
+        size_t count;
+        alignas(T) unsigned char storage[ChunkCapacity * sizeof(T)];
+
+        Chunk() : next(nullptr), count(0) {}
+        T* items() { return std::launder(reinterpret_cast<T*>(storage)); }
+        const T* items() const { return std::launder(reinterpret_cast<const T*>(storage)); }
+    };
+
+    std::vector<Chunk*> chunks;      // Chunks in list order
+    std::vector<int> chunk_start;    // Position of each chunk's first element
+    int size;
+
+    size_t locate(int position) const;
+    void insertChunk(size_t index, int start);
+    void removeChunk(size_t index);
+    void shiftStarts(size_t from, int delta);
+    void splitChunk(size_t index);
+    template <typename... Args>
+    T& emplaceAt(int position, Args&&... args);
+    void eraseAt(int position);
+
+    template <bool IsConst>
+    class BasicIterator {
+    private:
+        using ChunkPtr = typename std::conditional<IsConst, const Chunk*, Chunk*>::type;
+        ChunkPtr chunk;
+        size_t offset;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::conditional<IsConst, const T*, T*>::type;
+        using reference = typename std::conditional<IsConst, const T&, T&>::type;
+
+        BasicIterator(ChunkPtr c = nullptr, size_t o = 0) : chunk(c), offset(o) {}
+
+        // iterator -> const_iterator
+        template <bool WasConst, typename = typename std::enable_if<IsConst && !WasConst>::type>
+        BasicIterator(const BasicIterator<WasConst>& other)
+            : chunk(other.chunk), offset(other.offset) {}
+
+        reference operator*() const { return chunk->items()[offset]; }
+        pointer operator->() const { return &chunk->items()[offset]; }
+
+        BasicIterator& operator++() {
+            if (++offset == chunk->count) {
+                chunk = chunk->next;
+                offset = 0;
+            }
+            return *this;
+        }
+
+        BasicIterator operator++(int) {
+            BasicIterator previous = *this;
+            ++(*this);
+            return previous;
+        }
+
+        friend bool operator==(const BasicIterator& a, const BasicIterator& b) {
+            return a.chunk == b.chunk && a.offset == b.offset;
+        }
+        friend bool operator!=(const BasicIterator& a, const BasicIterator& b) {
+            return !(a == b);
+        }
+
+        template <bool> friend class BasicIterator;
+    };
+
+public:
+    using iterator = BasicIterator<false>;
+    using const_iterator = BasicIterator<true>;
+
+    // Constructor
+    UnrolledLinkedList() : size(0) {}
+
+    // Copy (deep) and move (O(1))
+    UnrolledLinkedList(const UnrolledLinkedList& other);
+    UnrolledLinkedList(UnrolledLinkedList&& other) noexcept;
+    UnrolledLinkedList& operator=(const UnrolledLinkedList& other);
+    UnrolledLinkedList& operator=(UnrolledLinkedList&& other) noexcept;
+
+    // Destructor
+    ~UnrolledLinkedList() {
+        clear();
+    }
+
+    bool isEmpty() const;
+    int getSize() const;
+    int getChunkCount() const;
+    void insertAtBeginning(const T& value);
+    void insertAtBeginning(T&& value);
+    void insertAtEnd(const T& value);
+    void insertAtEnd(T&& value);
+    void insertAtPosition(const T& value, int position);
+    void insertAtPosition(T&& value, int position);
+
+    // Construct the element in place; returns a reference to it
+    template <typename... Args>
+    T& emplaceFront(Args&&... args);
+    template <typename... Args>
+    T& emplaceBack(Args&&... args);
+
+    void deleteFromBeginning();
+    void deleteFromEnd();
+    void deleteFromPosition(int position);
+    bool search(const T& value) const;
+    T get(int position) const;
+    T& getRef(int position);
+    const T& getConstRef(int position) const;
+    void update(int position, const T& newValue);
+    void update(int position, T&& newValue);
+    void reverse();
+    void clear();
+    void display() const;
+    void displaySize() const;
+
+    // Iteration (sequential within each chunk)
+    iterator begin() { return iterator(chunks.empty() ? nullptr : chunks.front()); }
+    iterator end() { return iterator(); }
+    const_iterator begin() const { return const_iterator(chunks.empty() ? nullptr : chunks.front()); }
+    const_iterator end() const { return const_iterator(); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+};
+
+// Include the implementation
+#include "unrolled_linked_list.cpp"
+
+#endif // UNROLLED_LINKED_LIST_H
@@ -0,0 +1,407 @@
+#include "uring_block_device.h"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef FAT_FS_HAVE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register 427
+#endif
+#endif
+
+using namespace std;
+
+// ============================================
+// IO_URING RING
+// ============================================
+
+#ifdef FAT_FS_HAVE_IO_URING
+
+struct UringBlockDevice::Ring {
+    int fd;
+
+    unsigned* sq_head;
+    unsigned* sq_tail;
+    unsigned* sq_mask;
+    unsigned* sq_array;
+    io_uring_sqe* sqes;
+
+    unsigned* cq_head;
+    unsigned* cq_tail;
+    unsigned* cq_mask;
+    io_uring_cqe* cqes;
+
+    void* sq_map;
+    size_t sq_map_size;
+    void* cq_map;
+    size_t cq_map_size;
+    size_t sqes_size;
+
+    Ring() : fd(-1), sq_map(MAP_FAILED), sq_map_size(0),
+             cq_map(MAP_FAILED), cq_map_size(0), sqes_size(0) {}
+};
+
+namespace {
+
+int ringSetup(unsigned entries, io_uring_params* params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int ringEnter(int ring_fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete,
+                                    flags, nullptr, 0));
+}
+
+int ringRegister(int ring_fd, unsigned opcode, const void* arg, unsigned nr_args) {
+    return static_cast<int>(syscall(__NR_io_uring_register, ring_fd, opcode, arg, nr_args));
+}
+
+}  // namespace
+
+bool UringBlockDevice::setupRing(unsigned entries) {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+
+    Ring* r = new Ring();
+    r->fd = ringSetup(entries, &params);
+    if (r->fd < 0) {
+        delete r;
+        return false;
+    }
+    ring = r;
+
+    r->sq_map_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    r->cq_map_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+        r->sq_map_size = r->cq_map_size = max(r->sq_map_size, r->cq_map_size);
+    }
+
+    r->sq_map = mmap(nullptr, r->sq_map_size, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, r->fd, IORING_OFF_SQ_RING);
+    if (r->sq_map == MAP_FAILED) {
+        teardownRing();
+        return false;
+    }
+    r->cq_map = single_mmap ? r->sq_map
+                            : mmap(nullptr, r->cq_map_size, PROT_READ | PROT_WRITE,
+                                   MAP_SHARED | MAP_POPULATE, r->fd, IORING_OFF_CQ_RING);
+    if (r->cq_map == MAP_FAILED) {
+        teardownRing();
+        return false;
+    }
+
+    r->sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = mmap(nullptr, r->sqes_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, r->fd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        r->sqes_size = 0;
+        teardownRing();
+        return false;
+    }
+    r->sqes = static_cast<io_uring_sqe*>(sqes);
+
+    uint8_t* sq = static_cast<uint8_t*>(r->sq_map);
+    r->sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    r->sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    r->sq_mask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    r->sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+    uint8_t* cq = static_cast<uint8_t*>(r->cq_map);
+    r->cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    r->cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    r->cq_mask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    r->cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+    // Register the transfer buffers once so the kernel pins them up front
+    vector<iovec> iovecs(queue_depth);
+    for (unsigned i = 0; i < queue_depth; i++) {
+        iovecs[i].iov_base = buffers + i * block_size;
+        iovecs[i].iov_len = block_size;
+    }
+    if (ringRegister(r->fd, IORING_REGISTER_BUFFERS, iovecs.data(), queue_depth) < 0) {
+        teardownRing();
+        return false;
+    }
+    return true;
+}
+
+void UringBlockDevice::teardownRing() {
+    if (!ring) {
+        return;
+    }
+    if (ring->sqes_size > 0) {
+        munmap(ring->sqes, ring->sqes_size);
+    }
+    if (ring->cq_map != MAP_FAILED && ring->cq_map != ring->sq_map) {
+        munmap(ring->cq_map, ring->cq_map_size);
+    }
+    if (ring->sq_map != MAP_FAILED) {
+        munmap(ring->sq_map, ring->sq_map_size);
+    }
+    if (ring->fd >= 0) {
+        close(ring->fd);
+    }
+    delete ring;
+    ring = nullptr;
+}
+
+bool UringBlockDevice::ringBatch(bool is_write, const size_t* blocks,
+                                 uint8_t* const* data, size_t count) {
+    bool ok = true;
+
+    for (size_t start = 0; start < count; start += queue_depth) {
+        unsigned n = static_cast<unsigned>(min<size_t>(queue_depth, count - start));
+
+        // Queue one fixed-buffer SQE per block
+        unsigned tail = *ring->sq_tail;
+        for (unsigned i = 0; i < n; i++) {
+            uint8_t* slot = buffers + i * block_size;
+            if (is_write) {
+                memcpy(slot, data[start + i], block_size);
+            }
+
+            unsigned index = (tail + i) & *ring->sq_mask;
+            io_uring_sqe* sqe = &ring->sqes[index];
+            memset(sqe, 0, sizeof(*sqe));
+            sqe->opcode = is_write ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+            sqe->fd = fd;
+            sqe->off = blocks[start + i] * block_size;
+            sqe->addr = reinterpret_cast<uint64_t>(slot);
+            sqe->len = static_cast<uint32_t>(block_size);
+            sqe->buf_index = static_cast<uint16_t>(i);
+            sqe->user_data = i;
+            ring->sq_array[index] = index;
+        }
+        __atomic_store_n(ring->sq_tail, tail + n, __ATOMIC_RELEASE);
+
+        // One enter call submits the whole chunk and waits for it
+        unsigned to_submit = n;
+        unsigned completed = 0;
+        while (completed < n) {
+            int ret = ringEnter(ring->fd, to_submit, n - completed, IORING_ENTER_GETEVENTS);
+            if (ret < 0) {
+                if (errno == EINTR) continue;
+
+                // Withdraw the SQEs the kernel has not consumed; the ones it
+                // has still own their buffers and owe a CQE, so reap them
+                // before the next batch reuses either
+                unsigned consumed = __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE) - tail;
+                __atomic_store_n(ring->sq_tail, tail + consumed, __ATOMIC_RELEASE);
+                if (!drainRing(consumed - completed)) {
+                    abandonRing();
+                }
+                return false;
+            }
+            to_submit -= min<unsigned>(to_submit, static_cast<unsigned>(ret));
+
+            unsigned head = *ring->cq_head;
+            while (head != __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE)) {
+                io_uring_cqe* cqe = &ring->cqes[head & *ring->cq_mask];
+                size_t i = cqe->user_data;
+                if (cqe->res != static_cast<int>(block_size)) {
+                    ok = false;
+                } else if (!is_write) {
+                    memcpy(data[start + i], buffers + i * block_size, block_size);
+                }
+                head++;
+                completed++;
+            }
+            __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+        }
+    }
+    return ok;
+}
+
+// Waits for and discards `outstanding` completions of a failed batch
+bool UringBlockDevice::drainRing(unsigned outstanding) {
+    while (outstanding > 0) {
+        unsigned head = *ring->cq_head;
+        while (outstanding > 0 && head != __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE)) {
+            head++;
+            outstanding--;
+        }
+        __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+        if (outstanding == 0) {
+            break;
+        }
+        if (ringEnter(ring->fd, 0, outstanding, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Gives up on a ring whose requests could not be reaped. The kernel may
+// still write into the old buffers, so they are leaked rather than reused;
+// the device carries on with pread/pwrite and fresh buffers.
+void UringBlockDevice::abandonRing() {
+    teardownRing();
+    void* memory = nullptr;
+    buffers = posix_memalign(&memory, 4096, queue_depth * block_size) == 0
+                  ? static_cast<uint8_t*>(memory)
+                  : nullptr;     // Every later transfer fails
+}
+
+#else  // !FAT_FS_HAVE_IO_URING
+
+struct UringBlockDevice::Ring {};
+
+bool UringBlockDevice::setupRing(unsigned) {
+    return false;
+}
+
+void UringBlockDevice::teardownRing() {}
+
+bool UringBlockDevice::ringBatch(bool, const size_t*, uint8_t* const*, size_t) {
+    return false;
+}
+
+bool UringBlockDevice::drainRing(unsigned) {
+    return false;
+}
+
+void UringBlockDevice::abandonRing() {}
+
+#endif // FAT_FS_HAVE_IO_URING
+
+bool UringBlockDevice::submitBatch(bool is_write, const size_t* blocks,
+                                   uint8_t* const* data, size_t count) {
+    lock_guard<mutex> lock(ring_mutex);
+    if (fd < 0 || !buffers) {
+        return false;
+    }
+    if (ring) {
+        return ringBatch(is_write, blocks, data, count);
+    }
+    for (size_t i = 0; i < count; i++) {
+        bool ok = is_write ? pwriteBlock(blocks[i], data[i]) : preadBlock(blocks[i], data[i]);
+        if (!ok) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ============================================
+// IMPLEMENTATION
+// ============================================
+
+UringBlockDevice::UringBlockDevice(const string& path, size_t block_size_bytes, size_t blocks,
+                                   bool direct, unsigned entries)
+    : fd(-1),
+      block_size(block_size_bytes),
+      block_count(blocks),
+      direct_io(false),
+      ring(nullptr),
+      buffers(nullptr),
+      queue_depth(entries == 0 ? 1 : entries) {
+    int flags = O_RDWR | O_CREAT;
+#ifdef O_DIRECT
+    if (direct) {
+        fd = ::open(path.c_str(), flags | O_DIRECT, 0644);
+        direct_io = fd >= 0;
+    }
+#endif
+    if (fd < 0) {
+        fd = ::open(path.c_str(), flags, 0644);
+    }
+    if (fd < 0 || ::ftruncate(fd, static_cast<off_t>(block_size * block_count)) != 0) {
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+        return;
+    }
+
+    // Page-aligned so the same buffers satisfy O_DIRECT on either path
+    void* memory = nullptr;
+    if (posix_memalign(&memory, 4096, queue_depth * block_size) != 0) {
+        ::close(fd);
+        fd = -1;
+        return;
+    }
+    buffers = static_cast<uint8_t*>(memory);
+
+    setupRing(queue_depth);
+}
+
+UringBlockDevice::~UringBlockDevice() {
+    teardownRing();
+    free(buffers);
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+// ============== FALLBACK PATH ==============
+
+bool UringBlockDevice::preadBlock(size_t block, void* buffer) {
+    ssize_t n = ::pread(fd, buffers, block_size, static_cast<off_t>(block * block_size));
+    if (n != static_cast<ssize_t>(block_size)) {
+        return false;
+    }
+    memcpy(buffer, buffers, block_size);
+    return true;
+}
+
+bool UringBlockDevice::pwriteBlock(size_t block, const void* data) {
+    memcpy(buffers, data, block_size);
+    ssize_t n = ::pwrite(fd, buffers, block_size, static_cast<off_t>(block * block_size));
+    return n == static_cast<ssize_t>(block_size);
+}
+
+// ============== BLOCK ACCESS ==============
+
+bool UringBlockDevice::readBlock(size_t block, void* buffer) {
+    if (block >= block_count) {
+        return false;
+    }
+    uint8_t* target = static_cast<uint8_t*>(buffer);
+    return submitBatch(false, &block, &target, 1);
+}
+
+bool UringBlockDevice::writeBlock(size_t block, const void* data) {
+    if (block >= block_count) {
+        return false;
+    }
+    uint8_t* source = const_cast<uint8_t*>(static_cast<const uint8_t*>(data));
+    return submitBatch(true, &block, &source, 1);
+}
+
+bool UringBlockDevice::readBlocks(const vector<BlockRead>& batch) {
+    vector<size_t> blocks;
+    vector<uint8_t*> targets;
+    for (const BlockRead& read : batch) {
+        if (read.block >= block_count) return false;
+        blocks.push_back(read.block);
+        targets.push_back(read.data);
+    }
+    return submitBatch(false, blocks.data(), targets.data(), blocks.size());
+}
+
+bool UringBlockDevice::writeBlocks(const vector<BlockWrite>& batch) {
+    vector<size_t> blocks;
+    vector<uint8_t*> sources;
+    for (const BlockWrite& write : batch) {
+        if (write.block >= block_count) return false;
+        blocks.push_back(write.block);
+        sources.push_back(const_cast<uint8_t*>(write.data));
+    }
+    return submitBatch(true, blocks.data(), sources.data(), blocks.size());
+}
+
+bool UringBlockDevice::flush() {
+    return fd >= 0 && ::fdatasync(fd) == 0;
+}
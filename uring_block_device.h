@@ -0,0 +1,74 @@
+#ifndef URING_BLOCK_DEVICE_H
+#define URING_BLOCK_DEVICE_H
+
+#include "block_device.h"
+#include <mutex>
+#include <string>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define FAT_FS_HAVE_IO_URING 1
+#endif
+#endif
+
+// ============================================
+// IO_URING IMAGE-FILE DEVICE (LINUX)
+// ============================================
+
+// Volume image in a host file driven through io_uring. Batched reads and
+// writes are queued as one submission and reaped together; data moves
+// through a set of registered (fixed) buffers. When io_uring is missing
+// or refused by the kernel the device falls back to pread/pwrite; so it
+// does for good if a ring ever fails with requests it cannot reap.
+class UringBlockDevice : public BlockDevice {
+private:
+    struct Ring;   // Mapped submission/completion queues
+
+    int fd;
+    size_t block_size;
+    size_t block_count;
+    bool direct_io;
+
+    Ring* ring;            // nullptr when running on the fallback path
+    uint8_t* buffers;      // queue_depth registered buffers of block_size bytes
+    unsigned queue_depth;
+    mutable std::mutex ring_mutex; // One submitter at a time; guards ring and buffers
+
+    bool setupRing(unsigned entries);
+    void teardownRing();
+    bool submitBatch(bool is_write, const size_t* blocks, uint8_t* const* data, size_t count);
+
+    // Called with ring_mutex held
+    bool ringBatch(bool is_write, const size_t* blocks, uint8_t* const* data, size_t count);
+    bool drainRing(unsigned outstanding);
+    void abandonRing();
+    bool preadBlock(size_t block, void* buffer);
+    bool pwriteBlock(size_t block, const void* data);
+
+public:
+    // `direct` asks for O_DIRECT (silently dropped if the host FS refuses it)
+    UringBlockDevice(const std::string& path, size_t block_size_bytes, size_t blocks,
+                     bool direct = false, unsigned entries = 64);
+    ~UringBlockDevice() override;
+
+    UringBlockDevice(const UringBlockDevice&) = delete;
+    UringBlockDevice& operator=(const UringBlockDevice&) = delete;
+
+    bool isOpen() const { return fd >= 0; }
+    bool usingIoUring() const {
+        std::lock_guard<std::mutex> lock(ring_mutex);
+        return ring != nullptr;
+    }
+    bool usingDirectIO() const { return direct_io; }
+
+    size_t getBlockSize() const override { return block_size; }
+    size_t getBlockCount() const override { return block_count; }
+
+    bool readBlock(size_t block, void* buffer) override;
+    bool writeBlock(size_t block, const void* data) override;
+    bool readBlocks(const std::vector<BlockRead>& batch) override;
+    bool writeBlocks(const std::vector<BlockWrite>& batch) override;
+    bool flush() override;
+};
+
+#endif // URING_BLOCK_DEVICE_H
@@ -0,0 +1,31 @@
+#include "work_counter.h"
+
+namespace work_counter {
+
+namespace {
+
+thread_local Counts thread_counts;
+
+}  // namespace
+
+Counts thread() noexcept {
+    return thread_counts;
+}
+
+void addFatEntries(uint64_t count) noexcept {
+    thread_counts.fat_entries += count;
+}
+
+void addListNodes(uint64_t count) noexcept {
+    thread_counts.list_nodes += count;
+}
+
+void addDeviceReads(uint64_t count) noexcept {
+    thread_counts.device_reads += count;
+}
+
+void addDeviceWrites(uint64_t count) noexcept {
+    thread_counts.device_writes += count;
+}
+
+}  // namespace work_counter
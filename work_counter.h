@@ -0,0 +1,100 @@
+#ifndef WORK_COUNTER_H
+#define WORK_COUNTER_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+// ============================================
+// MACHINE-INDEPENDENT WORK COUNTS
+// ============================================
+
+// Per-thread counts of the work file system calls do, as opposed to the
+// time it takes: FAT entries examined, directory list nodes visited and
+// blocks moved to or from the device by the buffer cache. For a fixed
+// workload they are the same on every machine and every run (as long as
+// nothing happens on other threads: the background flusher's writes are
+// counted on the flusher thread), which makes them usable as regression
+// gates where timings are too noisy.
+//
+// Like alloc_counter, the counts are plain thread_locals; code adds to
+// them once per loop, not once per element.
+namespace work_counter {
+
+struct Counts {
+    uint64_t fat_entries = 0;      // FAT entries read or updated
+    uint64_t list_nodes = 0;       // Directory nodes visited by lookups and listings
+    uint64_t device_reads = 0;     // Blocks read from the device
+    uint64_t device_writes = 0;    // Blocks written to the device
+};
+
+// Totals of the calling thread since it started
+Counts thread() noexcept;
+
+void addFatEntries(uint64_t count) noexcept;
+void addListNodes(uint64_t count) noexcept;
+void addDeviceReads(uint64_t count) noexcept;
+void addDeviceWrites(uint64_t count) noexcept;
+
+}  // namespace work_counter
+
+// Work totals of one call site, summed over threads
+class WorkCounter {
+private:
+    std::atomic<uint64_t> fat_entries{0};
+    std::atomic<uint64_t> list_nodes{0};
+    std::atomic<uint64_t> device_reads{0};
+    std::atomic<uint64_t> device_writes{0};
+
+public:
+    WorkCounter() = default;
+    WorkCounter(const WorkCounter&) = delete;
+    WorkCounter& operator=(const WorkCounter&) = delete;
+
+    void add(const work_counter::Counts& counts) noexcept {
+        fat_entries.fetch_add(counts.fat_entries, std::memory_order_relaxed);
+        list_nodes.fetch_add(counts.list_nodes, std::memory_order_relaxed);
+        device_reads.fetch_add(counts.device_reads, std::memory_order_relaxed);
+        device_writes.fetch_add(counts.device_writes, std::memory_order_relaxed);
+    }
+
+    work_counter::Counts snapshot() const noexcept {
+        work_counter::Counts counts;
+        counts.fat_entries = fat_entries.load(std::memory_order_relaxed);
+        counts.list_nodes = list_nodes.load(std::memory_order_relaxed);
+        counts.device_reads = device_reads.load(std::memory_order_relaxed);
+        counts.device_writes = device_writes.load(std::memory_order_relaxed);
+        return counts;
+    }
+
+    void reset() noexcept {
+        fat_entries.store(0, std::memory_order_relaxed);
+        list_nodes.store(0, std::memory_order_relaxed);
+        device_reads.store(0, std::memory_order_relaxed);
+        device_writes.store(0, std::memory_order_relaxed);
+    }
+};
+
+// Adds the work the current thread does during a scope
+class ScopedWork {
+private:
+    WorkCounter& counter;
+    work_counter::Counts start;
+
+public:
+    explicit ScopedWork(WorkCounter& c) noexcept
+        : counter(c), start(work_counter::thread()) {}
+    ~ScopedWork() {
+        work_counter::Counts now = work_counter::thread();
+        now.fat_entries -= start.fat_entries;
+        now.list_nodes -= start.list_nodes;
+        now.device_reads -= start.device_reads;
+        now.device_writes -= start.device_writes;
+        counter.add(now);
+    }
+
+    ScopedWork(const ScopedWork&) = delete;
+    ScopedWork& operator=(const ScopedWork&) = delete;
+};
+
+#endif // WORK_COUNTER_H
@@ -0,0 +1,280 @@
+#include "workload_trace.h"
+#include "fat_file_system.h"
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <thread>
+
+using namespace std;
+
+namespace {
+
+const char kMagic[8] = {'F', 'A', 'T', 'R', 'P', 'L', 'Y', '1'};
+
+enum FieldMask : uint8_t {
+    kHasPath = 1,
+    kHasPath2 = 2,
+    kHasNumber = 4,
+    kHasHandle = 8
+};
+
+void putVarint(string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out += static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out += static_cast<char>(value);
+}
+
+void putString(string& out, const string& text) {
+    putVarint(out, text.size());
+    out += text;
+}
+
+uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Bounds-checked cursor over a loaded trace
+class Reader {
+private:
+    const string& data;
+    size_t pos;
+
+public:
+    explicit Reader(const string& bytes, size_t start = 0) : data(bytes), pos(start) {}
+
+    bool done() const { return pos >= data.size(); }
+
+    bool byte(uint8_t& value) {
+        if (pos >= data.size()) return false;
+        value = static_cast<uint8_t>(data[pos++]);
+        return true;
+    }
+
+    bool varint(uint64_t& value) {
+        value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            uint8_t b;
+            if (!byte(b)) return false;
+            value |= static_cast<uint64_t>(b & 0x7F) << shift;
+            if (!(b & 0x80)) return true;
+        }
+        return false;
+    }
+
+    bool text(string& value) {
+        uint64_t length;
+        if (!varint(length) || length > data.size() - pos) return false;
+        value.assign(data, pos, length);
+        pos += length;
+        return true;
+    }
+};
+
+// Small per-thread numbers, in order of first recorded call
+uint32_t recordingThread() {
+    static atomic<uint32_t> next_thread{0};
+    thread_local uint32_t id = next_thread++;
+    return id;
+}
+
+}  // namespace
+
+// ============================================
+// RECORDER
+// ============================================
+
+int& WorkloadRecorder::depth() {
+    thread_local int calls_in_progress = 0;
+    return calls_in_progress;
+}
+
+WorkloadRecorder::WorkloadRecorder(const string& path, size_t volume_kb, size_t cluster_size)
+    : out(path, ios::binary | ios::trunc),
+      start(chrono::steady_clock::now()),
+      last_time_ns(0),
+      calls(0) {
+    string header(kMagic, sizeof(kMagic));
+    putVarint(header, volume_kb);
+    putVarint(header, cluster_size);
+    out.write(header.data(), header.size());
+}
+
+void WorkloadRecorder::record(FsOperation operation, const string& path, const string& path2,
+                              uint64_t number, int64_t handle) {
+    uint64_t now_ns = static_cast<uint64_t>(
+        chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+
+    uint8_t mask = (path.empty() ? 0 : kHasPath) | (path2.empty() ? 0 : kHasPath2) |
+                   (number == 0 ? 0 : kHasNumber) | (handle == 0 ? 0 : kHasHandle);
+
+    lock_guard<mutex> guard(write_mutex);
+    string entry;
+    entry += static_cast<char>(operation);
+    entry += static_cast<char>(mask);
+    uint64_t delta = now_ns > last_time_ns ? now_ns - last_time_ns : 0;
+    last_time_ns += delta;
+    putVarint(entry, delta);
+    putVarint(entry, recordingThread());
+    if (mask & kHasPath) putString(entry, path);
+    if (mask & kHasPath2) putString(entry, path2);
+    if (mask & kHasNumber) putVarint(entry, number);
+    if (mask & kHasHandle) putVarint(entry, zigzag(handle));
+    out.write(entry.data(), entry.size());
+    calls++;
+}
+
+void WorkloadRecorder::flush() {
+    lock_guard<mutex> guard(write_mutex);
+    out.flush();
+}
+
+// ============================================
+// TRACE LOADING
+// ============================================
+
+bool WorkloadTrace::load(const string& path) {
+    ifstream in(path, ios::binary);
+    if (!in) {
+        return false;
+    }
+    string data((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    if (data.size() < sizeof(kMagic) || memcmp(data.data(), kMagic, sizeof(kMagic)) != 0) {
+        return false;
+    }
+
+    Reader reader(data, sizeof(kMagic));
+    uint64_t kb, cluster;
+    if (!reader.varint(kb) || !reader.varint(cluster) ||
+        !FATFileSystem::validGeometry(kb, cluster)) {
+        return false;
+    }
+    volume_kb = kb;
+    cluster_size = cluster;
+    calls.clear();
+
+    uint64_t time_ns = 0;
+    while (!reader.done()) {
+        RecordedCall call;
+        uint8_t op, mask;
+        uint64_t delta, thread, raw_handle;
+        if (!reader.byte(op) || op >= kFsOperationCount || !reader.byte(mask) ||
+            !reader.varint(delta) || !reader.varint(thread)) {
+            return false;
+        }
+        if (((mask & kHasPath) && !reader.text(call.path)) ||
+            ((mask & kHasPath2) && !reader.text(call.path2)) ||
+            ((mask & kHasNumber) && !reader.varint(call.number)) ||
+            ((mask & kHasHandle) && !reader.varint(raw_handle))) {
+            return false;
+        }
+        call.operation = static_cast<FsOperation>(op);
+        time_ns += delta;
+        call.time_ns = time_ns;
+        call.thread = static_cast<uint32_t>(thread);
+        call.handle = (mask & kHasHandle) ? unzigzag(raw_handle) : 0;
+        calls.push_back(move(call));
+    }
+    return true;
+}
+
+// ============================================
+// REPLAY
+// ============================================
+
+ReplayResult replayWorkload(FATFileSystem& fs, const WorkloadTrace& trace,
+                            const ReplayOptions& options) {
+    ReplayResult result;
+    map<int64_t, int> handles;       // Recorded handle -> live handle
+    vector<char> buffer;
+
+    auto live = [&handles](int64_t recorded) {
+        auto it = handles.find(recorded);
+        return it == handles.end() ? -1 : it->second;
+    };
+    auto sized = [&buffer](uint64_t bytes) {
+        if (buffer.size() < bytes) {
+            buffer.resize(bytes, 'r');
+        }
+        return buffer.data();
+    };
+
+    auto start = chrono::steady_clock::now();
+    for (const RecordedCall& call : trace.calls) {
+        if (options.original_timing && options.speed > 0) {
+            this_thread::sleep_until(start + chrono::nanoseconds(
+                static_cast<int64_t>(call.time_ns / options.speed)));
+        }
+
+        bool ok = true;
+        switch (call.operation) {
+            case FsOperation::CreateFile:
+                ok = fs.tryCreateFile(call.path, call.number).ok();
+                break;
+            case FsOperation::DeleteFile:
+                ok = fs.tryDeleteFile(call.path).ok();
+                break;
+            case FsOperation::CopyFile:
+                ok = fs.tryCopyFile(call.path, call.path2).ok();
+                break;
+            case FsOperation::CreateDirectory:
+                ok = fs.tryCreateDirectory(call.path).ok();
+                break;
+            case FsOperation::DeleteDirectory:
+                ok = fs.tryDeleteDirectory(call.path).ok();
+                break;
+            case FsOperation::ListDirectory:
+                fs.listDirectory(call.path);
+                break;
+            case FsOperation::OpenFile: {
+                FsResult<int> opened = fs.tryOpenFile(call.path, call.path2.empty() ? "r" : call.path2);
+                ok = opened.ok();
+                if (ok) {
+                    handles[call.handle] = opened.value();
+                }
+                break;
+            }
+            case FsOperation::CloseFile:
+                ok = fs.tryCloseFile(live(call.handle)).ok();
+                handles.erase(call.handle);
+                break;
+            case FsOperation::ReadFile:
+                ok = fs.tryReadFile(live(call.handle), sized(call.number), call.number).ok();
+                break;
+            case FsOperation::WriteFile:
+                ok = fs.tryWriteFile(live(call.handle), sized(call.number), call.number).ok();
+                break;
+            case FsOperation::SeekFile:
+                ok = fs.trySeekFile(live(call.handle), call.number).ok();
+                break;
+            case FsOperation::SyncFile:
+                ok = fs.trySyncFile(live(call.handle)).ok();
+                break;
+            case FsOperation::SyncAll:
+                ok = fs.trySyncAll().ok();
+                break;
+            case FsOperation::FileExists:
+                fs.fileExists(call.path);
+                break;
+            case FsOperation::IsDirectory:
+                fs.isDirectory(call.path);
+                break;
+            case FsOperation::GetFileSystemInfo:
+                fs.getFileSystemInfo();
+                break;
+            default:
+                continue;                // Not a recordable call
+        }
+        result.calls++;
+        if (!ok) {
+            result.failures++;
+        }
+    }
+    result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return result;
+}
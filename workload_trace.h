@@ -0,0 +1,112 @@
+#ifndef WORKLOAD_TRACE_H
+#define WORKLOAD_TRACE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <chrono>
+
+enum class FsOperation : uint8_t;
+class FATFileSystem;
+
+// ============================================
+// RECORDED FILE SYSTEM CALLS
+// ============================================
+
+// One public FATFileSystem call. Field use depends on the operation:
+//   path     file/directory path (copy: source)
+//   path2    copy: destination, open: mode
+//   number   create: initial size, read/write: bytes, seek: position
+//   handle   file handle (open: the handle a successful open returns)
+// Write payloads are not recorded; replays write a fixed pattern.
+struct RecordedCall {
+    FsOperation operation;
+    uint64_t time_ns = 0;        // Since recording started
+    uint32_t thread = 0;         // Recording-local thread number
+    std::string path;
+    std::string path2;
+    uint64_t number = 0;
+    int64_t handle = 0;
+};
+
+// Appends calls to a compact binary trace: an 8-byte magic, the volume
+// geometry, then one record per call (operation, field mask, varint time
+// delta and thread, then the present fields). Calls made from inside
+// another public call (createFile inside openFile, ...) are not
+// recorded, so a replay issues exactly the caller's calls.
+class WorkloadRecorder {
+private:
+    std::ofstream out;
+    std::mutex write_mutex;
+    std::chrono::steady_clock::time_point start;
+    uint64_t last_time_ns;
+    uint64_t calls;
+
+    static int& depth();
+
+public:
+    WorkloadRecorder(const std::string& path, size_t volume_kb, size_t cluster_size);
+
+    bool isOpen() const { return out.is_open() && out.good(); }
+    uint64_t getCallCount() const { return calls; }
+
+    void record(FsOperation operation, const std::string& path, const std::string& path2,
+                uint64_t number, int64_t handle);
+    void flush();
+
+    // Marks a public call on this thread; only the outermost one records
+    class Scope {
+    private:
+        bool counted;
+        bool outer;
+
+    public:
+        explicit Scope(const WorkloadRecorder* recorder)
+            : counted(recorder != nullptr), outer(counted && depth()++ == 0) {}
+        ~Scope() {
+            if (counted) {
+                depth()--;
+            }
+        }
+        bool outermost() const { return outer; }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+};
+
+// A trace read back into memory
+struct WorkloadTrace {
+    size_t volume_kb = 0;
+    size_t cluster_size = 0;
+    std::vector<RecordedCall> calls;
+
+    // false if the file is missing, not a trace, truncated, or records a
+    // geometry FATFileSystem::validGeometry() rejects
+    bool load(const std::string& path);
+};
+
+// ============================================
+// REPLAY
+// ============================================
+
+struct ReplayOptions {
+    bool original_timing = false;   // Sleep to reproduce the recorded inter-arrival times
+    double speed = 1.0;             // Time compression for original_timing
+};
+
+struct ReplayResult {
+    size_t calls = 0;
+    size_t failures = 0;            // Calls that returned an error
+    double seconds = 0.0;           // Wall time of the whole replay
+};
+
+// Issues every call of the trace against fs from the calling thread.
+// Recorded handles are mapped to the handles the replay's opens return.
+ReplayResult replayWorkload(FATFileSystem& fs, const WorkloadTrace& trace,
+                            const ReplayOptions& options = ReplayOptions());
+
+#endif // WORKLOAD_TRACE_H